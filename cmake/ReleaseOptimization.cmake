@@ -0,0 +1,51 @@
+include(CheckIPOSupported)
+
+option(OOP_LTO "Use link-time optimization in Release builds" ON)
+set(OOP_PGO "OFF" CACHE STRING "Profile-guided optimization stage: OFF, GENERATE or USE")
+set_property(CACHE OOP_PGO PROPERTY STRINGS OFF GENERATE USE)
+set(OOP_PGO_DIR "${CMAKE_BINARY_DIR}/pgo" CACHE PATH "Directory the training run writes profiles into")
+
+if(OOP_LTO)
+    check_ipo_supported(RESULT OOP_LTO_SUPPORTED OUTPUT OOP_LTO_ERROR LANGUAGES CXX)
+    if(NOT OOP_LTO_SUPPORTED)
+        message(WARNING "LTO is not supported by this toolchain: ${OOP_LTO_ERROR}")
+    endif()
+endif()
+
+if(NOT OOP_PGO STREQUAL "OFF")
+    if(NOT OOP_PGO MATCHES "^(GENERATE|USE)$")
+        message(FATAL_ERROR "OOP_PGO must be OFF, GENERATE or USE, not ${OOP_PGO}")
+    endif()
+    if(NOT CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang" OR MSVC)
+        message(FATAL_ERROR "OOP_PGO is only supported with GCC and Clang")
+    endif()
+    message(STATUS "PGO stage: ${OOP_PGO} (${OOP_PGO_DIR})")
+endif()
+
+# GCC keys its .gcda files by object path, so both PGO stages must build in the same build directory.
+# Clang writes .profraw files that scripts/pgo.sh merges into ${OOP_PGO_DIR}/oop.profdata.
+function(set_release_optimization target)
+    if(OOP_LTO AND OOP_LTO_SUPPORTED)
+        set_property(TARGET ${target} PROPERTY INTERPROCEDURAL_OPTIMIZATION_RELEASE ON)
+    endif()
+
+    if(OOP_PGO STREQUAL "GENERATE")
+        set(pgo_flags "-fprofile-generate=${OOP_PGO_DIR}")
+        if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+            # training may run on several threads
+            list(APPEND pgo_flags -fprofile-update=atomic)
+        endif()
+        target_compile_options(${target} PRIVATE ${pgo_flags})
+        target_link_options(${target} PRIVATE ${pgo_flags})
+    elseif(OOP_PGO STREQUAL "USE")
+        if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+            # code the replays never reach (e.g. benchmark-only paths) keeps its normal optimization
+            target_compile_options(${target} PRIVATE
+                    -fprofile-use=${OOP_PGO_DIR} -fprofile-partial-training -Wno-missing-profile)
+        else()
+            target_compile_options(${target} PRIVATE
+                    -fprofile-use=${OOP_PGO_DIR}/oop.profdata -Wno-profile-instr-unprofiled
+                    -Wno-profile-instr-out-of-date)
+        endif()
+    endif()
+endfunction()
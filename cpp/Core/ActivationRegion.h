@@ -0,0 +1,160 @@
+#ifndef ACTIVATIONREGION_H
+#define ACTIVATIONREGION_H
+
+#include "SpatialGrid.h"
+#include "../include/Counters.h"
+#include "../include/Profiler.h"
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <vector>
+
+/**
+ * @class ActivationRegion
+ * @brief Tracks which entities of a `SpatialGrid` are near the camera and should be simulated and drawn.
+ *
+ * An entity becomes active when it overlaps the camera grown by the activation margin, and only becomes
+ * inactive once it no longer overlaps the camera grown by the larger deactivation margin, so entities on the
+ * edge do not flicker on and off while the camera shakes.
+ *
+ * Updates are incremental. Leaving is checked against the active list only. Entering is checked only in the
+ * cells the activation box newly reaches, plus its partially covered border cells: anything in a cell that
+ * was already fully covered overlapped the previous box too, so it is active already. The per-frame cost
+ * therefore follows what the camera sees, not the height of the tower.
+ */
+class ActivationRegion {
+public:
+    /**
+     * @param grid The entities to activate; must outlive the region.
+     * @param activateMargin Distance beyond the camera at which entities become active.
+     * @param deactivateMargin Distance beyond the camera at which active entities become inactive.
+     */
+    ActivationRegion(const SpatialGrid &grid, float activateMargin, float deactivateMargin)
+        : grid(&grid), activateMargin(activateMargin),
+          deactivateMargin(deactivateMargin > activateMargin ? deactivateMargin : activateMargin) {
+    }
+
+    /**
+     * @brief Moves the region to follow the camera and collects what entered and left it.
+     *
+     * @param camera The visible area.
+     */
+    void Update(const Aabb &camera) {
+        PROFILE_ZONE("ActivationRegion::Update");
+        entered.clear();
+        left.clear();
+        activeBox = camera.Expand(activateMargin);
+        keepBox = camera.Expand(deactivateMargin);
+
+        for (std::size_t index = 0; index < active.size();) {
+            const std::uint32_t id = active[index];
+            if (!grid->Contains(id) || !grid->GetBounds(id).Overlaps(keepBox)) {
+                Deactivate(index);
+                left.push_back(id);
+            } else {
+                ++index;
+            }
+        }
+
+        const CellRange range = grid->GetCells(activeBox);
+        std::uint64_t candidates = 0;
+        for (int row = range.minRow; row <= range.maxRow; ++row) {
+            for (int column = range.minColumn; column <= range.maxColumn; ++column) {
+                if (hasCovered && covered.Contains(column, row)) {
+                    continue;
+                }
+                const std::vector<std::uint32_t> &cell = grid->GetCell(column, row);
+                candidates += cell.size();
+                for (const std::uint32_t id: cell) {
+                    TryActivate(id);
+                }
+            }
+        }
+        Counters::Add(Counter::BroadphaseCandidates, candidates);
+
+        // Cells strictly inside the activation box are fully covered; their entities cannot be missed next time
+        covered = CellRange{range.minColumn + 1, range.minRow + 1, range.maxColumn - 1, range.maxRow - 1};
+        hasCovered = true;
+    }
+
+    /**
+     * @brief Re-evaluates one entity after it was inserted, moved or removed in the grid.
+     */
+    void Refresh(std::uint32_t id) {
+        if (IsActive(id)) {
+            if (!grid->Contains(id) || !grid->GetBounds(id).Overlaps(keepBox)) {
+                Deactivate(slots[id]);
+                left.push_back(id);
+            }
+        } else if (grid->Contains(id)) {
+            TryActivate(id);
+        }
+    }
+
+    bool IsActive(std::uint32_t id) const { return id < slots.size() && slots[id] != Inactive; }
+
+    /**
+     * @brief Gets every active entity, in no particular order.
+     */
+    std::span<const std::uint32_t> GetActive() const { return active; }
+
+    /**
+     * @brief Gets the entities that became active since the last `Update`.
+     */
+    std::span<const std::uint32_t> GetEntered() const { return entered; }
+
+    /**
+     * @brief Gets the entities that became inactive since the last `Update`.
+     */
+    std::span<const std::uint32_t> GetLeft() const { return left; }
+
+    /**
+     * @brief Stream insertion operator for the ActivationRegion class.
+     *
+     * @param os The output stream.
+     * @param region The ActivationRegion instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const ActivationRegion &region) {
+        os << "ActivationRegion(Active: " << region.active.size() << ", Margins: " << region.activateMargin << "/"
+                << region.deactivateMargin << ")";
+        return os;
+    }
+
+private:
+    static constexpr std::uint32_t Inactive = 0xFFFFFFFFu;
+
+    void TryActivate(std::uint32_t id) {
+        if (IsActive(id) || !grid->GetBounds(id).Overlaps(activeBox)) {
+            return;
+        }
+        if (id >= slots.size()) {
+            slots.resize(grid->GetIdLimit(), Inactive);
+        }
+        slots[id] = static_cast<std::uint32_t>(active.size());
+        active.push_back(id);
+        entered.push_back(id);
+    }
+
+    void Deactivate(std::size_t index) {
+        const std::uint32_t id = active[index];
+        active[index] = active.back();
+        slots[active[index]] = static_cast<std::uint32_t>(index);
+        active.pop_back();
+        slots[id] = Inactive;
+    }
+
+    const SpatialGrid *grid;
+    float activateMargin;
+    float deactivateMargin;
+    Aabb activeBox{0.0f, 0.0f, 0.0f, 0.0f};
+    Aabb keepBox{0.0f, 0.0f, 0.0f, 0.0f};
+    CellRange covered{0, 0, -1, -1};
+    bool hasCovered = false;
+    std::vector<std::uint32_t> active;
+    std::vector<std::uint32_t> slots; // Index into `active` per id, or `Inactive`
+    std::vector<std::uint32_t> entered;
+    std::vector<std::uint32_t> left;
+};
+
+#endif // ACTIVATIONREGION_H
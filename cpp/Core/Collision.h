@@ -0,0 +1,155 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include "../include/AllocationTracker.h"
+#include "../include/Counters.h"
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <vector>
+
+/**
+ * @struct Aabb
+ * @brief An axis-aligned box in Godot coordinates (y grows downwards).
+ */
+struct Aabb {
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+
+    /**
+     * @brief Checks whether two boxes overlap; touching edges do not count.
+     */
+    constexpr bool Overlaps(const Aabb &other) const {
+        return minX < other.maxX && other.minX < maxX && minY < other.maxY && other.minY < maxY;
+    }
+
+    /**
+     * @brief Checks whether a point lies inside the box.
+     */
+    constexpr bool Contains(float x, float y) const {
+        return x >= minX && x < maxX && y >= minY && y < maxY;
+    }
+
+    /**
+     * @brief Returns the smallest box containing both boxes.
+     */
+    constexpr Aabb Merge(const Aabb &other) const {
+        return Aabb{
+            minX < other.minX ? minX : other.minX, minY < other.minY ? minY : other.minY,
+            maxX > other.maxX ? maxX : other.maxX, maxY > other.maxY ? maxY : other.maxY
+        };
+    }
+
+    /**
+     * @brief Returns the box grown by `margin` on every side.
+     */
+    constexpr Aabb Expand(float margin) const {
+        return Aabb{minX - margin, minY - margin, maxX + margin, maxY + margin};
+    }
+
+    /**
+     * @brief Stream insertion operator for the Aabb struct.
+     *
+     * @param os The output stream.
+     * @param box The Aabb instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const Aabb &box) {
+        os << "Aabb(Min: (" << box.minX << ", " << box.minY << "), Max: (" << box.maxX << ", " << box.maxY << "))";
+        return os;
+    }
+};
+
+/**
+ * @brief Finds every box that overlaps the query by testing them all.
+ *
+ * This is the reference query the accelerated structures are measured against. Reserve `hits` up front:
+ * the query runs in a no-allocation scope.
+ *
+ * @param boxes The boxes to test.
+ * @param query The box to test against.
+ * @param hits Receives the indices of the overlapping boxes; cleared first.
+ * @return The number of overlapping boxes.
+ */
+inline std::size_t QueryOverlaps(std::span<const Aabb> boxes, const Aabb &query, std::vector<std::uint32_t> &hits) {
+    NO_ALLOCATION_SCOPE("QueryOverlaps");
+    hits.clear();
+    for (std::size_t index = 0; index < boxes.size(); ++index) {
+        if (boxes[index].Overlaps(query)) {
+            hits.push_back(static_cast<std::uint32_t>(index));
+        }
+    }
+    Counters::Add(Counter::CollisionTests, boxes.size());
+    return hits.size();
+}
+
+/**
+ * @struct SweepHit
+ * @brief Where a moving box first touches another box.
+ */
+struct SweepHit {
+    float time;    // Fraction of the movement completed at contact, in [0, 1)
+    float normalX; // Contact normal pointing away from the hit box
+    float normalY;
+};
+
+/**
+ * @brief Sweeps a box along a displacement and finds when it first touches a target box.
+ *
+ * Boxes that already overlap at the start are not reported; resolve those by pushing out instead.
+ *
+ * @param moving The box at the start of the movement.
+ * @param dx Horizontal displacement.
+ * @param dy Vertical displacement.
+ * @param target The box to test against.
+ * @param hit Receives the contact if there is one.
+ * @return `true` if the box touches the target before the end of the movement.
+ */
+inline bool SweepAabb(const Aabb &moving, float dx, float dy, const Aabb &target, SweepHit &hit) {
+    if (moving.Overlaps(target)) {
+        return false;
+    }
+
+    // Slab test on the target grown by the moving box's extents
+    float entryX = -1.0f;
+    float exitX = 2.0f;
+    if (dx > 0.0f) {
+        entryX = (target.minX - moving.maxX) / dx;
+        exitX = (target.maxX - moving.minX) / dx;
+    } else if (dx < 0.0f) {
+        entryX = (target.maxX - moving.minX) / dx;
+        exitX = (target.minX - moving.maxX) / dx;
+    } else if (moving.maxX <= target.minX || moving.minX >= target.maxX) {
+        return false;
+    }
+    float entryY = -1.0f;
+    float exitY = 2.0f;
+    if (dy > 0.0f) {
+        entryY = (target.minY - moving.maxY) / dy;
+        exitY = (target.maxY - moving.minY) / dy;
+    } else if (dy < 0.0f) {
+        entryY = (target.maxY - moving.minY) / dy;
+        exitY = (target.minY - moving.maxY) / dy;
+    } else if (moving.maxY <= target.minY || moving.minY >= target.maxY) {
+        return false;
+    }
+
+    const float entry = entryX > entryY ? entryX : entryY;
+    const float exit = exitX < exitY ? exitX : exitY;
+    if (entry >= exit || entry < 0.0f || entry >= 1.0f) {
+        return false;
+    }
+    hit.time = entry;
+    if (entryX > entryY) {
+        hit.normalX = dx > 0.0f ? -1.0f : 1.0f;
+        hit.normalY = 0.0f;
+    } else {
+        hit.normalX = 0.0f;
+        hit.normalY = dy > 0.0f ? -1.0f : 1.0f;
+    }
+    return true;
+}
+
+#endif // COLLISION_H
@@ -0,0 +1,248 @@
+#ifndef FORCEFIELD_H
+#define FORCEFIELD_H
+
+#include "Collision.h"
+#include "../include/Profiler.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <vector>
+
+/**
+ * @struct ForceZone
+ * @brief A rectangle of wind or updraft pushing with a constant force, fading out towards its edges.
+ */
+struct ForceZone {
+    Aabb area;
+    float forceX; // Acceleration in pixels per second squared
+    float forceY; // Acceleration in pixels per second squared, negative is up
+    float fade;   // Distance over which the force falls to zero at each edge; 0 is a hard edge
+
+    /**
+     * @brief Gets the force at a point, without the grid.
+     */
+    void Evaluate(float x, float y, float &outX, float &outY) const {
+        const float inside = std::min({x - area.minX, area.maxX - x, y - area.minY, area.maxY - y});
+        const float weight = inside < 0.0f ? 0.0f : fade > 0.0f ? std::min(inside / fade, 1.0f) : 1.0f;
+        outX = forceX * weight;
+        outY = forceY * weight;
+    }
+
+    /**
+     * @brief Stream insertion operator for the ForceZone struct.
+     *
+     * @param os The output stream.
+     * @param zone The ForceZone instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const ForceZone &zone) {
+        os << "ForceZone(" << zone.area << ", Force: (" << zone.forceX << ", " << zone.forceY << "), Fade: "
+                << zone.fade << ")";
+        return os;
+    }
+};
+
+/**
+ * @class ForceField
+ * @brief Every wind and updraft zone of a level, summed into one coarse grid of force vectors.
+ *
+ * Zones are baked into the grid nodes when added, so a sample costs one bilinear lookup however many zones
+ * overlap there: a storm of dozens of gusts is as cheap as a single breeze. Adding a zone outside the
+ * current grid grows the grid and bakes every zone again, which only happens while a level is set up.
+ * Outside the grid the force is zero.
+ *
+ * `Sample` looks up a whole array of agents in one branch-free pass the compiler can vectorize.
+ */
+class ForceField {
+public:
+    /**
+     * @param cellSize Distance between grid nodes; zones narrower than a cell are smeared over it.
+     */
+    explicit ForceField(float cellSize = 32.0f) : cellSize(cellSize), inverseCellSize(1.0f / cellSize) {
+    }
+
+    /**
+     * @brief Adds a zone to the field.
+     */
+    void AddZone(const ForceZone &zone) { AddZones(std::span<const ForceZone>(&zone, 1)); }
+
+    /**
+     * @brief Adds several zones to the field, growing the grid at most once.
+     */
+    void AddZones(std::span<const ForceZone> added) {
+        if (added.empty()) {
+            return;
+        }
+        Aabb area = zones.empty() ? added.front().area : covered;
+        bool inside = !zones.empty();
+        for (const ForceZone &zone: added) {
+            area = area.Merge(zone.area);
+            inside = inside && Covers(zone.area);
+        }
+        covered = area;
+        zones.insert(zones.end(), added.begin(), added.end());
+        if (inside) {
+            for (const ForceZone &zone: added) {
+                Bake(zone);
+            }
+            return;
+        }
+        Resize(covered);
+        for (const ForceZone &zone: zones) {
+            Bake(zone);
+        }
+    }
+
+    /**
+     * @brief Removes every zone.
+     */
+    void Clear() {
+        zones.clear();
+        forcesX.clear();
+        forcesY.clear();
+        columns = 0;
+        rows = 0;
+    }
+
+    bool IsEmpty() const { return zones.empty(); }
+
+    std::size_t GetZoneCount() const { return zones.size(); }
+
+    /**
+     * @brief Gets the force at one point.
+     */
+    void SampleOne(float x, float y, float &outX, float &outY) const {
+        if (zones.empty()) {
+            outX = 0.0f;
+            outY = 0.0f;
+            return;
+        }
+        SampleAll(1, &x, &y, &outX, &outY, forcesX.data(), forcesY.data(), originX, originY, inverseCellSize,
+                  columns, rows);
+    }
+
+    /**
+     * @brief Gets the force at every agent's position in one pass.
+     *
+     * @param x The X of every agent.
+     * @param y The Y of every agent; as long as `x`.
+     * @param outX Receives the X force on every agent; as long as `x`.
+     * @param outY Receives the Y force on every agent; as long as `x`.
+     */
+    void Sample(std::span<const float> x, std::span<const float> y, std::span<float> outX,
+                std::span<float> outY) const {
+        PROFILE_ZONE("ForceField::Sample");
+        if (zones.empty()) {
+            std::fill(outX.begin(), outX.begin() + static_cast<std::ptrdiff_t>(x.size()), 0.0f);
+            std::fill(outY.begin(), outY.begin() + static_cast<std::ptrdiff_t>(x.size()), 0.0f);
+            return;
+        }
+        SampleAll(x.size(), x.data(), y.data(), outX.data(), outY.data(), forcesX.data(), forcesY.data(),
+                  originX, originY, inverseCellSize, columns, rows);
+    }
+
+    /**
+     * @brief Stream insertion operator for the ForceField class.
+     *
+     * @param os The output stream.
+     * @param field The ForceField instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const ForceField &field) {
+        os << "ForceField(Zones: " << field.zones.size() << ", Nodes: " << field.columns << "x" << field.rows
+                << ", CellSize: " << field.cellSize << ")";
+        return os;
+    }
+
+private:
+    /**
+     * @brief Checks whether an area lies strictly inside the border nodes, which must stay zero.
+     */
+    bool Covers(const Aabb &area) const {
+        return area.minX > originX && area.minY > originY &&
+               area.maxX < originX + static_cast<float>(columns - 1) * cellSize &&
+               area.maxY < originY + static_cast<float>(rows - 1) * cellSize;
+    }
+
+    /**
+     * @brief Lays the nodes over an area, with a ring of zero nodes around it so the force fades out.
+     */
+    void Resize(const Aabb &area) {
+        originX = area.minX - cellSize;
+        originY = area.minY - cellSize;
+        columns = static_cast<int>((area.maxX - area.minX) * inverseCellSize) + 3;
+        rows = static_cast<int>((area.maxY - area.minY) * inverseCellSize) + 3;
+        forcesX.assign(static_cast<std::size_t>(columns) * static_cast<std::size_t>(rows), 0.0f);
+        forcesY.assign(forcesX.size(), 0.0f);
+    }
+
+    int ColumnOf(float x) const { return static_cast<int>((x - originX) * inverseCellSize); }
+
+    int RowOf(float y) const { return static_cast<int>((y - originY) * inverseCellSize); }
+
+    /**
+     * @brief Adds a zone's force to the nodes it covers.
+     */
+    void Bake(const ForceZone &zone) {
+        const int minColumn = ColumnOf(zone.area.minX);
+        const int minRow = RowOf(zone.area.minY);
+        const int maxColumn = std::min(columns - 1, ColumnOf(zone.area.maxX) + 1);
+        const int maxRow = std::min(rows - 1, RowOf(zone.area.maxY) + 1);
+        for (int row = minRow; row <= maxRow; ++row) {
+            for (int column = minColumn; column <= maxColumn; ++column) {
+                float x, y;
+                zone.Evaluate(originX + static_cast<float>(column) * cellSize,
+                              originY + static_cast<float>(row) * cellSize, x, y);
+                const std::size_t node = static_cast<std::size_t>(row) * static_cast<std::size_t>(columns) +
+                                         static_cast<std::size_t>(column);
+                forcesX[node] += x;
+                forcesY[node] += y;
+            }
+        }
+    }
+
+    /**
+     * @brief The bilinear lookup behind `Sample`; `restrict` tells the compiler the nodes are never written.
+     *
+     * Points outside the grid are clamped onto its border, which is all zero nodes.
+     */
+    static void SampleAll(std::size_t count, const float *__restrict x, const float *__restrict y,
+                          float *__restrict outX, float *__restrict outY, const float *__restrict nodesX,
+                          const float *__restrict nodesY, float originX, float originY, float inverseCellSize,
+                          int columns, int rows) {
+        const float lastColumn = static_cast<float>(columns - 2);
+        const float lastRow = static_cast<float>(rows - 2);
+        const float lastX = static_cast<float>(columns - 1);
+        const float lastY = static_cast<float>(rows - 1);
+        for (std::size_t index = 0; index < count; ++index) {
+            const float gridX = std::clamp((x[index] - originX) * inverseCellSize, 0.0f, lastX);
+            const float gridY = std::clamp((y[index] - originY) * inverseCellSize, 0.0f, lastY);
+            const float column = std::min(static_cast<float>(static_cast<int>(gridX)), lastColumn);
+            const float row = std::min(static_cast<float>(static_cast<int>(gridY)), lastRow);
+            const float fractionX = gridX - column;
+            const float fractionY = gridY - row;
+            const int node = static_cast<int>(row) * columns + static_cast<int>(column);
+            const float topX = nodesX[node] + (nodesX[node + 1] - nodesX[node]) * fractionX;
+            const int below = node + columns;
+            const float bottomX = nodesX[below] + (nodesX[below + 1] - nodesX[below]) * fractionX;
+            const float topY = nodesY[node] + (nodesY[node + 1] - nodesY[node]) * fractionX;
+            const float bottomY = nodesY[below] + (nodesY[below + 1] - nodesY[below]) * fractionX;
+            outX[index] = topX + (bottomX - topX) * fractionY;
+            outY[index] = topY + (bottomY - topY) * fractionY;
+        }
+    }
+
+    float cellSize;
+    float inverseCellSize;
+    float originX = 0.0f; // Position of the first node
+    float originY = 0.0f;
+    Aabb covered{0.0f, 0.0f, 0.0f, 0.0f}; // Union of every zone's area
+    int columns = 0;
+    int rows = 0;
+    std::vector<float> forcesX;
+    std::vector<float> forcesY;
+    std::vector<ForceZone> zones;
+};
+
+#endif // FORCEFIELD_H
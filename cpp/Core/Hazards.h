@@ -0,0 +1,262 @@
+#ifndef HAZARDS_H
+#define HAZARDS_H
+
+#include "Collision.h"
+#include "World.h"
+#include "../include/AllocationTracker.h"
+#include "../include/Counters.h"
+#include "../include/Profiler.h"
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <vector>
+
+/**
+ * @brief What a falling hazard is, which sets its size.
+ */
+enum class HazardKind : std::uint8_t {
+    Rock,
+    Icicle,
+};
+
+/**
+ * @struct HazardImpact
+ * @brief Where a hazard shattered, for debris effects and sounds.
+ */
+struct HazardImpact {
+    float x;
+    float y;
+    HazardKind kind;
+};
+
+/**
+ * @class Hazards
+ * @brief Thousands of falling rocks and icicles, stored one array per field.
+ *
+ * A tick is three passes. `Integrate` applies gravity and moves every hazard in one branch-free loop the
+ * compiler vectorizes. `Collide` sweeps every hazard along the tick's movement against the level's solids
+ * through their grid, so a fast hazard cannot pass through a thin ledge, and shatters those that hit
+ * something or left the bounds, closing the gaps as it goes, so the live hazards always fill the front of
+ * the arrays. `FindHits` checks a box, usually the player, against all of them.
+ *
+ * Every array is sized to the capacity up front; spawning, shattering and compaction never allocate.
+ */
+class Hazards {
+public:
+    /**
+     * @param capacity The most hazards alive at once; spawns beyond it are dropped.
+     */
+    explicit Hazards(std::size_t capacity = 4096)
+        : positionsX(capacity), positionsY(capacity), velocitiesX(capacity), velocitiesY(capacity),
+          halfWidths(capacity), halfHeights(capacity), kinds(capacity) {
+        impacts.reserve(capacity);
+    }
+
+    /**
+     * @brief Gets the half extents of a kind of hazard.
+     */
+    static constexpr void GetHalfExtents(HazardKind kind, float &halfWidth, float &halfHeight) {
+        halfWidth = kind == HazardKind::Icicle ? 3.0f : 6.0f;
+        halfHeight = kind == HazardKind::Icicle ? 10.0f : 6.0f;
+    }
+
+    /**
+     * @brief Adds a hazard.
+     *
+     * @return `false` if the system is full and the hazard was dropped.
+     */
+    bool Spawn(HazardKind kind, float x, float y, float velocityX, float velocityY) {
+        if (count == positionsX.size()) {
+            return false;
+        }
+        positionsX[count] = x;
+        positionsY[count] = y;
+        velocitiesX[count] = velocityX;
+        velocitiesY[count] = velocityY;
+        GetHalfExtents(kind, halfWidths[count], halfHeights[count]);
+        kinds[count] = kind;
+        ++count;
+        return true;
+    }
+
+    /**
+     * @brief Removes one hazard by moving the last one into its slot.
+     *
+     * Removing several indices is safe in descending order, such as backwards over `FindHits`.
+     */
+    void Remove(std::size_t index) {
+        Move(count - 1, index);
+        --count;
+    }
+
+    /**
+     * @brief Removes every hazard.
+     */
+    void Clear() {
+        count = 0;
+        impacts.clear();
+    }
+
+    /**
+     * @brief Applies gravity and moves every hazard by one tick.
+     *
+     * @param delta The duration of the tick in seconds.
+     * @param gravity The downward acceleration in pixels per second squared.
+     */
+    void Integrate(float delta, float gravity) {
+        PROFILE_ZONE("Hazards::Integrate");
+        IntegrateAll(count, delta, gravity, positionsX.data(), positionsY.data(), velocitiesX.data(),
+                     velocitiesY.data());
+        lastDelta = delta;
+    }
+
+    /**
+     * @brief Shatters every hazard touching a solid of the level or outside the bounds, and compacts the rest.
+     *
+     * Each hazard is swept from where the last `Integrate` moved it from, and shatters at its first contact
+     * along the way. The hazards shattered on a solid are listed by `GetImpacts` until the next call.
+     *
+     * @param world The level whose solids stop hazards.
+     * @param bounds The area hazards live in; those that leave it disappear without an impact.
+     * @return The number of hazards removed.
+     */
+    std::size_t Collide(const World &world, const Aabb &bounds) {
+        PROFILE_ZONE("Hazards::Collide");
+        NO_ALLOCATION_SCOPE("Hazards::Collide");
+        impacts.clear();
+        std::size_t kept = 0;
+        std::uint64_t tests = 0;
+        for (std::size_t index = 0; index < count; ++index) {
+            const Aabb box = GetBox(index);
+            const float moveX = velocitiesX[index] * lastDelta;
+            const float moveY = velocitiesY[index] * lastDelta;
+            const Aabb start{box.minX - moveX, box.minY - moveY, box.maxX - moveX, box.maxY - moveY};
+
+            // The earliest contact along the movement, as a fraction of it; above 1 if there is none
+            float contact = 2.0f;
+            const CellRange cells = world.grid.GetCells(start.Merge(box));
+            for (int row = cells.minRow; row <= cells.maxRow && contact > 0.0f; ++row) {
+                for (int column = cells.minColumn; column <= cells.maxColumn && contact > 0.0f; ++column) {
+                    for (const std::uint32_t solid: world.grid.GetCell(column, row)) {
+                        ++tests;
+                        SweepHit sweep{};
+                        if (world.solids[solid].Overlaps(start)) {
+                            contact = 0.0f;
+                            break;
+                        }
+                        if (SweepAabb(start, moveX, moveY, world.solids[solid], sweep) && sweep.time < contact) {
+                            contact = sweep.time;
+                        }
+                    }
+                }
+            }
+
+            if (contact <= 1.0f) {
+                impacts.push_back(HazardImpact{positionsX[index] - moveX * (1.0f - contact),
+                                               positionsY[index] - moveY * (1.0f - contact), kinds[index]});
+            } else if (box.Overlaps(bounds)) {
+                Move(index, kept++);
+            }
+        }
+        Counters::Add(Counter::CollisionTests, tests);
+        const std::size_t removed = count - kept;
+        count = kept;
+        return removed;
+    }
+
+    /**
+     * @brief Finds every hazard overlapping a box.
+     *
+     * @param box The box to test, usually the player.
+     * @param hits Receives the indices of the overlapping hazards; cleared first.
+     * @return The number of overlapping hazards.
+     */
+    std::size_t FindHits(const Aabb &box, std::vector<std::uint32_t> &hits) const {
+        hits.clear();
+        for (std::size_t index = 0; index < count; ++index) {
+            if (GetBox(index).Overlaps(box)) {
+                hits.push_back(static_cast<std::uint32_t>(index));
+            }
+        }
+        Counters::Add(Counter::CollisionTests, count);
+        return hits.size();
+    }
+
+    std::size_t GetCount() const { return count; }
+
+    std::size_t GetCapacity() const { return positionsX.size(); }
+
+    std::span<const float> GetPositionsX() const { return {positionsX.data(), count}; }
+
+    std::span<const float> GetPositionsY() const { return {positionsY.data(), count}; }
+
+    std::span<const HazardKind> GetKinds() const { return {kinds.data(), count}; }
+
+    /**
+     * @brief Gets where hazards shattered during the last `Collide`.
+     */
+    std::span<const HazardImpact> GetImpacts() const { return impacts; }
+
+    /**
+     * @brief Gets a hazard's box.
+     */
+    Aabb GetBox(std::size_t index) const {
+        return Aabb{positionsX[index] - halfWidths[index], positionsY[index] - halfHeights[index],
+                    positionsX[index] + halfWidths[index], positionsY[index] + halfHeights[index]};
+    }
+
+    /**
+     * @brief Stream insertion operator for the Hazards class.
+     *
+     * @param os The output stream.
+     * @param hazards The Hazards instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const Hazards &hazards) {
+        os << "Hazards(Count: " << hazards.count << ", Capacity: " << hazards.positionsX.size() << ")";
+        return os;
+    }
+
+private:
+    /**
+     * @brief The loop behind `Integrate`; `restrict` lets the compiler vectorize it without alias checks.
+     */
+    static void IntegrateAll(std::size_t count, float delta, float gravity, float *__restrict x,
+                             float *__restrict y, float *__restrict velocityX, float *__restrict velocityY) {
+        const float fall = gravity * delta;
+        for (std::size_t index = 0; index < count; ++index) {
+            velocityY[index] += fall;
+            x[index] += velocityX[index] * delta;
+            y[index] += velocityY[index] * delta;
+        }
+    }
+
+    /**
+     * @brief Moves a hazard to a lower slot while compacting.
+     */
+    void Move(std::size_t from, std::size_t to) {
+        if (from == to) {
+            return;
+        }
+        positionsX[to] = positionsX[from];
+        positionsY[to] = positionsY[from];
+        velocitiesX[to] = velocitiesX[from];
+        velocitiesY[to] = velocitiesY[from];
+        halfWidths[to] = halfWidths[from];
+        halfHeights[to] = halfHeights[from];
+        kinds[to] = kinds[from];
+    }
+
+    std::size_t count = 0;
+    float lastDelta = 0.0f; // The tick `Integrate` last moved the hazards by
+    std::vector<float> positionsX;
+    std::vector<float> positionsY;
+    std::vector<float> velocitiesX;
+    std::vector<float> velocitiesY;
+    std::vector<float> halfWidths;
+    std::vector<float> halfHeights;
+    std::vector<HazardKind> kinds;
+    std::vector<HazardImpact> impacts;
+};
+
+#endif // HAZARDS_H
@@ -0,0 +1,97 @@
+#ifndef INPUTSNAPSHOT_H
+#define INPUTSNAPSHOT_H
+
+#include "MovementTuning.h"
+#include <cstdint>
+#include <iostream>
+
+/**
+ * @brief The gameplay actions read from the input system.
+ *
+ * The enumerator values are bit positions inside `InputSnapshot`, so new actions must be appended before `Count`.
+ */
+enum class InputAction : std::uint8_t {
+    Left = 0,
+    Right = 1,
+    Jump = 2,
+    Count
+};
+
+/**
+ * @struct InputSnapshot
+ * @brief The state of every gameplay action for one physics tick, packed into two bitmasks.
+ *
+ * Gameplay code reads this instead of querying the input system by action name, and replays and recordings
+ * store it as-is.
+ */
+struct InputSnapshot {
+    /**
+     * @brief One bit per action that is held down this tick.
+     */
+    std::uint8_t held = 0;
+
+    /**
+     * @brief One bit per action that went down this tick.
+     */
+    std::uint8_t pressed = 0;
+
+    /**
+     * @brief Gets the bit of an action inside the masks.
+     */
+    static constexpr std::uint8_t Bit(InputAction action) {
+        return static_cast<std::uint8_t>(1u << static_cast<unsigned>(action));
+    }
+
+    /**
+     * @brief Checks whether an action is held down this tick.
+     */
+    constexpr bool IsHeld(InputAction action) const { return (held & Bit(action)) != 0; }
+
+    /**
+     * @brief Checks whether an action went down this tick.
+     */
+    constexpr bool WasPressed(InputAction action) const { return (pressed & Bit(action)) != 0; }
+
+    /**
+     * @brief Records the state of one action.
+     *
+     * @param action The action to record.
+     * @param isHeld Whether the action is held down.
+     * @param wasPressed Whether the action went down this tick.
+     */
+    constexpr void Set(InputAction action, bool isHeld, bool wasPressed) {
+        held = static_cast<std::uint8_t>((held & ~Bit(action)) | (isHeld ? Bit(action) : 0u));
+        pressed = static_cast<std::uint8_t>((pressed & ~Bit(action)) | (wasPressed ? Bit(action) : 0u));
+    }
+
+    /**
+     * @brief Translates the snapshot into the movement intent used by `MovementStep`.
+     *
+     * @param canJump Whether the player is currently allowed to jump.
+     * @return The movement input for this tick.
+     */
+    constexpr MovementInput ToMovementInput(bool canJump) const {
+        return MovementInput{
+            IsHeld(InputAction::Left), IsHeld(InputAction::Right), canJump && WasPressed(InputAction::Jump)
+        };
+    }
+
+    friend constexpr bool operator==(const InputSnapshot &, const InputSnapshot &) = default;
+
+    /**
+     * @brief Stream insertion operator for the InputSnapshot struct.
+     *
+     * @param os The output stream.
+     * @param snapshot The InputSnapshot instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const InputSnapshot &snapshot) {
+        os << "InputSnapshot(Held: " << static_cast<unsigned>(snapshot.held)
+                << ", Pressed: " << static_cast<unsigned>(snapshot.pressed) << ")";
+        return os;
+    }
+};
+
+static_assert(static_cast<unsigned>(InputAction::Count) <= 8, "InputSnapshot stores actions in 8-bit masks");
+
+#endif // INPUTSNAPSHOT_H
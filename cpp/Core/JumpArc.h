@@ -0,0 +1,275 @@
+#ifndef JUMPARC_H
+#define JUMPARC_H
+
+#include "MovementConstants.h"
+#include <array>
+#include <iostream>
+
+/**
+ * @struct Ledge
+ * @brief A horizontal standing surface described in Godot coordinates (y grows downwards).
+ */
+struct Ledge {
+    /**
+     * @brief X coordinate of the left end of the ledge.
+     */
+    float left;
+
+    /**
+     * @brief X coordinate of the right end of the ledge.
+     */
+    float right;
+
+    /**
+     * @brief Y coordinate of the top of the ledge.
+     */
+    float top;
+
+    /**
+     * @brief Stream insertion operator for the Ledge struct.
+     *
+     * @param os The output stream.
+     * @param ledge The Ledge instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const Ledge &ledge) {
+        os << "Ledge(Left: " << ledge.left << ", Right: " << ledge.right << ", Top: " << ledge.top << ")";
+        return os;
+    }
+};
+
+/**
+ * @struct JumpSimulation
+ * @brief Tick-by-tick replay of the jump used to build the `JumpArc` tables at compile time.
+ *
+ * The integration mirrors the airborne branch of `Player::_physics_process`: the impulse is applied on the
+ * take-off tick, then `Gravity * TickDelta` is added to the vertical velocity on every following tick.
+ */
+struct JumpSimulation {
+    /**
+     * @brief Per-tick state of the simulated jump.
+     */
+    struct Sample {
+        float rise;      // Height above the launch point (positive is up)
+        float velocityY; // Vertical velocity in Godot coordinates
+    };
+
+    /**
+     * @brief State at the end of the take-off tick.
+     */
+    static constexpr Sample TakeOff() {
+        return {-MovementConstants::JumpImpulse * MovementConstants::TickDelta, MovementConstants::JumpImpulse};
+    }
+
+    /**
+     * @brief Advances the simulated jump by one airborne tick.
+     */
+    static constexpr Sample Advance(Sample sample) {
+        sample.velocityY += MovementConstants::Gravity * MovementConstants::TickDelta;
+        sample.rise -= sample.velocityY * MovementConstants::TickDelta;
+        return sample;
+    }
+
+    /**
+     * @brief Counts the ticks from take-off until the arc has dropped `maxDrop` below the launch point.
+     */
+    static constexpr int CountTicks(float maxDrop) {
+        Sample sample = TakeOff();
+        int ticks = 1;
+        while (sample.rise > -maxDrop) {
+            sample = Advance(sample);
+            ++ticks;
+        }
+        return ticks;
+    }
+
+    /**
+     * @brief Finds the highest point of the arc.
+     */
+    static constexpr float Apex() {
+        Sample sample = TakeOff();
+        float apex = sample.rise;
+        while (sample.velocityY < 0.0f) {
+            sample = Advance(sample);
+            apex = sample.rise > apex ? sample.rise : apex;
+        }
+        return apex;
+    }
+
+    /**
+     * @brief Records the rise above the launch point after each of the first `Ticks` ticks.
+     */
+    template<int Ticks>
+    static constexpr std::array<float, Ticks> RiseTable() {
+        std::array<float, Ticks> table{};
+        Sample sample = TakeOff();
+        table[0] = sample.rise;
+        for (int tick = 1; tick < Ticks; ++tick) {
+            sample = Advance(sample);
+            table[tick] = sample.rise;
+        }
+        return table;
+    }
+
+    /**
+     * @brief For each height bucket, computes the horizontal distance covered by the last tick that still
+     *        ends at or above the top edge of that bucket.
+     *
+     * Using the top edge and whole ticks keeps the answer conservative: the table never promises more than the
+     * real arc allows. The bucket holding the apex gets the distance covered up to the apex.
+     */
+    template<int Buckets, int Ticks>
+    static constexpr std::array<float, Buckets> ReachTable(const std::array<float, Ticks> &rise, float maxDrop,
+                                                           float cellSize) {
+        std::array<float, Buckets> table{};
+        int tick = 0;
+        // Skip the ascending half of the arc; the player can only land while falling
+        while (tick + 1 < Ticks && rise[tick + 1] >= rise[tick]) {
+            ++tick;
+        }
+        const int apexTick = tick;
+        // Buckets are walked from the top down, so the landing tick only ever moves forward
+        for (int bucket = Buckets - 1; bucket >= 0; --bucket) {
+            const float height = -maxDrop + static_cast<float>(bucket + 1) * cellSize;
+            while (tick + 1 < Ticks && rise[tick] > height) {
+                ++tick;
+            }
+            // `tick` is the first tick ending below the edge, so the player covers only the ticks before it
+            const int covered = tick == apexTick || rise[tick] > height ? tick + 1 : tick;
+            table[bucket] = static_cast<float>(covered) * MovementConstants::HorizontalSpeed *
+                            MovementConstants::TickDelta;
+        }
+        return table;
+    }
+
+    /**
+     * @brief Checks that every reach in a table is covered by a tick that ends at or above its bucket's top
+     *        edge, or at the apex for the bucket holding it.
+     */
+    template<int Buckets, int Ticks>
+    static constexpr bool IsAchievable(const std::array<float, Buckets> &reach, const std::array<float, Ticks> &rise,
+                                       float maxDrop, float cellSize, float apex) {
+        constexpr float TickDistance = MovementConstants::HorizontalSpeed * MovementConstants::TickDelta;
+        for (int bucket = 0; bucket < Buckets; ++bucket) {
+            const int covered = static_cast<int>(reach[bucket] / TickDistance + 0.5f);
+            const float height = -maxDrop + static_cast<float>(bucket + 1) * cellSize;
+            if (covered < 1 || covered > Ticks || rise[covered - 1] < (height < apex ? height : apex)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @class JumpArc
+ * @brief Compile-time tables describing the dwarf's jump arc and the ledges it can reach.
+ *
+ * The tables are derived from `MovementConstants` by `JumpSimulation`, so they always agree with the values
+ * the player uses. Reachability is answered by bucketing the height difference between two ledges and
+ * looking up the furthest horizontal distance the player can cover before descending through that height,
+ * instead of simulating the jump.
+ */
+class JumpArc {
+public:
+    /**
+     * @brief Height of one reachability bucket in world units.
+     */
+    static constexpr float CellSize = 16.0f;
+
+    /**
+     * @brief Deepest drop below the launch ledge covered by the table.
+     *
+     * Deeper drops use the deepest bucket, which is the most permissive entry of the table.
+     */
+    static constexpr float MaxDrop = 1024.0f;
+
+    /**
+     * @brief Number of ticks from take-off until the arc has dropped `MaxDrop` below the launch ledge.
+     */
+    static constexpr int TickCount = JumpSimulation::CountTicks(MaxDrop);
+
+    /**
+     * @brief Highest rise above the launch ledge the jump reaches.
+     */
+    static constexpr float Apex = JumpSimulation::Apex();
+
+    /**
+     * @brief Number of height buckets, from `-MaxDrop` up to the apex.
+     */
+    static constexpr int BucketCount = static_cast<int>((Apex + MaxDrop) / CellSize) + 1;
+
+    /**
+     * @brief Rise above the launch ledge after each tick of the jump.
+     */
+    static constexpr std::array<float, TickCount> Rise = JumpSimulation::RiseTable<TickCount>();
+
+    /**
+     * @brief Furthest horizontal distance at which a ledge in each height bucket can still be landed on.
+     */
+    static constexpr std::array<float, BucketCount> Reach =
+            JumpSimulation::ReachTable<BucketCount, TickCount>(Rise, MaxDrop, CellSize);
+
+    /**
+     * @brief Apex of the continuous arc, v² / 2g, which the per-tick integration approximates to within one tick.
+     */
+    static constexpr float ContinuousApex = MovementConstants::JumpImpulse * MovementConstants::JumpImpulse /
+                                            (2.0f * MovementConstants::Gravity);
+
+    // The tables must follow the tuned jump, so a tuning change that desyncs them fails to compile
+    static_assert(Rise[0] == -MovementConstants::JumpImpulse * MovementConstants::TickDelta,
+                  "The rise table must start from MovementConstants::JumpImpulse");
+    static_assert(Apex - ContinuousApex <= Rise[0] && ContinuousApex - Apex <= Rise[0],
+                  "The apex must match MovementConstants::JumpImpulse and Gravity");
+    static_assert(JumpSimulation::IsAchievable<BucketCount, TickCount>(Reach, Rise, MaxDrop, CellSize, Apex),
+                  "Every reach must be covered by the arc MovementConstants produce");
+
+    /**
+     * @brief Returns the furthest horizontal distance at which a surface `rise` units above the launch point
+     *        can still be landed on.
+     *
+     * @param rise Height of the target above the launch point (positive is up).
+     * @return The maximum horizontal distance, or a negative value if the height is above the apex.
+     */
+    static constexpr float MaxReach(float rise) {
+        if (rise > Apex) {
+            return -1.0f;
+        }
+        const int bucket = static_cast<int>((rise + MaxDrop) / CellSize);
+        return Reach[bucket < 0 ? 0 : bucket];
+    }
+
+    /**
+     * @brief Checks whether a jump can carry the player across the given offset.
+     *
+     * @param dx Horizontal distance to cover.
+     * @param dy Vertical offset in Godot coordinates (negative is up).
+     * @return `true` if the offset lies inside the jump envelope.
+     */
+    static constexpr bool CanReach(float dx, float dy) {
+        const float distance = dx < 0.0f ? -dx : dx;
+        return distance <= MaxReach(-dy);
+    }
+
+    /**
+     * @brief Checks whether the player can jump from one ledge and land on another.
+     *
+     * The player may take off anywhere on `from` and land anywhere on `to`, so only the horizontal gap
+     * between the two ledges matters.
+     *
+     * @param from The ledge the player jumps from.
+     * @param to The ledge the player wants to land on.
+     * @return `true` if `to` is reachable from `from` with a single jump.
+     */
+    static constexpr bool CanReach(const Ledge &from, const Ledge &to) {
+        float gap = 0.0f;
+        if (to.left > from.right) {
+            gap = to.left - from.right;
+        } else if (from.left > to.right) {
+            gap = from.left - to.right;
+        }
+        return CanReach(gap, to.top - from.top);
+    }
+};
+
+#endif // JUMPARC_H
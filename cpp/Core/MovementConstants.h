@@ -0,0 +1,38 @@
+#ifndef MOVEMENTCONSTANTS_H
+#define MOVEMENTCONSTANTS_H
+
+/**
+ * @struct MovementConstants
+ * @brief The tuning values that define how the dwarf moves.
+ *
+ * These used to be literals scattered through `Player.cpp`. Keeping them in one Godot-free place lets
+ * compile-time tools such as the jump arc tables derive their data from the exact values the game uses.
+ */
+struct MovementConstants {
+    /**
+     * @brief Vertical velocity applied on the tick the player jumps (negative is up in Godot).
+     */
+    static constexpr float JumpImpulse = -300.0f;
+
+    /**
+     * @brief Downward acceleration applied every airborne tick.
+     */
+    static constexpr float Gravity = 9.8f;
+
+    /**
+     * @brief Horizontal speed while a direction is held.
+     */
+    static constexpr float HorizontalSpeed = 100.0f;
+
+    /**
+     * @brief Physics ticks per second, matching Godot's default `physics/common/physics_ticks_per_second`.
+     */
+    static constexpr int TicksPerSecond = 60;
+
+    /**
+     * @brief Duration of a single physics tick in seconds.
+     */
+    static constexpr float TickDelta = 1.0f / static_cast<float>(TicksPerSecond);
+};
+
+#endif // MOVEMENTCONSTANTS_H
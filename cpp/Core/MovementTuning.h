@@ -0,0 +1,176 @@
+#ifndef MOVEMENTTUNING_H
+#define MOVEMENTTUNING_H
+
+#include "MovementConstants.h"
+#include <iostream>
+
+/**
+ * @struct MovementTuning
+ * @brief Runtime description of a movement variant.
+ *
+ * Every tuning policy exposes one of these as `Values`, so the templated step and the runtime-parameter
+ * step read the exact same numbers.
+ */
+struct MovementTuning {
+    /**
+     * @brief Downward acceleration applied every airborne tick.
+     */
+    float gravity;
+
+    /**
+     * @brief Vertical velocity applied on the jump tick (negative is up).
+     */
+    float jumpImpulse;
+
+    /**
+     * @brief Horizontal speed while a direction is held.
+     */
+    float runSpeed;
+
+    /**
+     * @brief Fraction of the gap to the target horizontal speed closed every tick (1 is instant).
+     */
+    float traction;
+
+    /**
+     * @brief Stream insertion operator for the MovementTuning struct.
+     *
+     * @param os The output stream.
+     * @param tuning The MovementTuning instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const MovementTuning &tuning) {
+        os << "MovementTuning(Gravity: " << tuning.gravity << ", JumpImpulse: " << tuning.jumpImpulse
+                << ", RunSpeed: " << tuning.runSpeed << ", Traction: " << tuning.traction << ")";
+        return os;
+    }
+};
+
+/**
+ * @brief Default movement on solid ground.
+ */
+struct NormalTuning {
+    static constexpr MovementTuning Values{
+        MovementConstants::Gravity, MovementConstants::JumpImpulse, MovementConstants::HorizontalSpeed, 1.0f
+    };
+};
+
+/**
+ * @brief Faster, slippery movement used on ice sections.
+ */
+struct IceTuning {
+    static constexpr MovementTuning Values{
+        MovementConstants::Gravity, MovementConstants::JumpImpulse, MovementConstants::HorizontalSpeed * 1.5f, 0.1f
+    };
+};
+
+/**
+ * @brief Floaty movement for low-gravity sections.
+ */
+struct LowGravityTuning {
+    static constexpr MovementTuning Values{
+        MovementConstants::Gravity / 3.0f, MovementConstants::JumpImpulse, MovementConstants::HorizontalSpeed, 1.0f
+    };
+};
+
+/**
+ * @brief Exaggerated values used by automated tests and tools to cover ground quickly.
+ */
+struct TestTuning {
+    static constexpr MovementTuning Values{
+        MovementConstants::Gravity * 100.0f, MovementConstants::JumpImpulse * 2.0f,
+        MovementConstants::HorizontalSpeed * 4.0f, 1.0f
+    };
+};
+
+/**
+ * @struct MovementInput
+ * @brief The player's intent for one tick.
+ */
+struct MovementInput {
+    bool left;
+    bool right;
+    bool jump;
+};
+
+/**
+ * @struct MovementState
+ * @brief The part of the player's state advanced by the movement rules.
+ */
+struct MovementState {
+    float velocityX;
+    float velocityY;
+    bool canJump;
+
+    /**
+     * @brief Stream insertion operator for the MovementState struct.
+     *
+     * @param os The output stream.
+     * @param state The MovementState instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const MovementState &state) {
+        os << "MovementState(Velocity: (" << state.velocityX << ", " << state.velocityY << "), CanJump: "
+                << (state.canJump ? "true" : "false") << ")";
+        return os;
+    }
+};
+
+/**
+ * @brief Advances the movement state by one tick using runtime tuning values.
+ *
+ * This is the reference implementation: gravity is applied while airborne, landing restores the jump,
+ * a jump press on the floor applies the impulse, and the horizontal speed approaches the held direction.
+ * The body is written with selects instead of branches so the templated overload folds to straight-line code.
+ *
+ * @param tuning The tuning values to use.
+ * @param state The state at the start of the tick.
+ * @param input The player's input for this tick.
+ * @param onFloor Whether the player is standing on the floor.
+ * @param delta The duration of the tick in seconds.
+ * @return The state at the end of the tick.
+ */
+inline MovementState MovementStep(const MovementTuning &tuning, MovementState state, MovementInput input,
+                                  bool onFloor, float delta) {
+    const float airborne = onFloor ? 0.0f : 1.0f;
+    const bool jumps = onFloor && input.jump;
+    const float direction = static_cast<float>(input.right) - static_cast<float>(input.left && !input.right);
+    const float targetX = direction * tuning.runSpeed;
+
+    state.velocityY = airborne * (state.velocityY + tuning.gravity * delta) +
+                      static_cast<float>(jumps) * tuning.jumpImpulse;
+    state.velocityX += (targetX - state.velocityX) * tuning.traction;
+    state.canJump = onFloor && !jumps;
+    return state;
+}
+
+/**
+ * @brief Advances the movement state by one tick with the tuning fixed at compile time.
+ *
+ * @tparam Tuning A policy exposing `static constexpr MovementTuning Values`.
+ * @param state The state at the start of the tick.
+ * @param input The player's input for this tick.
+ * @param onFloor Whether the player is standing on the floor.
+ * @param delta The duration of the tick in seconds.
+ * @return The state at the end of the tick.
+ */
+template<typename Tuning>
+MovementState MovementStep(MovementState state, MovementInput input, bool onFloor, float delta) {
+    constexpr MovementTuning tuning = Tuning::Values;
+    const float airborne = onFloor ? 0.0f : 1.0f;
+    const bool jumps = onFloor && input.jump;
+    const float direction = static_cast<float>(input.right) - static_cast<float>(input.left && !input.right);
+
+    state.velocityY = airborne * (state.velocityY + tuning.gravity * delta) +
+                      static_cast<float>(jumps) * tuning.jumpImpulse;
+    if constexpr (tuning.traction == 1.0f) {
+        // Full traction snaps to the target speed, which the runtime version cannot assume
+        state.velocityX = direction * tuning.runSpeed;
+    } else {
+        state.velocityX += (direction * tuning.runSpeed - state.velocityX) * tuning.traction;
+    }
+    state.canJump = onFloor && !jumps;
+    return state;
+}
+
+#endif // MOVEMENTTUNING_H
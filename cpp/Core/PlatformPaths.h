@@ -0,0 +1,189 @@
+#ifndef PLATFORMPATHS_H
+#define PLATFORMPATHS_H
+
+#include "Collision.h"
+#include "SpatialGrid.h"
+#include "../include/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <vector>
+
+/**
+ * @class PlatformPaths
+ * @brief Moving platforms shuttling between two keyframes, one flat array per field.
+ *
+ * Every platform travels from its first keyframe to its second and back at a constant speed, so its position
+ * at any time is a closed-form lookup: the time's fraction of the way through the loop, folded into a
+ * triangle wave that scales the distance between the keys. Nothing is integrated, which keeps positions
+ * identical on every machine and lets a rollback or a replay ask for any tick directly.
+ *
+ * `Sample` updates every platform in one branch-free pass over float arrays that the compiler vectorizes
+ * with plain SSE2 at -O3, CMake's Release default; GCC 12 leaves it scalar at -O2. In game, `PlatformSystem`
+ * runs it once per physics tick. Collision code that only needs a few platforms uses `QueryPaths` to find
+ * the ones whose whole path comes near a box, then `SampleOne`.
+ */
+class PlatformPaths {
+public:
+    /**
+     * @brief Adds a platform.
+     *
+     * @param halfWidth Half of the platform's width.
+     * @param halfHeight Half of the platform's height.
+     * @param keys The x and y of the platform's keyframes (centre positions): one for a platform that stays
+     *             put, two for one that travels from the first to the second and back.
+     * @param secondsPerKey Time spent travelling from one keyframe to the other.
+     * @param phaseSeconds Time offset into the loop at time zero.
+     * @return The index of the platform.
+     */
+    std::uint32_t Add(float halfWidth, float halfHeight, std::span<const float> keys, float secondsPerKey,
+                      float phaseSeconds = 0.0f) {
+        const float fromX = keys[0];
+        const float fromY = keys[1];
+        const float toX = keys.size() >= 4 ? keys[2] : fromX;
+        const float toY = keys.size() >= 4 ? keys[3] : fromY;
+        halfWidths.push_back(halfWidth);
+        halfHeights.push_back(halfHeight);
+        originsX.push_back(fromX);
+        originsY.push_back(fromY);
+        extentsX.push_back(toX - fromX);
+        extentsY.push_back(toY - fromY);
+
+        // One loop is there and back again
+        const double loopSeconds = 2.0 * static_cast<double>(secondsPerKey);
+        const double phase = static_cast<double>(phaseSeconds) / loopSeconds;
+        loopsPerSecond.push_back(static_cast<float>(1.0 / loopSeconds));
+        phaseLoops.push_back(static_cast<float>(phase - std::floor(phase)));
+
+        pathBounds.push_back(Aabb{std::min(fromX, toX) - halfWidth, std::min(fromY, toY) - halfHeight,
+                                  std::max(fromX, toX) + halfWidth, std::max(fromY, toY) + halfHeight});
+        return static_cast<std::uint32_t>(halfWidths.size() - 1);
+    }
+
+    std::uint32_t GetCount() const { return static_cast<std::uint32_t>(halfWidths.size()); }
+
+    bool IsEmpty() const { return halfWidths.empty(); }
+
+    /**
+     * @brief Computes where every platform is at a time, in one pass over the path arrays.
+     *
+     * The loop has no branches, calls or gathers, so at -O3 the compiler vectorizes it for any x86-64 target.
+     *
+     * @param time The time in seconds, not negative. It is rounded to float, which keeps positions within a
+     *             few hundredths of a pixel for the first hours of a session.
+     * @param x Receives the centre X of every platform; at least `GetCount` long.
+     * @param y Receives the centre Y of every platform; at least `GetCount` long.
+     */
+    void Sample(double time, std::span<float> x, std::span<float> y) const {
+        PROFILE_ZONE("PlatformPaths::Sample");
+        SampleAll(halfWidths.size(), static_cast<float>(time), loopsPerSecond.data(), phaseLoops.data(),
+                  originsX.data(), originsY.data(), extentsX.data(), extentsY.data(), x.data(), y.data());
+    }
+
+    /**
+     * @brief Computes where one platform is at a time; matches `Sample` exactly.
+     */
+    void SampleOne(std::uint32_t index, double time, float &x, float &y) const {
+        const float along = Fold(static_cast<float>(time) * loopsPerSecond[index] + phaseLoops[index]);
+        x = originsX[index] + extentsX[index] * along;
+        y = originsY[index] + extentsY[index] * along;
+    }
+
+    /**
+     * @brief Gets a platform's box with its centre at the given position.
+     */
+    Aabb GetBox(std::uint32_t index, float x, float y) const {
+        return Aabb{x - halfWidths[index], y - halfHeights[index], x + halfWidths[index], y + halfHeights[index]};
+    }
+
+    /**
+     * @brief Gets the area a platform's box sweeps over its whole path.
+     */
+    const Aabb &GetPathBounds(std::uint32_t index) const { return pathBounds[index]; }
+
+    /**
+     * @brief Buckets the path bounds into a grid; call after adding platforms.
+     */
+    void BuildGrid(float cellSize) {
+        if (pathBounds.empty()) {
+            return;
+        }
+        Aabb bounds = pathBounds.front();
+        for (const Aabb &path: pathBounds) {
+            bounds = bounds.Merge(path);
+        }
+        pathGrid = SpatialGrid(bounds, cellSize);
+        for (std::size_t index = 0; index < pathBounds.size(); ++index) {
+            pathGrid.Insert(static_cast<std::uint32_t>(index), pathBounds[index]);
+        }
+    }
+
+    /**
+     * @brief Finds every platform whose path comes near a box, which is every platform that can touch it.
+     *
+     * @param query The box to test against.
+     * @param hits Receives the platform indices; cleared first.
+     * @return The number of platforms found.
+     */
+    std::size_t QueryPaths(const Aabb &query, std::vector<std::uint32_t> &hits) const {
+        if (pathBounds.empty()) {
+            hits.clear();
+            return 0;
+        }
+        return pathGrid.Query(query, hits);
+    }
+
+    /**
+     * @brief Stream insertion operator for the PlatformPaths class.
+     *
+     * @param os The output stream.
+     * @param paths The PlatformPaths instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const PlatformPaths &paths) {
+        os << "PlatformPaths(Platforms: " << paths.halfWidths.size() << ")";
+        return os;
+    }
+
+private:
+    /**
+     * @brief Folds a non-negative number of loops into how far along the path the platform is: 0 at the first
+     * key, 1 at the second.
+     *
+     * A triangle wave over the fraction of the loop. Truncating to an integer instead of calling `std::floor`
+     * keeps it inside the vectorized loop, and `std::fabs` only clears the sign bit.
+     */
+    static float Fold(float loops) {
+        const float fraction = loops - static_cast<float>(static_cast<std::int32_t>(loops));
+        return 1.0f - std::fabs(1.0f - 2.0f * fraction);
+    }
+
+    /**
+     * @brief The loop behind `Sample`; `restrict` tells the compiler the outputs never alias the paths.
+     */
+    static void SampleAll(std::size_t count, float time, const float *__restrict rates,
+                          const float *__restrict phases, const float *__restrict fromX,
+                          const float *__restrict fromY, const float *__restrict extentX,
+                          const float *__restrict extentY, float *__restrict outX, float *__restrict outY) {
+        for (std::size_t index = 0; index < count; ++index) {
+            const float along = Fold(time * rates[index] + phases[index]);
+            outX[index] = fromX[index] + extentX[index] * along;
+            outY[index] = fromY[index] + extentY[index] * along;
+        }
+    }
+
+    std::vector<float> halfWidths;
+    std::vector<float> halfHeights;
+    std::vector<float> originsX;       // Centre at the first keyframe
+    std::vector<float> originsY;
+    std::vector<float> extentsX;       // From the first keyframe to the second
+    std::vector<float> extentsY;
+    std::vector<float> loopsPerSecond;
+    std::vector<float> phaseLoops;     // Fraction of the loop done at time zero
+    std::vector<Aabb> pathBounds;
+    SpatialGrid pathGrid;
+};
+
+#endif // PLATFORMPATHS_H
@@ -0,0 +1,359 @@
+#ifndef PLAYERSIM_H
+#define PLAYERSIM_H
+
+#include "InputSnapshot.h"
+#include "MovementTuning.h"
+#include "SurfaceEffects.h"
+#include "SurfaceMaterial.h"
+#include "World.h"
+#include "../include/AllocationTracker.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/**
+ * @class PlayerSim
+ * @brief A deterministic, Godot-free model of `Player::_physics_process` used for headless replays.
+ *
+ * The movement rules are the same `MovementStep` instantiations the player uses. `move_and_slide` is replaced
+ * by an axis-separated sweep against the `World` boxes that its grid finds near the player, which is close
+ * enough to train and verify against and, unlike the physics server, bit-for-bit reproducible for a given binary.
+ */
+class PlayerSim {
+public:
+    /**
+     * @struct Snapshot
+     * @brief Everything `Step` reads or writes, copied out so a rollback can rewind the simulation.
+     */
+    struct Snapshot {
+        float positionX;
+        float positionY;
+        MovementState state;
+        bool onFloor;
+        bool onWall;
+        bool onCeiling;
+        std::int32_t ridingPlatform;
+        std::uint64_t ticks;
+        std::uint64_t stateHash;
+    };
+
+    /**
+     * @brief Half extents of the player's collision box.
+     */
+    static constexpr float HalfWidth = 8.0f;
+    static constexpr float HalfHeight = 16.0f;
+
+    /**
+     * @brief Places the player on the world's spawn point.
+     *
+     * @param world The level to simulate; must outlive the simulation.
+     * @param mode The movement mode, using the values of `Player::MovementMode`.
+     */
+    PlayerSim(const World &world, int mode)
+        : world(&world), mode(mode), positionX(world.spawnX), positionY(world.spawnY - HalfHeight) {
+        hits.reserve(world.solids.size());
+        platformHits.reserve(world.platforms.GetCount());
+    }
+
+    /**
+     * @brief Advances the simulation by one physics tick.
+     *
+     * @param input The input recorded for this tick.
+     */
+    void Step(InputSnapshot input) {
+        NO_ALLOCATION_SCOPE("PlayerSim::Step");
+        const float delta = MovementConstants::TickDelta;
+        const MovementInput movementInput = input.ToMovementInput(state.canJump);
+        const float runSpeed = state.velocityX;
+        switch (mode) {
+            case 1:
+                state = MovementStep<IceTuning>(state, movementInput, onFloor, delta);
+                break;
+            case 2:
+                state = MovementStep<LowGravityTuning>(state, movementInput, onFloor, delta);
+                break;
+            default:
+                state = MovementStep<NormalTuning>(state, movementInput, onFloor, delta);
+                break;
+        }
+
+        // Like the player, follow the material of the floor underfoot where it has one
+        if (onFloor && !world->surfaces.empty()) {
+            const Aabb feet{positionX - HalfWidth, positionY + HalfHeight, positionX + HalfWidth,
+                            positionY + HalfHeight + 1.0f};
+            if (const SurfaceMaterial *material = world->FindSurface(feet)) {
+                state = ApplyFloorMaterial(*material, runSpeed, state, movementInput, delta);
+            }
+        }
+
+        // Wind and updrafts accelerate the player on top of the movement rules
+        if (!world->wind.IsEmpty()) {
+            float forceX, forceY;
+            world->wind.SampleOne(positionX, positionY, forceX, forceY);
+            state.velocityX += forceX * delta;
+            state.velocityY += forceY * delta;
+        }
+
+        // A platform carries whoever stood on it last tick before they move on their own
+        const float startX = positionX;
+        const float startY = positionY;
+        if (ridingPlatform >= 0) {
+            const auto platform = static_cast<std::uint32_t>(ridingPlatform);
+            float fromX, fromY, toX, toY;
+            world->platforms.SampleOne(platform, GetTime(ticks), fromX, fromY);
+            world->platforms.SampleOne(platform, GetTime(ticks + 1), toX, toY);
+            MoveX(toX - fromX);
+            if (toY != fromY) {
+                MoveY(toY - fromY);
+            }
+        }
+
+        onWall = MoveX(state.velocityX * delta);
+        const float moveY = state.velocityY * delta;
+        const bool hitY = MoveY(moveY);
+        onFloor = hitY && moveY >= 0.0f;
+        onCeiling = hitY && moveY < 0.0f;
+        if (!world->platforms.IsEmpty()) {
+            CollidePlatforms(startX, startY);
+        }
+
+        // Same contact response as the player: stop pushing into walls, and into ceilings
+        if (onWall) {
+            state = ApplySurfaceEffect(WallEffect{state.velocityX > 0.0f ? -1.0f : 1.0f, 0.0f}, state);
+        }
+        if (onCeiling) {
+            state = ApplySurfaceEffect(WallEffect{0.0f, 1.0f}, state);
+        }
+
+        ++ticks;
+        for (const float value: {positionX, positionY, state.velocityX, state.velocityY}) {
+            stateHash = (stateHash ^ std::bit_cast<std::uint32_t>(value)) * 0x100000001B3ull;
+        }
+    }
+
+    /**
+     * @brief Copies the simulation state; a few dozen bytes, cheap enough to take every tick.
+     */
+    Snapshot Save() const {
+        return Snapshot{positionX, positionY, state, onFloor, onWall, onCeiling, ridingPlatform, ticks, stateHash};
+    }
+
+    /**
+     * @brief Rewinds the simulation to a state returned by `Save` on a simulation of the same world and mode.
+     */
+    void Restore(const Snapshot &snapshot) {
+        positionX = snapshot.positionX;
+        positionY = snapshot.positionY;
+        state = snapshot.state;
+        onFloor = snapshot.onFloor;
+        onWall = snapshot.onWall;
+        onCeiling = snapshot.onCeiling;
+        ridingPlatform = snapshot.ridingPlatform;
+        ticks = snapshot.ticks;
+        stateHash = snapshot.stateHash;
+    }
+
+    float GetPositionX() const { return positionX; }
+
+    float GetPositionY() const { return positionY; }
+
+    const MovementState &GetState() const { return state; }
+
+    bool IsOnFloor() const { return onFloor; }
+
+    bool IsOnWall() const { return onWall; }
+
+    bool IsOnCeiling() const { return onCeiling; }
+
+    /**
+     * @brief Gets the moving platform the player stands on, or -1.
+     */
+    std::int32_t GetRidingPlatform() const { return ridingPlatform; }
+
+    std::uint64_t GetTickCount() const { return ticks; }
+
+    /**
+     * @brief Gets a hash of the position and velocity after every tick so far.
+     *
+     * Two runs agree on the hash only if they agreed on every intermediate state.
+     */
+    std::uint64_t GetStateHash() const { return stateHash; }
+
+    /**
+     * @brief Gets the player's collision box at its current position.
+     */
+    Aabb GetBounds() const {
+        return Aabb{positionX - HalfWidth, positionY - HalfHeight, positionX + HalfWidth, positionY + HalfHeight};
+    }
+
+    /**
+     * @brief Stream insertion operator for the PlayerSim class.
+     *
+     * @param os The output stream.
+     * @param sim The PlayerSim instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const PlayerSim &sim) {
+        os << "PlayerSim(Position: (" << sim.positionX << ", " << sim.positionY << "), " << sim.state
+                << ", Ticks: " << sim.ticks << ")";
+        return os;
+    }
+
+private:
+    /**
+     * @brief Gets the time platforms are sampled at for a tick.
+     */
+    static double GetTime(std::uint64_t tick) {
+        return static_cast<double>(tick) * static_cast<double>(MovementConstants::TickDelta);
+    }
+
+    /**
+     * @brief Resolves this tick's movement against the moving platforms.
+     *
+     * Each nearby platform is swept in its own frame of reference: the player's displacement minus the
+     * platform's, from where both were at the start of the tick. The earliest contact wins, so a fast fall
+     * or a fast platform cannot tunnel through. The player then rides the platform to the end of the tick
+     * and keeps the part of the remaining motion along the contact surface. Landing on top makes the player
+     * ride that platform from the next tick on. Every correction goes through `MoveX` and `MoveY`, so a
+     * platform can push the player against a wall but never into it.
+     *
+     * @param startX The player's position at the start of the tick, before being carried.
+     * @param startY The player's position at the start of the tick, before being carried.
+     */
+    void CollidePlatforms(float startX, float startY) {
+        ridingPlatform = -1;
+        const Aabb start{startX - HalfWidth, startY - HalfHeight, startX + HalfWidth, startY + HalfHeight};
+        if (world->platforms.QueryPaths(start.Merge(GetBounds()).Expand(1.0f), platformHits) == 0) {
+            return;
+        }
+
+        const double from = GetTime(ticks);
+        const double to = GetTime(ticks + 1);
+        SweepHit best{1.0f, 0.0f, 0.0f};
+        float bestMoveX = 0.0f;
+        float bestMoveY = 0.0f;
+        std::int32_t bestPlatform = -1;
+        for (const std::uint32_t platform: platformHits) {
+            float fromX, fromY, toX, toY;
+            world->platforms.SampleOne(platform, from, fromX, fromY);
+            world->platforms.SampleOne(platform, to, toX, toY);
+            SweepHit hit{};
+            if (SweepAabb(start, positionX - startX - (toX - fromX), positionY - startY - (toY - fromY),
+                          world->platforms.GetBox(platform, fromX, fromY), hit) && hit.time < best.time) {
+                best = hit;
+                bestMoveX = toX - fromX;
+                bestMoveY = toY - fromY;
+                bestPlatform = static_cast<std::int32_t>(platform);
+            }
+        }
+
+        if (bestPlatform >= 0) {
+            const float relativeX = positionX - startX - bestMoveX;
+            const float relativeY = positionY - startY - bestMoveY;
+            const float slide = 1.0f - best.time;
+            const float targetX = startX + relativeX * best.time + bestMoveX +
+                                  (best.normalX == 0.0f ? relativeX * slide : 0.0f);
+            const float targetY = startY + relativeY * best.time + bestMoveY +
+                                  (best.normalY == 0.0f ? relativeY * slide : 0.0f);
+            MoveX(targetX - positionX);
+            MoveY(targetY - positionY);
+            onWall = onWall || best.normalX != 0.0f;
+            onFloor = onFloor || best.normalY < 0.0f;
+            onCeiling = onCeiling || best.normalY > 0.0f;
+            if (best.normalY < 0.0f) {
+                ridingPlatform = bestPlatform;
+            }
+        }
+
+        // Push out of platforms the player already overlapped, and keep riding the one underfoot
+        for (const std::uint32_t platform: platformHits) {
+            float x, y;
+            world->platforms.SampleOne(platform, to, x, y);
+            const Aabb box = world->platforms.GetBox(platform, x, y);
+            const Aabb bounds = GetBounds();
+            if (bounds.Overlaps(box)) {
+                const float pushUp = bounds.maxY - box.minY;
+                const float pushDown = box.maxY - bounds.minY;
+                const float pushLeft = bounds.maxX - box.minX;
+                const float pushRight = box.maxX - bounds.minX;
+                const float pushY = std::min(pushUp, pushDown);
+                if (std::min(pushLeft, pushRight) < pushY) {
+                    MoveX(pushLeft < pushRight ? -pushLeft : pushRight);
+                    onWall = true;
+                } else if (pushUp <= pushDown) {
+                    MoveY(-pushUp);
+                    onFloor = true;
+                    ridingPlatform = static_cast<std::int32_t>(platform);
+                } else {
+                    MoveY(pushDown);
+                    onCeiling = true;
+                }
+            } else if (ridingPlatform < 0 && bounds.maxY <= box.minY && bounds.maxY + 0.5f > box.minY &&
+                       bounds.maxX > box.minX && bounds.minX < box.maxX) {
+                // Resting on a platform still counts as touching it
+                onFloor = true;
+                ridingPlatform = static_cast<std::int32_t>(platform);
+            }
+        }
+    }
+
+    /**
+     * @brief Moves horizontally and pushes the player out of any box it ends up in.
+     *
+     * @return `true` if a box stopped the movement.
+     */
+    bool MoveX(float distance) {
+        positionX += distance;
+        if (distance == 0.0f || world->grid.Query(GetBounds(), hits) == 0) {
+            return false;
+        }
+        for (const std::uint32_t index: hits) {
+            const Aabb &solid = world->solids[index];
+            positionX = distance > 0.0f ? std::min(positionX, solid.minX - HalfWidth)
+                                        : std::max(positionX, solid.maxX + HalfWidth);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Moves vertically and pushes the player out of any box it ends up in.
+     *
+     * @return `true` if a box stopped the movement.
+     */
+    bool MoveY(float distance) {
+        positionY += distance;
+        if (distance == 0.0f) {
+            // Resting on a floor still counts as touching it
+            const Aabb probe{positionX - HalfWidth, positionY + HalfHeight, positionX + HalfWidth,
+                             positionY + HalfHeight + 0.5f};
+            return world->grid.Query(probe, hits) != 0;
+        }
+        if (world->grid.Query(GetBounds(), hits) == 0) {
+            return false;
+        }
+        for (const std::uint32_t index: hits) {
+            const Aabb &solid = world->solids[index];
+            positionY = distance > 0.0f ? std::min(positionY, solid.minY - HalfHeight)
+                                        : std::max(positionY, solid.maxY + HalfHeight);
+        }
+        return true;
+    }
+
+    const World *world;
+    int mode;
+    float positionX;
+    float positionY;
+    MovementState state{0.0f, 0.0f, true};
+    bool onFloor = false;
+    bool onWall = false;
+    bool onCeiling = false;
+    std::int32_t ridingPlatform = -1;
+    std::uint64_t ticks = 0;
+    std::uint64_t stateHash = 0xCBF29CE484222325ull;
+    std::vector<std::uint32_t> hits;
+    std::vector<std::uint32_t> platformHits;
+};
+
+#endif // PLAYERSIM_H
@@ -0,0 +1,349 @@
+#ifndef ROPES_H
+#define ROPES_H
+
+#include "Collision.h"
+#include "World.h"
+#include "../include/Counters.h"
+#include "../include/Profiler.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/**
+ * @class Ropes
+ * @brief Climbable ropes simulated as chains of Verlet points held together by distance constraints.
+ *
+ * Every rope has the same number of nodes, and ropes are packed eight to a batch. Inside a batch a node's
+ * eight ropes sit next to each other, so every pass works on all eight lanes at once: the integration is one
+ * flat loop over the batch, and each constraint along the chain is solved for the eight ropes together.
+ * Ropes never interact, so batches can be stepped on different threads (see `RopeSolver`).
+ *
+ * Node 0 of every rope is its anchor and never moves. A held node, such as the one the player hangs from,
+ * gets a lower inverse mass, so the rope bends around the player's weight instead of the other way round.
+ * Nodes are points: after the constraints they are pushed out of any solid of the level they ended up in.
+ */
+class Ropes {
+public:
+    /**
+     * @brief Ropes per batch; one SIMD register of floats on AVX.
+     */
+    static constexpr std::size_t Lanes = 8;
+
+    /**
+     * @brief Default number of constraint passes per step.
+     */
+    static constexpr int DefaultIterations = 16;
+
+    /**
+     * @brief Inverse mass of a free node; the anchor and padding lanes have zero.
+     */
+    static constexpr float NodeInverseMass = 1.0f;
+
+    /**
+     * @param nodesPerRope Nodes of every rope, anchor included; at least two.
+     * @param damping Fraction of the velocity kept per step.
+     */
+    explicit Ropes(std::size_t nodesPerRope = 64, float damping = 0.995f)
+        : nodes(std::max<std::size_t>(nodesPerRope, 2)), damping(damping) {
+    }
+
+    /**
+     * @brief Adds a rope hanging straight down from an anchor.
+     *
+     * @param anchorX The X of the fixed end.
+     * @param anchorY The Y of the fixed end.
+     * @param segmentLength The rest length between two neighbouring nodes.
+     * @return The index of the new rope.
+     */
+    std::size_t Add(float anchorX, float anchorY, float segmentLength) {
+        if (count % Lanes == 0) {
+            const std::size_t size = (count / Lanes + 1) * nodes * Lanes;
+            positionsX.resize(size, 0.0f);
+            positionsY.resize(size, 0.0f);
+            previousX.resize(size, 0.0f);
+            previousY.resize(size, 0.0f);
+            inverseMasses.resize(size, 0.0f);
+            restLengths.resize(size / nodes, 0.0f);
+        }
+        const std::size_t rope = count++;
+        restLengths[rope] = segmentLength;
+        for (std::size_t node = 0; node < nodes; ++node) {
+            const std::size_t index = Index(rope, node);
+            positionsX[index] = anchorX;
+            positionsY[index] = anchorY + static_cast<float>(node) * segmentLength;
+            previousX[index] = positionsX[index];
+            previousY[index] = positionsY[index];
+            inverseMasses[index] = node == 0 ? 0.0f : NodeInverseMass;
+        }
+        return rope;
+    }
+
+    /**
+     * @brief Removes every rope.
+     */
+    void Clear() {
+        count = 0;
+        positionsX.clear();
+        positionsY.clear();
+        previousX.clear();
+        previousY.clear();
+        inverseMasses.clear();
+        restLengths.clear();
+    }
+
+    /**
+     * @brief Advances every rope by one tick.
+     *
+     * @param delta The duration of the tick in seconds.
+     * @param gravity The downward acceleration in pixels per second squared.
+     * @param world The level whose solids the ropes rest against.
+     * @param iterations Constraint passes; more make the ropes stiffer.
+     */
+    void Step(float delta, float gravity, const World &world, int iterations = DefaultIterations) {
+        StepBatches(0, GetBatchCount(), delta, gravity, world, iterations);
+    }
+
+    /**
+     * @brief Advances a range of batches by one tick; disjoint ranges may run on different threads.
+     *
+     * @param first The first batch to step.
+     * @param last One past the last batch to step.
+     * @param delta The duration of the tick in seconds.
+     * @param gravity The downward acceleration in pixels per second squared.
+     * @param world The level whose solids the ropes rest against.
+     * @param iterations Constraint passes; more make the ropes stiffer.
+     */
+    void StepBatches(std::size_t first, std::size_t last, float delta, float gravity, const World &world,
+                     int iterations = DefaultIterations) {
+        PROFILE_ZONE("Ropes::StepBatches");
+        const std::size_t stride = nodes * Lanes;
+        std::uint64_t tests = 0;
+        for (std::size_t batch = first; batch < last; ++batch) {
+            const std::size_t start = batch * stride;
+            IntegrateAll(stride, damping, gravity * delta * delta, positionsX.data() + start,
+                         positionsY.data() + start, previousX.data() + start, previousY.data() + start,
+                         inverseMasses.data() + start);
+            for (int iteration = 0; iteration < iterations; ++iteration) {
+                for (std::size_t node = 1; node < nodes; ++node) {
+                    const std::size_t above = start + (node - 1) * Lanes;
+                    const std::size_t below = above + Lanes;
+                    SolveLanes(positionsX.data() + above, positionsY.data() + above, positionsX.data() + below,
+                               positionsY.data() + below, inverseMasses.data() + above,
+                               inverseMasses.data() + below, restLengths.data() + batch * Lanes);
+                }
+            }
+            tests += Collide(batch, world);
+        }
+        Counters::Add(Counter::CollisionTests, tests);
+    }
+
+    /**
+     * @brief Makes a node carry a weight, or frees it again with `NodeInverseMass`.
+     *
+     * @param rope The rope.
+     * @param node The node; the anchor cannot be changed.
+     * @param inverseMass The node's new inverse mass; lower is heavier.
+     */
+    void SetInverseMass(std::size_t rope, std::size_t node, float inverseMass) {
+        if (node > 0) {
+            inverseMasses[Index(rope, node)] = inverseMass;
+        }
+    }
+
+    /**
+     * @brief Moves a node without changing its velocity, such as the player climbing along the rope.
+     */
+    void SetNode(std::size_t rope, std::size_t node, float x, float y) {
+        const std::size_t index = Index(rope, node);
+        previousX[index] += x - positionsX[index];
+        previousY[index] += y - positionsY[index];
+        positionsX[index] = x;
+        positionsY[index] = y;
+    }
+
+    /**
+     * @brief Adds to a node's velocity, such as the player swinging.
+     *
+     * @param rope The rope.
+     * @param node The node.
+     * @param x The change in X velocity times the tick duration.
+     * @param y The change in Y velocity times the tick duration.
+     */
+    void Push(std::size_t rope, std::size_t node, float x, float y) {
+        const std::size_t index = Index(rope, node);
+        previousX[index] -= x;
+        previousY[index] -= y;
+    }
+
+    /**
+     * @brief Gets where a node is.
+     */
+    void GetNode(std::size_t rope, std::size_t node, float &x, float &y) const {
+        x = positionsX[Index(rope, node)];
+        y = positionsY[Index(rope, node)];
+    }
+
+    /**
+     * @brief Gets how far a node moved during the last step.
+     */
+    void GetMotion(std::size_t rope, std::size_t node, float &x, float &y) const {
+        const std::size_t index = Index(rope, node);
+        x = positionsX[index] - previousX[index];
+        y = positionsY[index] - previousY[index];
+    }
+
+    /**
+     * @brief Finds the node closest to a point, such as the player reaching for a rope.
+     *
+     * @param x The X of the point.
+     * @param y The Y of the point.
+     * @param radius How far from the point a node may be.
+     * @param rope Receives the rope of the closest node.
+     * @param node Receives the closest node; never an anchor.
+     * @return `false` if no node is within the radius.
+     */
+    bool FindNearest(float x, float y, float radius, std::size_t &rope, std::size_t &node) const {
+        float best = radius * radius;
+        bool found = false;
+        for (std::size_t candidate = 0; candidate < count; ++candidate) {
+            for (std::size_t index = 1; index < nodes; ++index) {
+                const float dx = positionsX[Index(candidate, index)] - x;
+                const float dy = positionsY[Index(candidate, index)] - y;
+                if (dx * dx + dy * dy < best) {
+                    best = dx * dx + dy * dy;
+                    rope = candidate;
+                    node = index;
+                    found = true;
+                }
+            }
+        }
+        return found;
+    }
+
+    std::size_t GetCount() const { return count; }
+
+    std::size_t GetNodesPerRope() const { return nodes; }
+
+    std::size_t GetBatchCount() const { return (count + Lanes - 1) / Lanes; }
+
+    float GetSegmentLength(std::size_t rope) const { return restLengths[rope]; }
+
+    /**
+     * @brief Stream insertion operator for the Ropes class.
+     *
+     * @param os The output stream.
+     * @param ropes The Ropes instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const Ropes &ropes) {
+        os << "Ropes(Count: " << ropes.count << ", NodesPerRope: " << ropes.nodes << ", Batches: "
+                << ropes.GetBatchCount() << ")";
+        return os;
+    }
+
+private:
+    /**
+     * @brief Gets where a node of a rope is stored.
+     */
+    std::size_t Index(std::size_t rope, std::size_t node) const {
+        return ((rope / Lanes) * nodes + node) * Lanes + rope % Lanes;
+    }
+
+    /**
+     * @brief The Verlet step over one batch; nodes with no inverse mass stay put.
+     */
+    static void IntegrateAll(std::size_t count, float damping, float fall, float *__restrict x,
+                             float *__restrict y, float *__restrict lastX, float *__restrict lastY,
+                             const float *__restrict inverseMass) {
+        for (std::size_t index = 0; index < count; ++index) {
+            const float moving = static_cast<float>(inverseMass[index] > 0.0f);
+            const float stepX = (x[index] - lastX[index]) * damping * moving;
+            const float stepY = ((y[index] - lastY[index]) * damping + fall) * moving;
+            lastX[index] = x[index];
+            lastY[index] = y[index];
+            x[index] += stepX;
+            y[index] += stepY;
+        }
+    }
+
+    /**
+     * @brief Restores the length of one segment of every rope in a batch.
+     *
+     * The two ends move in proportion to their inverse masses; a segment between two fixed nodes, like the
+     * padding lanes of the last batch, does not move at all. The stretch `(d - r) / d` is replaced by its
+     * first-order expansion around the rest length, `(d² - r²) / (d² + r²)`, which needs no square root; a
+     * `std::sqrt` here would keep the loop scalar, since it may set `errno`. The passes converge all the same.
+     */
+    static void SolveLanes(float *__restrict aboveX, float *__restrict aboveY, float *__restrict belowX,
+                           float *__restrict belowY, const float *__restrict aboveMass,
+                           const float *__restrict belowMass, const float *__restrict rest) {
+        for (std::size_t lane = 0; lane < Lanes; ++lane) {
+            const float dx = belowX[lane] - aboveX[lane];
+            const float dy = belowY[lane] - aboveY[lane];
+            const float squared = dx * dx + dy * dy;
+            const float restSquared = rest[lane] * rest[lane];
+            const float weight = std::max(aboveMass[lane] + belowMass[lane], 1e-6f);
+            const float scale = (squared - restSquared) / ((squared + restSquared + 1e-6f) * weight);
+            aboveX[lane] += dx * scale * aboveMass[lane];
+            aboveY[lane] += dy * scale * aboveMass[lane];
+            belowX[lane] -= dx * scale * belowMass[lane];
+            belowY[lane] -= dy * scale * belowMass[lane];
+        }
+    }
+
+    /**
+     * @brief Pushes every moving node of a batch out of the solids it is inside, along the shortest way out.
+     *
+     * The node's velocity into the solid is cancelled as well, so ropes come to rest on ledges.
+     *
+     * @return The number of solids tested, for the caller to add to the counters once.
+     */
+    std::uint64_t Collide(std::size_t batch, const World &world) {
+        std::uint64_t tests = 0;
+        const std::size_t lanes = std::min(Lanes, count - batch * Lanes);
+        for (std::size_t node = 1; node < nodes; ++node) {
+            for (std::size_t lane = 0; lane < lanes; ++lane) {
+                const std::size_t index = (batch * nodes + node) * Lanes + lane;
+                float &x = positionsX[index];
+                float &y = positionsY[index];
+                const CellRange cells = world.grid.GetCells(Aabb{x, y, x, y});
+                for (int row = cells.minRow; row <= cells.maxRow; ++row) {
+                    for (int column = cells.minColumn; column <= cells.maxColumn; ++column) {
+                        for (const std::uint32_t id: world.grid.GetCell(column, row)) {
+                            ++tests;
+                            const Aabb &solid = world.solids[id];
+                            if (!solid.Contains(x, y)) {
+                                continue;
+                            }
+                            const float left = x - solid.minX;
+                            const float right = solid.maxX - x;
+                            const float up = y - solid.minY;
+                            const float down = solid.maxY - y;
+                            if (std::min(left, right) < std::min(up, down)) {
+                                x = left < right ? solid.minX : solid.maxX;
+                                previousX[index] = x;
+                            } else {
+                                y = up < down ? solid.minY : solid.maxY;
+                                previousY[index] = y;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        return tests;
+    }
+
+    std::size_t nodes;
+    float damping;
+    std::size_t count = 0;
+    std::vector<float> positionsX;    // Batch by batch, node by node, rope by rope
+    std::vector<float> positionsY;
+    std::vector<float> previousX;     // Positions before the last step; the difference is the velocity
+    std::vector<float> previousY;
+    std::vector<float> inverseMasses; // Zero for anchors and padding lanes
+    std::vector<float> restLengths;   // One per lane
+};
+
+#endif // ROPES_H
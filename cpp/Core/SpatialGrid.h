@@ -0,0 +1,224 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "Collision.h"
+#include "../include/AllocationTracker.h"
+#include "../include/Counters.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/**
+ * @struct CellRange
+ * @brief An inclusive rectangle of grid cells.
+ */
+struct CellRange {
+    int minColumn;
+    int minRow;
+    int maxColumn;
+    int maxRow;
+
+    constexpr bool Contains(int column, int row) const {
+        return column >= minColumn && column <= maxColumn && row >= minRow && row <= maxRow;
+    }
+
+    friend constexpr bool operator==(const CellRange &, const CellRange &) = default;
+};
+
+/**
+ * @class SpatialGrid
+ * @brief A uniform grid of cells over a fixed area, each listing the boxes that overlap it.
+ *
+ * Towers are narrow and tall, so a dense grid sized to the level answers "what is near this box" by looking
+ * at a handful of cells instead of every box. Boxes outside the area are clamped into the border cells.
+ * Entries are addressed by a caller-chosen dense id; moving a box only touches the cells it left or entered.
+ */
+class SpatialGrid {
+public:
+    SpatialGrid() = default;
+
+    /**
+     * @param bounds The area the cells cover.
+     * @param cellSize The edge length of a square cell.
+     */
+    SpatialGrid(const Aabb &bounds, float cellSize)
+        : bounds(bounds), cellSize(cellSize), inverseCellSize(1.0f / cellSize),
+          columns(std::max(1, static_cast<int>((bounds.maxX - bounds.minX) * inverseCellSize) + 1)),
+          rows(std::max(1, static_cast<int>((bounds.maxY - bounds.minY) * inverseCellSize) + 1)),
+          cells(static_cast<std::size_t>(columns) * static_cast<std::size_t>(rows)) {
+    }
+
+    /**
+     * @brief Gets the cells a box overlaps, clamped to the grid.
+     */
+    CellRange GetCells(const Aabb &box) const {
+        return CellRange{ColumnOf(box.minX), RowOf(box.minY), ColumnOf(box.maxX), RowOf(box.maxY)};
+    }
+
+    /**
+     * @brief Adds a box, or moves it if the id is already present.
+     */
+    void Insert(std::uint32_t id, const Aabb &box) {
+        if (id >= entries.size()) {
+            entries.resize(id + 1);
+        }
+        if (entries[id].present) {
+            Update(id, box);
+            return;
+        }
+        entries[id] = Entry{box, GetCells(box), true};
+        AddToCells(id, entries[id].cells);
+    }
+
+    /**
+     * @brief Moves a box; only the cells it left or entered are touched.
+     */
+    void Update(std::uint32_t id, const Aabb &box) {
+        Entry &entry = entries[id];
+        entry.box = box;
+        const CellRange next = GetCells(box);
+        if (next == entry.cells) {
+            return;
+        }
+        RemoveFromCells(id, entry.cells, next);
+        const CellRange previous = entry.cells;
+        entry.cells = next;
+        for (int row = next.minRow; row <= next.maxRow; ++row) {
+            for (int column = next.minColumn; column <= next.maxColumn; ++column) {
+                if (!previous.Contains(column, row)) {
+                    Cell(column, row).push_back(id);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Removes a box.
+     */
+    void Remove(std::uint32_t id) {
+        if (id >= entries.size() || !entries[id].present) {
+            return;
+        }
+        RemoveFromCells(id, entries[id].cells, CellRange{0, 0, -1, -1});
+        entries[id].present = false;
+    }
+
+    bool Contains(std::uint32_t id) const { return id < entries.size() && entries[id].present; }
+
+    const Aabb &GetBounds(std::uint32_t id) const { return entries[id].box; }
+
+    /**
+     * @brief Gets one past the largest id ever inserted.
+     */
+    std::uint32_t GetIdLimit() const { return static_cast<std::uint32_t>(entries.size()); }
+
+    /**
+     * @brief Gets the ids listed in one cell.
+     */
+    const std::vector<std::uint32_t> &GetCell(int column, int row) const { return cells[Index(column, row)]; }
+
+    /**
+     * @brief Finds every box that overlaps the query, looking only at the cells the query covers.
+     *
+     * A box spanning several cells is reported once: only by the cell holding the top-left corner of its
+     * overlap with the query. Reserve `hits` up front; the query runs in a no-allocation scope.
+     *
+     * @param query The box to test against.
+     * @param hits Receives the ids of the overlapping boxes; cleared first.
+     * @return The number of overlapping boxes.
+     */
+    std::size_t Query(const Aabb &query, std::vector<std::uint32_t> &hits) const {
+        NO_ALLOCATION_SCOPE("SpatialGrid::Query");
+        hits.clear();
+        const CellRange range = GetCells(query);
+        std::uint64_t candidates = 0;
+        for (int row = range.minRow; row <= range.maxRow; ++row) {
+            for (int column = range.minColumn; column <= range.maxColumn; ++column) {
+                const std::vector<std::uint32_t> &cell = GetCell(column, row);
+                candidates += cell.size();
+                for (const std::uint32_t id: cell) {
+                    const Aabb &box = entries[id].box;
+                    if (box.Overlaps(query) && ColumnOf(std::max(box.minX, query.minX)) == column &&
+                        RowOf(std::max(box.minY, query.minY)) == row) {
+                        hits.push_back(id);
+                    }
+                }
+            }
+        }
+        Counters::AddDeferred(Counter::BroadphaseCandidates, candidates);
+        Counters::AddDeferred(Counter::CollisionTests, candidates);
+        return hits.size();
+    }
+
+    /**
+     * @brief Stream insertion operator for the SpatialGrid class.
+     *
+     * @param os The output stream.
+     * @param grid The SpatialGrid instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const SpatialGrid &grid) {
+        os << "SpatialGrid(Cells: " << grid.columns << "x" << grid.rows << ", CellSize: " << grid.cellSize
+                << ", " << grid.bounds << ")";
+        return os;
+    }
+
+private:
+    struct Entry {
+        Aabb box{};
+        CellRange cells{0, 0, -1, -1};
+        bool present = false;
+    };
+
+    int ColumnOf(float x) const {
+        return std::clamp(static_cast<int>((x - bounds.minX) * inverseCellSize), 0, columns - 1);
+    }
+
+    int RowOf(float y) const {
+        return std::clamp(static_cast<int>((y - bounds.minY) * inverseCellSize), 0, rows - 1);
+    }
+
+    std::size_t Index(int column, int row) const {
+        return static_cast<std::size_t>(row) * static_cast<std::size_t>(columns) + static_cast<std::size_t>(column);
+    }
+
+    std::vector<std::uint32_t> &Cell(int column, int row) { return cells[Index(column, row)]; }
+
+    void AddToCells(std::uint32_t id, const CellRange &range) {
+        for (int row = range.minRow; row <= range.maxRow; ++row) {
+            for (int column = range.minColumn; column <= range.maxColumn; ++column) {
+                Cell(column, row).push_back(id);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes the id from the cells of `range` that `keep` does not cover.
+     */
+    void RemoveFromCells(std::uint32_t id, const CellRange &range, const CellRange &keep) {
+        for (int row = range.minRow; row <= range.maxRow; ++row) {
+            for (int column = range.minColumn; column <= range.maxColumn; ++column) {
+                if (keep.Contains(column, row)) {
+                    continue;
+                }
+                std::vector<std::uint32_t> &cell = Cell(column, row);
+                const auto found = std::find(cell.begin(), cell.end(), id);
+                if (found != cell.end()) {
+                    *found = cell.back();
+                    cell.pop_back();
+                }
+            }
+        }
+    }
+
+    Aabb bounds{0.0f, 0.0f, 0.0f, 0.0f};
+    float cellSize = 1.0f;
+    float inverseCellSize = 1.0f;
+    int columns = 1;
+    int rows = 1;
+    std::vector<std::vector<std::uint32_t> > cells{1};
+    std::vector<Entry> entries;
+};
+
+#endif // SPATIALGRID_H
@@ -0,0 +1,111 @@
+#ifndef SURFACEEFFECTS_H
+#define SURFACEEFFECTS_H
+
+#include "MovementTuning.h"
+#include "../include/Profiler.h"
+#include <iostream>
+#include <span>
+#include <variant>
+
+/**
+ * @struct NoEffect
+ * @brief A surface that leaves the player's movement untouched.
+ */
+struct NoEffect {
+    /**
+     * @brief Returns the state unchanged.
+     */
+    MovementState Apply(MovementState state) const { return state; }
+
+    /**
+     * @brief Stream insertion operator for the NoEffect struct.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const NoEffect &) {
+        os << "NoEffect()";
+        return os;
+    }
+};
+
+/**
+ * @struct WallEffect
+ * @brief A solid wall contact that removes the part of the velocity pushing into the wall.
+ */
+struct WallEffect {
+    /**
+     * @brief X component of the unit contact normal, pointing away from the wall.
+     */
+    float normalX;
+
+    /**
+     * @brief Y component of the unit contact normal, pointing away from the wall.
+     */
+    float normalY;
+
+    /**
+     * @brief Cancels the velocity component along the normal if it points into the wall.
+     */
+    MovementState Apply(MovementState state) const {
+        const float into = state.velocityX * normalX + state.velocityY * normalY;
+        const float correction = into < 0.0f ? into : 0.0f;
+        state.velocityX -= correction * normalX;
+        state.velocityY -= correction * normalY;
+        return state;
+    }
+
+    /**
+     * @brief Stream insertion operator for the WallEffect struct.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const WallEffect &effect) {
+        os << "WallEffect(Normal: (" << effect.normalX << ", " << effect.normalY << "))";
+        return os;
+    }
+};
+
+/**
+ * @brief The closed set of effects a surface contact can have on the player.
+ *
+ * Dispatch goes through `std::visit`, so applying an effect costs a jump table instead of a virtual call
+ * or a `ClassDB` lookup. `SurfaceBinding` hands out these values for the bodies the Godot-bound `EnvironmentElement`,
+ * `Ice` and `Walls` classes are attached to; how slippery a surface is underfoot is its `SurfaceMaterial`.
+ */
+using SurfaceEffect = std::variant<NoEffect, WallEffect>;
+
+/**
+ * @brief Stream insertion operator for the SurfaceEffect variant.
+ *
+ * @param os The output stream.
+ * @param effect The effect to output.
+ * @return A reference to the updated output stream.
+ */
+inline std::ostream &operator<<(std::ostream &os, const SurfaceEffect &effect) {
+    std::visit([&os](const auto &alternative) { os << alternative; }, effect);
+    return os;
+}
+
+/**
+ * @brief Applies a single surface effect to the movement state.
+ *
+ * @param effect The effect of the surface being touched.
+ * @param state The state to modify.
+ * @return The state after the effect.
+ */
+inline MovementState ApplySurfaceEffect(const SurfaceEffect &effect, MovementState state) {
+    return std::visit([state](const auto &alternative) { return alternative.Apply(state); }, effect);
+}
+
+/**
+ * @brief Applies the effects of every surface touched during a tick, in contact order.
+ *
+ * @param effects The effects of the touched surfaces.
+ * @param state The state to modify.
+ * @return The state after all effects.
+ */
+inline MovementState ApplySurfaceEffects(std::span<const SurfaceEffect> effects, MovementState state) {
+    PROFILE_ZONE("SurfaceEffects::Apply");
+    for (const SurfaceEffect &effect: effects) {
+        state = ApplySurfaceEffect(effect, state);
+    }
+    return state;
+}
+
+#endif // SURFACEEFFECTS_H
@@ -0,0 +1,216 @@
+#ifndef SURFACEMATERIAL_H
+#define SURFACEMATERIAL_H
+
+#include "MovementConstants.h"
+#include "MovementTuning.h"
+#include "../include/Profiler.h"
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <span>
+
+/**
+ * @struct SurfaceMotion
+ * @brief Where one tick of surface movement leaves an agent.
+ */
+struct SurfaceMotion {
+    float velocity;
+    float displacement;
+};
+
+/**
+ * @struct SurfaceResponse
+ * @brief A material's movement over one step of a fixed length, reduced to four factors per case.
+ *
+ * Produced by `SurfaceMaterial::GetResponse`; the exponentials are paid once per material and step length,
+ * so stepping an agent is a handful of multiply-adds and selects.
+ */
+struct SurfaceResponse {
+    float maxSpeed;
+    float driveKeep;  // Fraction of the gap to the target speed left after the step while driving
+    float driveGain;  // Displacement per unit of that gap while driving, in seconds
+    float coastKeep;  // Fraction of the speed left after the step while coasting
+    float coastGain;  // Displacement per unit of speed while coasting, in seconds
+    float delta;
+
+    /**
+     * @brief Advances one agent by the step.
+     *
+     * @param velocity The speed along the surface at the start of the step.
+     * @param direction The held direction: -1, 0 or 1.
+     * @return The speed at the end of the step and the distance covered during it.
+     */
+    SurfaceMotion Step(float velocity, float direction) const {
+        const bool drives = direction != 0.0f;
+        const float target = direction * maxSpeed;
+        const float gap = velocity - target;
+        const float keep = drives ? driveKeep : coastKeep;
+        const float gain = drives ? driveGain : coastGain;
+        return SurfaceMotion{target + gap * keep, target * delta + gap * gain};
+    }
+
+    /**
+     * @brief Advances many agents by one step, each on its own material.
+     *
+     * Agents are stored one array per field. The loop has no branches or calls, so the compiler can vectorize
+     * it, and the factors are looked up per agent, so a mix of materials costs the same as a single one.
+     *
+     * @param responses The factors of every material, all from `SurfaceMaterial::GetResponse` with one delta.
+     * @param materials The index into `responses` of each agent's material.
+     * @param directions The held direction of each agent: -1, 0 or 1.
+     * @param velocities The speed of each agent; advanced in place.
+     * @param displacements Receives the distance each agent covers during the step.
+     */
+    static void StepBatch(std::span<const SurfaceResponse> responses, std::span<const std::uint8_t> materials,
+                          std::span<const float> directions, std::span<float> velocities,
+                          std::span<float> displacements) {
+        PROFILE_ZONE("SurfaceResponse::StepBatch");
+        StepAll(velocities.size(), responses.data(), materials.data(), directions.data(), velocities.data(),
+                displacements.data());
+    }
+
+private:
+    /**
+     * @brief The loop behind `StepBatch`; `restrict` tells the compiler the lookups never read what it writes.
+     */
+    static void StepAll(std::size_t count, const SurfaceResponse *__restrict table,
+                        const std::uint8_t *__restrict materials, const float *__restrict directions,
+                        float *__restrict velocities, float *__restrict displacements) {
+        for (std::size_t agent = 0; agent < count; ++agent) {
+            const SurfaceMotion motion = table[materials[agent]].Step(velocities[agent], directions[agent]);
+            velocities[agent] = motion.velocity;
+            displacements[agent] = motion.displacement;
+        }
+    }
+};
+
+/**
+ * @brief Which of the level's materials a surface is made of, such as for telemetry.
+ */
+enum class SurfaceMaterialId : std::uint8_t {
+    None = 0, // No material: in the air, or on a body without one
+    Ground = 1,
+    Ice = 2,
+};
+
+/**
+ * @struct SurfaceMaterial
+ * @brief How a surface accelerates, slows and caps whoever moves along it.
+ *
+ * Holding a direction pulls the speed towards `maxSpeed` in that direction, starting at `acceleration` from
+ * standstill and easing off as the gap closes; letting go bleeds the speed off at `friction`. Both are first
+ * order, `dv/dt = rate * (target - v)`, so one step of any length is solved exactly:
+ * `v' = target + (v - target) * e^(-rate * dt)`, and the distance is its integral. Two half steps land
+ * where one full step does, which lets the physics run at a lower tick rate without the surface feeling
+ * different.
+ */
+struct SurfaceMaterial {
+    /**
+     * @brief Acceleration from standstill while a direction is held, in pixels per second squared.
+     */
+    float acceleration;
+
+    /**
+     * @brief Rate at which the speed decays while no direction is held, per second; 0 never stops.
+     */
+    float friction;
+
+    /**
+     * @brief Speed approached while a direction is held, in pixels per second.
+     */
+    float maxSpeed;
+
+    /**
+     * @brief The level material this one is, or was tuned from.
+     */
+    SurfaceMaterialId id = SurfaceMaterialId::None;
+
+    /**
+     * @brief Precomputes this material's movement over steps of one length.
+     *
+     * @param delta The step length in seconds.
+     * @return The factors `SurfaceResponse::Step` and `SurfaceResponse::StepBatch` apply.
+     */
+    SurfaceResponse GetResponse(float delta) const {
+        const auto [driveKeep, driveGain] = Decay(maxSpeed > 0.0f ? acceleration / maxSpeed : 0.0f, delta);
+        const auto [coastKeep, coastGain] = Decay(friction, delta);
+        return SurfaceResponse{maxSpeed, driveKeep, driveGain, coastKeep, coastGain, delta};
+    }
+
+    /**
+     * @brief Advances one agent by one step; use `GetResponse` once instead when stepping many.
+     */
+    SurfaceMotion Step(float velocity, float direction, float delta) const {
+        return GetResponse(delta).Step(velocity, direction);
+    }
+
+    /**
+     * @brief Stream insertion operator for the SurfaceMaterial struct.
+     *
+     * @param os The output stream.
+     * @param material The SurfaceMaterial instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const SurfaceMaterial &material) {
+        os << "SurfaceMaterial(Acceleration: " << material.acceleration << ", Friction: " << material.friction
+                << ", MaxSpeed: " << material.maxSpeed << ")";
+        return os;
+    }
+
+private:
+    struct DecayFactors {
+        float keep;
+        float gain;
+    };
+
+    /**
+     * @brief Solves `dv/dt = -rate * v` over a step: the fraction kept and the integral of that fraction.
+     */
+    static DecayFactors Decay(float rate, float delta) {
+        if (rate <= 0.0f) {
+            return DecayFactors{1.0f, delta};
+        }
+        const double lost = -std::expm1(-static_cast<double>(rate) * static_cast<double>(delta));
+        return DecayFactors{static_cast<float>(1.0 - lost), static_cast<float>(lost / static_cast<double>(rate))};
+    }
+};
+
+/**
+ * @struct SurfaceMaterials
+ * @brief The materials the levels are built from.
+ */
+struct SurfaceMaterials {
+    /**
+     * @brief Firm ground: full speed within a few ticks, stops within a few more.
+     */
+    static constexpr SurfaceMaterial Ground{3000.0f, 30.0f, MovementConstants::HorizontalSpeed,
+                                            SurfaceMaterialId::Ground};
+
+    /**
+     * @brief Ice: slow to get going and slower to stop, but half again as fast once moving.
+     */
+    static constexpr SurfaceMaterial Ice{150.0f, 0.5f, MovementConstants::HorizontalSpeed * 1.5f,
+                                         SurfaceMaterialId::Ice};
+};
+
+/**
+ * @brief Lets the material underfoot set the running speed of one movement step.
+ *
+ * The movement rules still decide gravity and jumping. The running speed is stepped from its value before the
+ * rules ran, so the mode's traction is replaced by the material's instead of applying on top of it.
+ *
+ * @param material The material of the floor the agent stands on.
+ * @param velocityX The running speed before the movement step.
+ * @param state The state the movement step produced.
+ * @param input The input of the step.
+ * @param delta The step length in seconds.
+ * @return The state with the running speed the material gives.
+ */
+inline MovementState ApplyFloorMaterial(const SurfaceMaterial &material, float velocityX, MovementState state,
+                                        MovementInput input, float delta) {
+    const float direction = static_cast<float>(input.right) - static_cast<float>(input.left && !input.right);
+    state.velocityX = material.Step(velocityX, direction, delta).velocity;
+    return state;
+}
+
+#endif // SURFACEMATERIAL_H
@@ -0,0 +1,100 @@
+#ifndef SURFACETABLE_H
+#define SURFACETABLE_H
+
+#include "SurfaceEffects.h"
+#include "SurfaceMaterial.h"
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
+
+/**
+ * @brief How touching a surface changes the player's velocity, independent of the contact normal.
+ */
+enum class SurfaceKind : std::uint8_t {
+    Plain, // Leaves the velocity untouched
+    Wall,  // Stops the player pushing into it
+};
+
+/**
+ * @struct SurfaceBinding
+ * @brief What a physics body is made of, resolved once so contacts only look it up.
+ */
+struct SurfaceBinding {
+    SurfaceKind kind = SurfaceKind::Wall;
+    SurfaceMaterial material = SurfaceMaterials::Ground;
+
+    /**
+     * @brief Gets the effect of one contact with the surface.
+     *
+     * @param normalX X component of the contact normal, pointing away from the surface.
+     * @param normalY Y component of the contact normal, pointing away from the surface.
+     * @return The effect to apply with `ApplySurfaceEffect`.
+     */
+    SurfaceEffect GetEffect(float normalX, float normalY) const {
+        switch (kind) {
+            case SurfaceKind::Plain:
+                return NoEffect{};
+            default:
+                return WallEffect{normalX, normalY};
+        }
+    }
+
+    /**
+     * @brief Stream insertion operator for the SurfaceBinding struct.
+     *
+     * @param os The output stream.
+     * @param binding The SurfaceBinding instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const SurfaceBinding &binding) {
+        os << "SurfaceBinding(Kind: " << (binding.kind == SurfaceKind::Plain ? "Plain" : "Wall") << ", "
+                << binding.material << ")";
+        return os;
+    }
+};
+
+/**
+ * @class SurfaceTable
+ * @brief The surface of every bound physics body, keyed by the body's instance id.
+ *
+ * Bodies are bound when the element they are made of is attached to them and unbound when they leave the
+ * tree, so the collision response costs one hash lookup per contact instead of metadata and class lookups.
+ */
+class SurfaceTable {
+public:
+    /**
+     * @brief Binds a body to a surface, replacing any earlier binding.
+     *
+     * @param body The body's instance id.
+     * @param binding The surface it is made of.
+     */
+    void Bind(std::uint64_t body, const SurfaceBinding &binding) { bindings[body] = binding; }
+
+    /**
+     * @brief Forgets a body.
+     *
+     * @param body The body's instance id.
+     */
+    void Unbind(std::uint64_t body) { bindings.erase(body); }
+
+    /**
+     * @brief Gets the surface a body is made of.
+     *
+     * @param body The body's instance id.
+     * @return The binding, or null if the body is not bound.
+     */
+    const SurfaceBinding *Find(std::uint64_t body) const {
+        const auto found = bindings.find(body);
+        return found != bindings.end() ? &found->second : nullptr;
+    }
+
+    /**
+     * @brief Gets the number of bound bodies.
+     */
+    std::size_t GetCount() const { return bindings.size(); }
+
+private:
+    std::unordered_map<std::uint64_t, SurfaceBinding> bindings;
+};
+
+#endif // SURFACETABLE_H
@@ -0,0 +1,370 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "Collision.h"
+#include "ForceField.h"
+#include "MovementConstants.h"
+#include "PlatformPaths.h"
+#include "SpatialGrid.h"
+#include "SurfaceMaterial.h"
+#include "../include/Profiler.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+/**
+ * @struct SurfaceZone
+ * @brief An area whose floors are made of a material other than the movement mode's own.
+ */
+struct SurfaceZone {
+    Aabb area;
+    SurfaceMaterial material;
+};
+
+/**
+ * @struct World
+ * @brief The static collision geometry of a level, independent of the Godot scene.
+ *
+ * Headless tools (replays, benchmarks, the replay verifier) simulate against this instead of the physics
+ * server, so a level id is enough to rebuild the exact geometry a recording was made on.
+ */
+struct World {
+    /**
+     * @brief Width of the tower shaft between the two side walls.
+     */
+    static constexpr float ShaftWidth = 320.0f;
+
+    /**
+     * @brief Vertical distance between two platform rows.
+     */
+    static constexpr float RowHeight = 64.0f;
+
+    /**
+     * @brief Edge length of a collision grid cell; one platform row.
+     */
+    static constexpr float GridCellSize = RowHeight;
+
+    /**
+     * @brief Height of one segment of the side walls; walls are stacks of these so they can be carved cheaply.
+     */
+    static constexpr float WallSegmentHeight = RowHeight;
+
+    /**
+     * @brief What a removed solid's slot holds until it is reused; it overlaps and contains nothing.
+     */
+    static constexpr Aabb RemovedSolid{
+        std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()
+    };
+
+    /**
+     * @brief Level id bit selecting the variant of a tower with moving platforms.
+     */
+    static constexpr std::uint32_t MovingBit = 8;
+
+    /**
+     * @brief Level id bit selecting the variant of a tower whose top quarter is a storm.
+     */
+    static constexpr std::uint32_t StormBit = 16;
+
+    /**
+     * @brief Level id bit selecting the variant of a tower with icy ledges.
+     */
+    static constexpr std::uint32_t IceBit = 32;
+
+    /**
+     * @brief Distance between the nodes of the wind grid; half a platform row.
+     */
+    static constexpr float WindCellSize = RowHeight * 0.5f;
+
+    /**
+     * @brief The solid boxes of the level.
+     */
+    std::vector<Aabb> solids;
+
+    /**
+     * @brief The solids bucketed by position, indexed like `solids`.
+     */
+    SpatialGrid grid;
+
+    /**
+     * @brief Slots of `solids` freed by `RemoveSolid`, reused by `AddSolid`.
+     */
+    std::vector<std::uint32_t> freeSolids;
+
+    /**
+     * @brief The union of every solid changed since the last `TakeDirtyRegion`; only valid if `dirty` is set.
+     */
+    Aabb dirtyRegion{0.0f, 0.0f, 0.0f, 0.0f};
+    bool dirty = false;
+
+    /**
+     * @brief Scratch list of the solids `Carve` cuts, kept to avoid allocating per carve.
+     */
+    std::vector<std::uint32_t> carved;
+
+    /**
+     * @brief The moving platforms of the level.
+     */
+    PlatformPaths platforms;
+
+    /**
+     * @brief The wind and updraft zones of the level.
+     */
+    ForceField wind{WindCellSize};
+
+    /**
+     * @brief The areas whose floors are made of a material, such as icy ledges.
+     */
+    std::vector<SurfaceZone> surfaces;
+
+    /**
+     * @brief Where the player's feet start.
+     */
+    float spawnX = 0.0f;
+    float spawnY = 0.0f;
+
+    /**
+     * @brief Builds one of the procedurally generated tower levels.
+     *
+     * The tower has a floor, two side walls and one platform per row whose width and position are derived
+     * from `levelId`, so the same id always produces the same level on every machine. Ids with `MovingBit`
+     * set turn every fourth platform into one that sweeps across the shaft, every eighth one bobbing as it goes.
+     * Ids with `StormBit` set fill the top quarter with overlapping gusts blowing across the shaft, alternating
+     * in direction, and narrow updrafts that lift the player a little faster than gravity pulls. Ids with `IceBit`
+     * set make every third static platform an icy ledge.
+     *
+     * The walls are stacks of `WallSegmentHeight` segments, so carving through one only touches the segments
+     * around the hole. Segments meet edge to edge, which collides exactly like one tall box.
+     *
+     * @param levelId The level to build.
+     * @return The level geometry.
+     */
+    static World MakeTower(std::uint32_t levelId) {
+        World world;
+        const int rows = 32 + static_cast<int>(levelId % 4u) * 32;
+        world.solids.reserve(static_cast<std::size_t>(rows) * 3 + 3);
+
+        world.solids.push_back(Aabb{-32.0f, 0.0f, ShaftWidth + 32.0f, 32.0f}); // Floor
+        for (int segment = 0; segment <= rows; ++segment) {
+            const float bottom = -static_cast<float>(segment) * WallSegmentHeight;
+            const float top = bottom - WallSegmentHeight;
+            world.solids.push_back(Aabb{-32.0f, top, 0.0f, bottom}); // Left wall
+            world.solids.push_back(Aabb{ShaftWidth, top, ShaftWidth + 32.0f, bottom}); // Right wall
+        }
+
+        std::uint32_t seed = levelId * 0x9E3779B9u + 0x7F4A7C15u;
+        for (int row = 1; row <= rows; ++row) {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            const float width = 64.0f + static_cast<float>(seed % 4u) * 32.0f;
+            const float left = static_cast<float>((seed >> 8) % static_cast<std::uint32_t>(ShaftWidth - width));
+            const float y = -static_cast<float>(row) * RowHeight;
+            if ((levelId & MovingBit) != 0 && row % 4 == 0) {
+                const float halfWidth = width * 0.5f;
+                const float bob = row % 8 == 0 ? 12.0f : 0.0f;
+                const float keys[] = {halfWidth, y + 8.0f, ShaftWidth - halfWidth, y + 8.0f - bob};
+                world.platforms.Add(halfWidth, 8.0f, keys, 1.5f + static_cast<float>(seed % 3u),
+                                    static_cast<float>(seed % 7u) * 0.25f);
+                continue;
+            }
+            world.solids.push_back(Aabb{left, y, left + width, y + 16.0f});
+            if ((levelId & IceBit) != 0 && row % 3 == 0) {
+                world.surfaces.push_back(SurfaceZone{world.solids.back(), SurfaceMaterials::Ice});
+            }
+        }
+
+        if ((levelId & StormBit) != 0) {
+            std::vector<ForceZone> storm;
+            for (int row = rows - rows / 4; row <= rows; row += 2) {
+                seed ^= seed << 13;
+                seed ^= seed >> 17;
+                seed ^= seed << 5;
+                const float y = -static_cast<float>(row) * RowHeight;
+                const float gust = (row / 2 % 2 == 0 ? 1.0f : -1.0f) * (60.0f + static_cast<float>(seed % 4u) * 20.0f);
+                storm.push_back(ForceZone{Aabb{0.0f, y - RowHeight * 2.0f, ShaftWidth, y + RowHeight}, gust, 0.0f,
+                                          RowHeight * 0.5f});
+                const float column = static_cast<float>((seed >> 8) % static_cast<std::uint32_t>(ShaftWidth - 48.0f));
+                storm.push_back(ForceZone{Aabb{column, y - RowHeight * 3.0f, column + 48.0f, y + RowHeight}, 0.0f,
+                                          -MovementConstants::Gravity * 1.25f, 16.0f});
+            }
+            world.wind.AddZones(storm);
+        }
+
+        world.BuildGrid();
+        world.spawnX = ShaftWidth * 0.5f;
+        world.spawnY = 0.0f;
+        return world;
+    }
+
+    /**
+     * @brief Rebuilds `grid` from `solids` and the platform path grid; call after changing either directly.
+     *
+     * Solids added, removed or carved through `AddSolid`, `RemoveSolid` and `Carve` update the grid themselves.
+     */
+    void BuildGrid() {
+        bool first = true;
+        Aabb bounds{0.0f, 0.0f, 0.0f, 0.0f};
+        for (const Aabb &solid: solids) {
+            if (IsSolid(solid)) {
+                bounds = first ? solid : bounds.Merge(solid);
+                first = false;
+            }
+        }
+        grid = SpatialGrid(bounds, GridCellSize);
+        for (std::size_t index = 0; index < solids.size(); ++index) {
+            if (IsSolid(solids[index])) {
+                grid.Insert(static_cast<std::uint32_t>(index), solids[index]);
+            }
+        }
+        platforms.BuildGrid(GridCellSize);
+        dirty = false;
+    }
+
+    /**
+     * @brief Adds a solid and files it in the cells it covers, reusing a removed solid's slot if there is one.
+     *
+     * Solids outside the area the grid was built for land in its border cells, which stays correct but slows
+     * queries there; rebuild with `BuildGrid` after growing the level a lot.
+     *
+     * @return The index of the solid.
+     */
+    std::uint32_t AddSolid(const Aabb &box) {
+        std::uint32_t index;
+        if (freeSolids.empty()) {
+            index = static_cast<std::uint32_t>(solids.size());
+            solids.push_back(box);
+        } else {
+            index = freeSolids.back();
+            freeSolids.pop_back();
+            solids[index] = box;
+        }
+        grid.Insert(index, box);
+        MarkDirty(box);
+        return index;
+    }
+
+    /**
+     * @brief Removes a solid from the cells it covered and frees its slot; other indices stay valid.
+     */
+    void RemoveSolid(std::uint32_t index) {
+        if (!IsSolid(solids[index])) {
+            return;
+        }
+        MarkDirty(solids[index]);
+        grid.Remove(index);
+        solids[index] = RemovedSolid;
+        freeSolids.push_back(index);
+    }
+
+    /**
+     * @brief Cuts a rectangular hole out of every solid it overlaps, such as a wall crumbling.
+     *
+     * Each solid hit is replaced by the up to four pieces left around the hole: the first keeps the solid's
+     * index and only moves between the cells it leaves, the others are added. The work is proportional to the
+     * solids the hole touches and their cells, never to the size of the level.
+     *
+     * @param hole The area to clear.
+     * @return The number of solids that were cut.
+     */
+    std::size_t Carve(const Aabb &hole) {
+        PROFILE_ZONE("World::Carve");
+        carved.reserve(solids.size());
+        grid.Query(hole, carved);
+        for (const std::uint32_t index: carved) {
+            const Aabb solid = solids[index];
+            const float middleTop = std::max(solid.minY, hole.minY);
+            const float middleBottom = std::min(solid.maxY, hole.maxY);
+            Aabb pieces[4];
+            std::size_t count = 0;
+            if (hole.minY > solid.minY) {
+                pieces[count++] = Aabb{solid.minX, solid.minY, solid.maxX, hole.minY}; // Above
+            }
+            if (hole.maxY < solid.maxY) {
+                pieces[count++] = Aabb{solid.minX, hole.maxY, solid.maxX, solid.maxY}; // Below
+            }
+            if (hole.minX > solid.minX) {
+                pieces[count++] = Aabb{solid.minX, middleTop, hole.minX, middleBottom}; // Left
+            }
+            if (hole.maxX < solid.maxX) {
+                pieces[count++] = Aabb{hole.maxX, middleTop, solid.maxX, middleBottom}; // Right
+            }
+
+            if (count == 0) {
+                RemoveSolid(index);
+                continue;
+            }
+            MarkDirty(solid);
+            solids[index] = pieces[0];
+            grid.Update(index, pieces[0]);
+            for (std::size_t piece = 1; piece < count; ++piece) {
+                AddSolid(pieces[piece]);
+            }
+        }
+        return carved.size();
+    }
+
+    /**
+     * @brief Finds the material of the floor under a box.
+     *
+     * @param feet A thin box just below whoever stands on the floor.
+     * @return The material of the first surface zone the box overlaps, or null if the floor is plain.
+     */
+    const SurfaceMaterial *FindSurface(const Aabb &feet) const {
+        for (const SurfaceZone &zone: surfaces) {
+            if (zone.area.Overlaps(feet)) {
+                return &zone.material;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Gets the area changed by `AddSolid`, `RemoveSolid` and `Carve` since the last call, and forgets it.
+     *
+     * Anything derived from the solids, such as a render mesh or a physics body, only needs rebuilding there.
+     *
+     * @param region Receives the changed area.
+     * @return `false` if nothing changed.
+     */
+    bool TakeDirtyRegion(Aabb &region) {
+        if (!dirty) {
+            return false;
+        }
+        region = dirtyRegion;
+        dirty = false;
+        return true;
+    }
+
+    /**
+     * @brief Checks whether a slot of `solids` holds a solid rather than a removed one.
+     */
+    static constexpr bool IsSolid(const Aabb &box) { return box.minX <= box.maxX; }
+
+    /**
+     * @brief Grows the dirty region to cover a box.
+     */
+    void MarkDirty(const Aabb &box) {
+        dirtyRegion = dirty ? dirtyRegion.Merge(box) : box;
+        dirty = true;
+    }
+
+    /**
+     * @brief Stream insertion operator for the World struct.
+     *
+     * @param os The output stream.
+     * @param world The World instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const World &world) {
+        os << "World(Solids: " << world.solids.size() << ", Platforms: " << world.platforms.GetCount()
+                << ", Wind Zones: " << world.wind.GetZoneCount() << ", Surfaces: " << world.surfaces.size()
+                << ", Spawn: (" << world.spawnX << ", " << world.spawnY << "))";
+        return os;
+    }
+};
+
+#endif // WORLD_H
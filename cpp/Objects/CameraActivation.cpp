@@ -0,0 +1,186 @@
+#include "CameraActivation.h"
+#include "../include/Profiler.h"
+#include <godot_cpp/classes/collision_shape2d.hpp> // For measuring pieces by their shapes
+#include <godot_cpp/classes/scene_tree.hpp>        // For the activatable group
+#include <godot_cpp/classes/shape2d.hpp>           // For the shapes' extents
+#include <godot_cpp/classes/sprite2d.hpp>          // For measuring pieces by their sprites
+#include <godot_cpp/classes/viewport.hpp>          // For the visible area
+#include <godot_cpp/core/object.hpp>               // For ObjectDB
+
+void CameraActivation::_ready() {
+    const TypedArray<Node> group = get_tree()->get_nodes_in_group("activatable");
+
+    // Size the grid to the pieces placed in the scene; later pieces outside it land in the border cells
+    std::vector<Node2D *> nodes;
+    std::vector<Rect2> measured;
+    Aabb bounds{0.0f, 0.0f, 0.0f, 0.0f};
+    for (int64_t index = 0; index < group.size(); ++index) {
+        if (Node2D *node = Object::cast_to<Node2D>(group[index])) {
+            nodes.push_back(node);
+            measured.push_back(MeasurePiece(node));
+            const Aabb piece = GetPieceBounds(node, measured.back());
+            bounds = nodes.size() == 1 ? piece : bounds.Merge(piece);
+        }
+    }
+    grid = SpatialGrid(bounds, CellSize);
+    region = std::make_unique<ActivationRegion>(grid, activateMargin, deactivateMargin);
+
+    for (std::size_t index = 0; index < nodes.size(); ++index) {
+        TrackMeasured(nodes[index], measured[index]);
+    }
+}
+
+void CameraActivation::_physics_process(double) {
+    if (!region) {
+        return;
+    }
+    PROFILE_ZONE("CameraActivation::_physics_process");
+
+    const Viewport *viewport = get_viewport();
+    const Rect2 visible = viewport->get_canvas_transform().affine_inverse().xform(viewport->get_visible_rect());
+    region->Update(Aabb{visible.position.x, visible.position.y, visible.position.x + visible.size.x,
+                        visible.position.y + visible.size.y});
+    for (const std::uint32_t id: region->GetEntered()) {
+        SetPieceActive(id, true);
+    }
+    for (const std::uint32_t id: region->GetLeft()) {
+        SetPieceActive(id, false);
+    }
+}
+
+void CameraActivation::Track(Node2D *node) {
+    if (node == nullptr || ids.contains(node->get_instance_id())) {
+        return;
+    }
+    TrackMeasured(node, MeasurePiece(node));
+}
+
+void CameraActivation::TrackMeasured(Node2D *node, const Rect2 &local) {
+    if (ids.contains(node->get_instance_id())) {
+        return;
+    }
+    std::uint32_t id;
+    if (freeIds.empty()) {
+        id = static_cast<std::uint32_t>(pieces.size());
+        pieces.push_back(0);
+        processModes.push_back(Node::PROCESS_MODE_INHERIT);
+        localBounds.emplace_back();
+    } else {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+    pieces[id] = node->get_instance_id();
+    processModes[id] = node->get_process_mode();
+    localBounds[id] = local;
+    ids[pieces[id]] = id;
+
+    SetPieceActive(id, false);
+    grid.Insert(id, GetPieceBounds(node, local));
+    if (region) {
+        region->Refresh(id);
+        if (region->IsActive(id)) {
+            SetPieceActive(id, true);
+        }
+    }
+}
+
+void CameraActivation::Untrack(Node2D *node) {
+    const auto found = node != nullptr ? ids.find(node->get_instance_id()) : ids.end();
+    if (found == ids.end()) {
+        return;
+    }
+    const std::uint32_t id = found->second;
+    SetPieceActive(id, true);
+    grid.Remove(id);
+    if (region) {
+        region->Refresh(id);
+    }
+    ids.erase(found);
+    pieces[id] = 0;
+    freeIds.push_back(id);
+}
+
+void CameraActivation::Refresh(Node2D *node) {
+    const auto found = node != nullptr ? ids.find(node->get_instance_id()) : ids.end();
+    if (found == ids.end()) {
+        return;
+    }
+    const std::uint32_t id = found->second;
+    const bool wasActive = region && region->IsActive(id);
+    grid.Update(id, GetPieceBounds(node, localBounds[id]));
+    if (region) {
+        region->Refresh(id);
+        if (region->IsActive(id) != wasActive) {
+            SetPieceActive(id, !wasActive);
+        }
+    }
+}
+
+int64_t CameraActivation::GetActiveCount() const {
+    return region ? static_cast<int64_t>(region->GetActive().size()) : 0;
+}
+
+int64_t CameraActivation::GetTrackedCount() const {
+    return static_cast<int64_t>(ids.size());
+}
+
+Rect2 CameraActivation::MeasurePiece(Node2D *node) const {
+    const Transform2D toPiece = node->get_global_transform().affine_inverse();
+    Rect2 bounds;
+    bool found = false;
+    std::vector<Node *> pending{node};
+    while (!pending.empty()) {
+        Node *current = pending.back();
+        pending.pop_back();
+        for (int32_t child = 0; child < current->get_child_count(); ++child) {
+            pending.push_back(current->get_child(child));
+        }
+
+        Rect2 local;
+        if (const CollisionShape2D *shape = Object::cast_to<CollisionShape2D>(current);
+            shape != nullptr && shape->get_shape().is_valid()) {
+            local = shape->get_shape()->get_rect();
+        } else if (const Sprite2D *sprite = Object::cast_to<Sprite2D>(current);
+                   sprite != nullptr && sprite->get_texture().is_valid()) {
+            local = sprite->get_rect();
+        } else {
+            continue;
+        }
+        const Rect2 inPiece = (toPiece * Object::cast_to<Node2D>(current)->get_global_transform()).xform(local);
+        bounds = found ? bounds.merge(inPiece) : inPiece;
+        found = true;
+    }
+    return found ? bounds : Rect2(-pieceExtent, -pieceExtent, 2.0f * pieceExtent, 2.0f * pieceExtent);
+}
+
+Aabb CameraActivation::GetPieceBounds(const Node2D *node, const Rect2 &local) {
+    const Rect2 box = node->get_global_transform().xform(local);
+    return Aabb{box.position.x, box.position.y, box.position.x + box.size.x, box.position.y + box.size.y};
+}
+
+void CameraActivation::SetPieceActive(std::uint32_t id, bool active) {
+    // Freed pieces simply stop resolving; their id is reclaimed by Untrack or stays unused
+    Node2D *node = Object::cast_to<Node2D>(ObjectDB::get_instance(pieces[id]));
+    if (node == nullptr) {
+        return;
+    }
+    node->set_process_mode(active ? processModes[id] : Node::PROCESS_MODE_DISABLED);
+    node->set_visible(active);
+}
+
+void CameraActivation::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("Track", "node"), &CameraActivation::Track);
+    ClassDB::bind_method(D_METHOD("Untrack", "node"), &CameraActivation::Untrack);
+    ClassDB::bind_method(D_METHOD("Refresh", "node"), &CameraActivation::Refresh);
+    ClassDB::bind_method(D_METHOD("GetActiveCount"), &CameraActivation::GetActiveCount);
+    ClassDB::bind_method(D_METHOD("GetTrackedCount"), &CameraActivation::GetTrackedCount);
+    ClassDB::bind_method(D_METHOD("GetActivateMargin"), &CameraActivation::GetActivateMargin);
+    ClassDB::bind_method(D_METHOD("SetActivateMargin", "margin"), &CameraActivation::SetActivateMargin);
+    ClassDB::bind_method(D_METHOD("GetDeactivateMargin"), &CameraActivation::GetDeactivateMargin);
+    ClassDB::bind_method(D_METHOD("SetDeactivateMargin", "margin"), &CameraActivation::SetDeactivateMargin);
+    ClassDB::bind_method(D_METHOD("GetPieceExtent"), &CameraActivation::GetPieceExtent);
+    ClassDB::bind_method(D_METHOD("SetPieceExtent", "extent"), &CameraActivation::SetPieceExtent);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "activate_margin"), "SetActivateMargin", "GetActivateMargin");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "deactivate_margin"), "SetDeactivateMargin", "GetDeactivateMargin");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "piece_extent"), "SetPieceExtent", "GetPieceExtent");
+}
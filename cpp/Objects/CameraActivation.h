@@ -0,0 +1,135 @@
+#ifndef CAMERAACTIVATION_H
+#define CAMERAACTIVATION_H
+
+#include <godot_cpp/classes/node.hpp>           // For Node class
+#include <godot_cpp/classes/node2d.hpp>         // For Node2D class
+#include <godot_cpp/core/class_db.hpp>          // For GDCLASS macro
+#include <godot_cpp/variant/rect2.hpp>          // For the pieces' local bounds
+#include "../Core/ActivationRegion.h"           // For the hysteresis region
+#include "../Core/SpatialGrid.h"                // For the incremental spatial index
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+using namespace godot;
+
+/**
+ * @class CameraActivation
+ * @brief Switches off every level piece far from the camera, so it is neither processed nor drawn.
+ *
+ * Add one to the main scene. On `_ready` it picks up every `Node2D` in the `activatable` group; more can be
+ * added with `Track`. Each piece is bucketed by its bounds into a `SpatialGrid`, and an `ActivationRegion`
+ * around the visible area decides which pieces run: pieces outside it get `PROCESS_MODE_DISABLED` and are
+ * hidden, pieces entering it get their process mode and visibility back. Physics bodies inside a disabled
+ * piece leave the physics space too (the default `DISABLE_MODE_REMOVE`), so the player no longer collides
+ * against the far parts of the tower. Pieces that move must be reported with `Refresh`.
+ *
+ * A piece's bounds are measured once, when it is tracked: the collision shapes and sprites in its subtree, in
+ * the piece's own space. Pieces with neither count as a square of `piece_extent` around their position.
+ */
+class CameraActivation : public Node {
+    GDCLASS(CameraActivation, Node)
+
+public:
+    /**
+     * @brief Collects the `activatable` group and builds the grid around it.
+     */
+    void _ready() override;
+
+    /**
+     * @brief Follows the camera and switches pieces on and off.
+     *
+     * @param delta The time elapsed since the previous tick.
+     */
+    void _physics_process(double delta) override;
+
+    /**
+     * @brief Starts managing a piece; it is switched off until the region reaches it.
+     *
+     * @param node The piece to manage.
+     */
+    void Track(Node2D *node);
+
+    /**
+     * @brief Stops managing a piece and switches it back on.
+     *
+     * @param node The piece to release.
+     */
+    void Untrack(Node2D *node);
+
+    /**
+     * @brief Re-buckets a managed piece after it moved.
+     *
+     * @param node The piece that moved.
+     */
+    void Refresh(Node2D *node);
+
+    /**
+     * @brief Gets the number of managed pieces that are currently switched on.
+     */
+    int64_t GetActiveCount() const;
+
+    /**
+     * @brief Gets the number of managed pieces.
+     */
+    int64_t GetTrackedCount() const;
+
+    double GetActivateMargin() const { return activateMargin; }
+
+    void SetActivateMargin(double margin) { activateMargin = static_cast<float>(margin); }
+
+    double GetDeactivateMargin() const { return deactivateMargin; }
+
+    void SetDeactivateMargin(double margin) { deactivateMargin = static_cast<float>(margin); }
+
+    double GetPieceExtent() const { return pieceExtent; }
+
+    void SetPieceExtent(double extent) { pieceExtent = static_cast<float>(extent); }
+
+protected:
+    /**
+     * @brief Binds methods to Godot for use in the editor or scripts.
+     */
+    static void _bind_methods();
+
+private:
+    /**
+     * @brief Edge length of a grid cell in pixels.
+     */
+    static constexpr float CellSize = 256.0f;
+
+    /**
+     * @brief Measures a piece in its own space: the union of the collision shapes and textured sprites in its
+     * subtree, or a square of `pieceExtent` around its origin if it has neither.
+     */
+    Rect2 MeasurePiece(Node2D *node) const;
+
+    /**
+     * @brief Gets the global box a piece occupies, from its measured bounds and current transform.
+     */
+    static Aabb GetPieceBounds(const Node2D *node, const Rect2 &local);
+
+    /**
+     * @brief Starts managing a piece whose bounds are already measured.
+     */
+    void TrackMeasured(Node2D *node, const Rect2 &local);
+
+    /**
+     * @brief Switches a piece on or off.
+     */
+    void SetPieceActive(std::uint32_t id, bool active);
+
+    float activateMargin = 256.0f;
+    float deactivateMargin = 512.0f;
+    float pieceExtent = 64.0f;
+    SpatialGrid grid;
+    std::unique_ptr<ActivationRegion> region;
+    std::vector<uint64_t> pieces;                   // Instance id per grid id, 0 for free ids
+    std::vector<Node::ProcessMode> processModes;    // Process mode to restore per grid id
+    std::vector<Rect2> localBounds;                 // Measured bounds in the piece's space per grid id
+    std::unordered_map<uint64_t, std::uint32_t> ids; // Grid id per instance id
+    std::vector<std::uint32_t> freeIds;
+};
+
+#endif // CAMERAACTIVATION_H
@@ -0,0 +1,48 @@
+#include "CounterMonitors.h"
+
+#include <godot_cpp/classes/performance.hpp>                 // For custom monitors
+#include <godot_cpp/variant/array.hpp>                        // For monitor arguments
+#include <godot_cpp/variant/callable_method_pointer.hpp>      // For callable_mp_static
+#include <godot_cpp/variant/string_name.hpp>                  // For StringName class
+#include "../include/Counters.h"
+
+using namespace godot;
+
+namespace {
+    /**
+     * @brief Builds the monitor id of a counter, e.g. "Gameplay/Collision Tests".
+     */
+    StringName GetMonitorId(Counter counter) {
+        return StringName(String("Gameplay/") + String(Counters::GetName(counter)));
+    }
+}
+
+void CounterMonitors::Register() {
+    Performance *performance = Performance::get_singleton();
+    for (int64_t index = 0; index < static_cast<int64_t>(Counter::Count); ++index) {
+        const StringName id = GetMonitorId(static_cast<Counter>(index));
+        if (performance->has_custom_monitor(id)) {
+            continue;
+        }
+        Array arguments;
+        arguments.push_back(index);
+        performance->add_custom_monitor(id, callable_mp_static(&CounterMonitors::GetLastTick), arguments);
+    }
+}
+
+void CounterMonitors::Unregister() {
+    Performance *performance = Performance::get_singleton();
+    for (int64_t index = 0; index < static_cast<int64_t>(Counter::Count); ++index) {
+        const StringName id = GetMonitorId(static_cast<Counter>(index));
+        if (performance->has_custom_monitor(id)) {
+            performance->remove_custom_monitor(id);
+        }
+    }
+}
+
+int64_t CounterMonitors::GetLastTick(int64_t index) {
+    if (index < 0 || index >= static_cast<int64_t>(Counter::Count)) {
+        return 0;
+    }
+    return static_cast<int64_t>(Counters::GetLastTick(static_cast<Counter>(index)));
+}
@@ -0,0 +1,37 @@
+#ifndef COUNTERMONITORS_H
+#define COUNTERMONITORS_H
+
+#include <cstdint>
+
+/**
+ * @class CounterMonitors
+ * @brief Publishes the gameplay `Counters` as custom monitors in Godot's debugger.
+ *
+ * Each counter shows up under the "Gameplay" group of the Monitors tab with its value for the last
+ * completed physics tick.
+ */
+class CounterMonitors {
+public:
+    /**
+     * @brief Registers one custom monitor per counter.
+     *
+     * Safe to call more than once; monitors that already exist are left alone.
+     */
+    static void Register();
+
+    /**
+     * @brief Removes the monitors added by `Register`.
+     */
+    static void Unregister();
+
+private:
+    /**
+     * @brief Reads a counter for the monitor callable.
+     *
+     * @param index The counter index.
+     * @return The counter's value for the last completed tick.
+     */
+    static int64_t GetLastTick(int64_t index);
+};
+
+#endif // COUNTERMONITORS_H
@@ -0,0 +1,217 @@
+//
+// Created by Stefan on 11/4/2024.
+//
+
+#ifndef ENVIRONMENTELEMENT_H
+#define ENVIRONMENTELEMENT_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "../Core/SurfaceTable.h"
+
+using namespace godot;
+
+/**
+ * @class EnvironmentElement
+ * @brief Represents an individual environment element in the game world.
+ *
+ * This class manages collision states and interacts with Godot's systems for environmental features.
+ *
+ * A physics body is made of an element once the element is attached to it with `Attach`. While the body is in
+ * the tree, the element's surface is bound to the body's instance id in `GetSurfaces`, which is all the player's
+ * collision response reads.
+ */
+class EnvironmentElement : public Object {
+    GDCLASS(EnvironmentElement, Object) // Godot class registration
+
+private:
+    /**
+     * @brief Indicates whether the environment is currently colliding.
+     */
+    bool isColliding;
+
+    /**
+     * @brief How touching the element affects the player, as bound for every attached body.
+     */
+    SurfaceBinding surface;
+
+    /**
+     * @brief Instance ids of the bodies made of this element.
+     */
+    std::vector<uint64_t> bodies;
+
+    /**
+     * @brief Binds an attached body's surface when it enters the tree.
+     */
+    void BindBody(uint64_t body) { GetSurfaces().Bind(body, surface); }
+
+    /**
+     * @brief Forgets an attached body's surface when it leaves the tree.
+     */
+    void UnbindBody(uint64_t body) { GetSurfaces().Unbind(body); }
+
+protected:
+    /**
+     * @brief Constructor for elements with their own surface.
+     *
+     * @param kind How a contact with the element changes the player's velocity.
+     * @param material How the element accelerates and slows whoever moves along it.
+     */
+    EnvironmentElement(SurfaceKind kind, const SurfaceMaterial &material)
+        : isColliding(false), surface{kind, material} {
+    }
+
+    /**
+     * @brief Changes the element's material and rebinds every attached body that is in the tree.
+     *
+     * @param material The new material.
+     */
+    void SetMaterial(const SurfaceMaterial &material) {
+        surface.material = material;
+        for (const uint64_t body: bodies) {
+            if (GetSurfaces().Find(body) != nullptr) {
+                BindBody(body);
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Gets the surfaces of every body in the tree that an element is attached to.
+     *
+     * `Player` looks up each body it touches here.
+     */
+    static SurfaceTable &GetSurfaces() {
+        static SurfaceTable surfaces;
+        return surfaces;
+    }
+
+    /**
+     * @brief Default constructor for the EnvironmentElement class.
+     *
+     * Initializes the `isColliding` flag to `false`. Plain elements are firm ground that leaves the velocity of
+     * whoever touches them untouched.
+     */
+    EnvironmentElement() : EnvironmentElement(SurfaceKind::Plain, SurfaceMaterials::Ground) {
+    }
+
+    /**
+     * @brief Copy constructor for the EnvironmentElement class.
+     *
+     * Creates a new EnvironmentElement instance by copying data from another EnvironmentElement instance.
+     * The copy is not attached to any body.
+     *
+     * @param other The EnvironmentElement instance to copy from.
+     */
+    EnvironmentElement(const EnvironmentElement &other) : isColliding(other.isColliding), surface(other.surface) {
+    }
+
+    /**
+     * @brief Destructor for the EnvironmentElement class; unbinds every attached body.
+     */
+    ~EnvironmentElement() override {
+        for (const uint64_t body: bodies) {
+            UnbindBody(body);
+        }
+    }
+
+    /**
+     * @brief Assignment operator for the EnvironmentElement class.
+     *
+     * Assigns the data of one EnvironmentElement instance to another; the attached bodies stay as they are.
+     *
+     * @param other The EnvironmentElement instance to copy data from.
+     * @return A reference to the updated EnvironmentElement instance.
+     */
+    EnvironmentElement &operator=(const EnvironmentElement &other) {
+        if (this != &other) {
+            // Avoid self-assignment
+            isColliding = other.isColliding;
+            surface.kind = other.surface.kind;
+            SetMaterial(other.surface.material);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Stream insertion operator for the EnvironmentElement class.
+     *
+     * Outputs the collision state of the EnvironmentElement instance.
+     *
+     * @param os The output stream.
+     * @param environment The EnvironmentElement instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const EnvironmentElement &environment) {
+        os << "EnvironmentElement(Collision: " << (environment.isColliding ? "true" : "false") << ")";
+        return os;
+    }
+
+    /**
+     * @brief Gets the collision state of the environment.
+     *
+     * @return `true` if the environment is colliding, `false` otherwise.
+     */
+    bool GetCollision() const { return isColliding; }
+
+    /**
+     * @brief Sets the collision state of the environment.
+     *
+     * @param collision The new collision state.
+     */
+    void SetCollision(bool collision) { isColliding = collision; }
+
+    /**
+     * @brief Makes a physics body out of this element.
+     *
+     * The body's surface is bound in `GetSurfaces` whenever it enters the tree and unbound whenever it leaves,
+     * so contacts never reach back into the element. Attaching a body twice does nothing.
+     *
+     * @param body The body, usually a `StaticBody2D` calling this from its `_ready`.
+     */
+    void Attach(Node *body) {
+        if (body == nullptr || std::ranges::find(bodies, body->get_instance_id()) != bodies.end()) {
+            return;
+        }
+        const uint64_t id = body->get_instance_id();
+        bodies.push_back(id);
+        body->connect("tree_entered", callable_mp(this, &EnvironmentElement::BindBody).bind(id));
+        body->connect("tree_exiting", callable_mp(this, &EnvironmentElement::UnbindBody).bind(id));
+        if (body->is_inside_tree()) {
+            BindBody(id);
+        }
+    }
+
+    /**
+     * @brief Gets the effect of touching this element on the player, as the collision response applies it.
+     *
+     * @param normal The contact normal reported by the collision, pointing away from the element.
+     * @return A `NoEffect` for plain elements, a `WallEffect` along the normal for solid ones.
+     */
+    SurfaceEffect GetEffect(Vector2 normal) const { return surface.GetEffect(normal.x, normal.y); }
+
+    /**
+     * @brief Gets how this element accelerates and slows whoever moves along it.
+     *
+     * @return The element's material; firm ground unless a subclass sets its own.
+     */
+    SurfaceMaterial GetMaterial() const { return surface.material; }
+
+    /**
+     * @brief Binds methods to Godot for use in the editor or scripts.
+     */
+    static void _bind_methods() {
+        ClassDB::bind_method(D_METHOD("GetCollision"), &EnvironmentElement::GetCollision);
+        ClassDB::bind_method(D_METHOD("SetCollision", "collision"), &EnvironmentElement::SetCollision);
+        ClassDB::bind_method(D_METHOD("Attach", "body"), &EnvironmentElement::Attach);
+    }
+};
+
+#endif // ENVIRONMENTELEMENT_H
@@ -0,0 +1,41 @@
+#include "FrameStats.h"
+#include "../include/FrameHistogram.h"
+
+namespace {
+    double ToMilliseconds(uint64_t nanoseconds) {
+        return static_cast<double>(nanoseconds) / 1'000'000.0;
+    }
+}
+
+void FrameStats::_process(double delta) {
+    FrameHistogram::RenderFrames().Record(static_cast<uint64_t>(delta * 1'000'000'000.0));
+}
+
+double FrameStats::GetPhysicsPercentile(double percentile) const {
+    return ToMilliseconds(FrameHistogram::PhysicsTicks().GetPercentile(percentile));
+}
+
+double FrameStats::GetRenderPercentile(double percentile) const {
+    return ToMilliseconds(FrameHistogram::RenderFrames().GetPercentile(percentile));
+}
+
+double FrameStats::GetPhysicsMax() const {
+    return ToMilliseconds(FrameHistogram::PhysicsTicks().GetMax());
+}
+
+double FrameStats::GetRenderMax() const {
+    return ToMilliseconds(FrameHistogram::RenderFrames().GetMax());
+}
+
+void FrameStats::Reset() {
+    FrameHistogram::PhysicsTicks().Reset();
+    FrameHistogram::RenderFrames().Reset();
+}
+
+void FrameStats::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("GetPhysicsPercentile", "percentile"), &FrameStats::GetPhysicsPercentile);
+    ClassDB::bind_method(D_METHOD("GetRenderPercentile", "percentile"), &FrameStats::GetRenderPercentile);
+    ClassDB::bind_method(D_METHOD("GetPhysicsMax"), &FrameStats::GetPhysicsMax);
+    ClassDB::bind_method(D_METHOD("GetRenderMax"), &FrameStats::GetRenderMax);
+    ClassDB::bind_method(D_METHOD("Reset"), &FrameStats::Reset);
+}
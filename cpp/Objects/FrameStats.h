@@ -0,0 +1,66 @@
+#ifndef FRAMESTATS_H
+#define FRAMESTATS_H
+
+#include <godot_cpp/classes/node.hpp>   // For Node class
+#include <godot_cpp/core/class_db.hpp>  // For GDCLASS macro
+#include <cstdint>
+
+using namespace godot;
+
+/**
+ * @class FrameStats
+ * @brief Records render frame times and exposes the frame-time percentiles to GDScript.
+ *
+ * Add one to the main scene. Physics tick durations are recorded by `Player` itself; this node records the
+ * render frame durations and reads both histograms for scripts and debug overlays.
+ */
+class FrameStats : public Node {
+    GDCLASS(FrameStats, Node)
+
+public:
+    /**
+     * @brief Records the duration of the frame that just finished.
+     *
+     * @param delta The time elapsed since the previous frame.
+     */
+    void _process(double delta) override;
+
+    /**
+     * @brief Gets a percentile of the physics tick durations.
+     *
+     * @param percentile The percentile, between 0 and 100.
+     * @return The duration in milliseconds.
+     */
+    double GetPhysicsPercentile(double percentile) const;
+
+    /**
+     * @brief Gets a percentile of the render frame durations.
+     *
+     * @param percentile The percentile, between 0 and 100.
+     * @return The duration in milliseconds.
+     */
+    double GetRenderPercentile(double percentile) const;
+
+    /**
+     * @brief Gets the longest recorded physics tick in milliseconds.
+     */
+    double GetPhysicsMax() const;
+
+    /**
+     * @brief Gets the longest recorded render frame in milliseconds.
+     */
+    double GetRenderMax() const;
+
+    /**
+     * @brief Forgets every recorded tick and frame.
+     */
+    void Reset();
+
+protected:
+    /**
+     * @brief Binds methods to Godot for use in the editor or scripts.
+     */
+    static void _bind_methods();
+};
+
+#endif // FRAMESTATS_H
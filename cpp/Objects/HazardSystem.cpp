@@ -0,0 +1,156 @@
+#include "HazardSystem.h"
+#include "../include/Profiler.h"
+#include <godot_cpp/variant/color.hpp> // For the hazard colours
+
+void HazardSystem::_ready() {
+    hazards = Hazards(static_cast<std::size_t>(capacity));
+    hits.reserve(static_cast<std::size_t>(capacity));
+}
+
+void HazardSystem::_physics_process(double delta) {
+    if (hazards.GetCapacity() == 0) {
+        return;
+    }
+    PROFILE_ZONE("HazardSystem::_physics_process");
+
+    if (solidsChanged) {
+        world.BuildGrid();
+        solidsChanged = false;
+    }
+    hazards.Integrate(static_cast<float>(delta), gravity);
+    hazards.Collide(world, Aabb{bounds.position.x, bounds.position.y, bounds.position.x + bounds.size.x,
+                                bounds.position.y + bounds.size.y});
+
+    const Node2D *player = playerPath.is_empty() ? nullptr : Object::cast_to<Node2D>(get_node_or_null(playerPath));
+    if (player != nullptr) {
+        const Vector2 position = player->get_global_position();
+        const Aabb box{position.x - playerExtent.x, position.y - playerExtent.y, position.x + playerExtent.x,
+                       position.y + playerExtent.y};
+        hazards.FindHits(box, hits);
+        // Backwards, so removing a hit never moves another hit into its slot
+        for (auto hit = hits.rbegin(); hit != hits.rend(); ++hit) {
+            const Vector2 at(hazards.GetPositionsX()[*hit], hazards.GetPositionsY()[*hit]);
+            const int kind = static_cast<int>(hazards.GetKinds()[*hit]);
+            hazards.Remove(*hit);
+            emit_signal("player_hit", kind, at);
+        }
+    }
+    queue_redraw();
+}
+
+void HazardSystem::_draw() {
+    PROFILE_ZONE("HazardSystem::_draw");
+    // Hazards live in global coordinates, whatever this node's own transform
+    draw_set_transform_matrix(get_global_transform().affine_inverse());
+    const Color colors[] = {Color(0.45f, 0.38f, 0.32f), Color(0.75f, 0.9f, 1.0f)};
+    for (std::size_t index = 0; index < hazards.GetCount(); ++index) {
+        const Aabb box = hazards.GetBox(index);
+        draw_rect(Rect2(box.minX, box.minY, box.maxX - box.minX, box.maxY - box.minY),
+                  colors[static_cast<int>(hazards.GetKinds()[index])]);
+    }
+}
+
+bool HazardSystem::Spawn(int kind, const Vector2 &position, const Vector2 &velocity) {
+    return hazards.Spawn(kind == 1 ? HazardKind::Icicle : HazardKind::Rock, position.x, position.y, velocity.x,
+                         velocity.y);
+}
+
+int64_t HazardSystem::SpawnBurst(int kind, const Rect2 &area, int64_t amount, const Vector2 &velocity) {
+    int64_t added = 0;
+    for (; added < amount; ++added) {
+        const float x = area.position.x + area.size.x * static_cast<float>(NextRandom() % 1024u) / 1024.0f;
+        const float y = area.position.y + area.size.y * static_cast<float>(NextRandom() % 1024u) / 1024.0f;
+        const float spread = static_cast<float>(NextRandom() % 64u) - 32.0f;
+        if (!Spawn(kind, Vector2(x, y), velocity + Vector2(spread, spread * 0.5f))) {
+            break;
+        }
+    }
+    return added;
+}
+
+void HazardSystem::AddSolid(const Rect2 &box) {
+    const Rect2 solid = box.abs();
+    world.solids.push_back(Aabb{solid.position.x, solid.position.y, solid.position.x + solid.size.x,
+                                solid.position.y + solid.size.y});
+    solidsChanged = true;
+}
+
+void HazardSystem::ClearSolids() {
+    world.solids.clear();
+    world.freeSolids.clear();
+    solidsChanged = true;
+}
+
+int64_t HazardSystem::Carve(const Rect2 &hole) {
+    if (solidsChanged) {
+        world.BuildGrid();
+        solidsChanged = false;
+    }
+    const Rect2 area = hole.abs();
+    const std::size_t cut = world.Carve(Aabb{area.position.x, area.position.y, area.position.x + area.size.x,
+                                             area.position.y + area.size.y});
+    Aabb region{};
+    if (world.TakeDirtyRegion(region)) {
+        emit_signal("solids_changed", Rect2(region.minX, region.minY, region.maxX - region.minX,
+                                            region.maxY - region.minY));
+    }
+    return static_cast<int64_t>(cut);
+}
+
+Array HazardSystem::GetSolids(const Rect2 &area) const {
+    const Rect2 bounds = area.abs();
+    const Aabb query{bounds.position.x, bounds.position.y, bounds.position.x + bounds.size.x,
+                     bounds.position.y + bounds.size.y};
+    Array solids;
+    for (const Aabb &solid: world.solids) {
+        if (World::IsSolid(solid) && solid.Overlaps(query)) {
+            solids.push_back(Rect2(solid.minX, solid.minY, solid.maxX - solid.minX, solid.maxY - solid.minY));
+        }
+    }
+    return solids;
+}
+
+void HazardSystem::Clear() {
+    hazards.Clear();
+    queue_redraw();
+}
+
+int64_t HazardSystem::GetCount() const {
+    return static_cast<int64_t>(hazards.GetCount());
+}
+
+std::uint32_t HazardSystem::NextRandom() {
+    random ^= random << 13;
+    random ^= random >> 17;
+    random ^= random << 5;
+    return random;
+}
+
+void HazardSystem::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("Spawn", "kind", "position", "velocity"), &HazardSystem::Spawn);
+    ClassDB::bind_method(D_METHOD("SpawnBurst", "kind", "area", "amount", "velocity"), &HazardSystem::SpawnBurst);
+    ClassDB::bind_method(D_METHOD("AddSolid", "box"), &HazardSystem::AddSolid);
+    ClassDB::bind_method(D_METHOD("ClearSolids"), &HazardSystem::ClearSolids);
+    ClassDB::bind_method(D_METHOD("Carve", "hole"), &HazardSystem::Carve);
+    ClassDB::bind_method(D_METHOD("GetSolids", "area"), &HazardSystem::GetSolids);
+    ClassDB::bind_method(D_METHOD("Clear"), &HazardSystem::Clear);
+    ClassDB::bind_method(D_METHOD("GetCount"), &HazardSystem::GetCount);
+    ClassDB::bind_method(D_METHOD("GetCapacity"), &HazardSystem::GetCapacity);
+    ClassDB::bind_method(D_METHOD("SetCapacity", "capacity"), &HazardSystem::SetCapacity);
+    ClassDB::bind_method(D_METHOD("GetGravity"), &HazardSystem::GetGravity);
+    ClassDB::bind_method(D_METHOD("SetGravity", "gravity"), &HazardSystem::SetGravity);
+    ClassDB::bind_method(D_METHOD("GetBounds"), &HazardSystem::GetBounds);
+    ClassDB::bind_method(D_METHOD("SetBounds", "bounds"), &HazardSystem::SetBounds);
+    ClassDB::bind_method(D_METHOD("GetPlayerPath"), &HazardSystem::GetPlayerPath);
+    ClassDB::bind_method(D_METHOD("SetPlayerPath", "path"), &HazardSystem::SetPlayerPath);
+    ClassDB::bind_method(D_METHOD("GetPlayerExtent"), &HazardSystem::GetPlayerExtent);
+    ClassDB::bind_method(D_METHOD("SetPlayerExtent", "extent"), &HazardSystem::SetPlayerExtent);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "capacity"), "SetCapacity", "GetCapacity");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "gravity"), "SetGravity", "GetGravity");
+    ADD_PROPERTY(PropertyInfo(Variant::RECT2, "bounds"), "SetBounds", "GetBounds");
+    ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "player_path"), "SetPlayerPath", "GetPlayerPath");
+    ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "player_extent"), "SetPlayerExtent", "GetPlayerExtent");
+    ADD_SIGNAL(MethodInfo("player_hit", PropertyInfo(Variant::INT, "kind"),
+                          PropertyInfo(Variant::VECTOR2, "position")));
+    ADD_SIGNAL(MethodInfo("solids_changed", PropertyInfo(Variant::RECT2, "region")));
+}
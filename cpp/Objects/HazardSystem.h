@@ -0,0 +1,153 @@
+#ifndef HAZARDSYSTEM_H
+#define HAZARDSYSTEM_H
+
+#include <godot_cpp/classes/node2d.hpp>         // For Node2D class
+#include <godot_cpp/core/class_db.hpp>          // For GDCLASS macro
+#include <godot_cpp/variant/array.hpp>          // For the solids handed to the scene
+#include <godot_cpp/variant/node_path.hpp>      // For the player path
+#include <godot_cpp/variant/rect2.hpp>          // For Rect2 class
+#include "../Core/Hazards.h"                    // For the hazard arrays
+#include "../Core/World.h"                      // For the solids hazards shatter on
+#include <cstdint>
+#include <vector>
+
+using namespace godot;
+
+/**
+ * @class HazardSystem
+ * @brief Simulates and draws every falling rock and icicle of a level from one node.
+ *
+ * A node per hazard would cost a scene-tree entry, a physics body and a process callback each; avalanches
+ * spawn thousands. This node keeps them in a `Hazards` instead, steps them in `_physics_process`, shatters
+ * them on the solids added with `AddSolid`, and draws them all in one `_draw`. When hazards overlap the node
+ * at `player_path`, they shatter and `player_hit` is emitted for each.
+ */
+class HazardSystem : public Node2D {
+    GDCLASS(HazardSystem, Node2D)
+
+public:
+    /**
+     * @brief Allocates the hazard arrays at the configured capacity.
+     */
+    void _ready() override;
+
+    /**
+     * @brief Moves, collides and compacts every hazard, then checks the player.
+     *
+     * @param delta The time elapsed since the previous tick.
+     */
+    void _physics_process(double delta) override;
+
+    /**
+     * @brief Draws every hazard as a rectangle.
+     */
+    void _draw() override;
+
+    /**
+     * @brief Adds one hazard.
+     *
+     * @param kind 0 for a rock, 1 for an icicle.
+     * @param position The hazard's centre in global coordinates.
+     * @param velocity The hazard's initial velocity.
+     * @return `false` if the system is full.
+     */
+    bool Spawn(int kind, const Vector2 &position, const Vector2 &velocity);
+
+    /**
+     * @brief Adds hazards spread over an area, such as an avalanche breaking off a ledge.
+     *
+     * @param kind 0 for a rock, 1 for an icicle.
+     * @param area Where the hazards appear, in global coordinates.
+     * @param amount How many hazards to add.
+     * @param velocity The initial velocity, varied a little per hazard.
+     * @return The number of hazards added before the system was full.
+     */
+    int64_t SpawnBurst(int kind, const Rect2 &area, int64_t amount, const Vector2 &velocity);
+
+    /**
+     * @brief Adds a box hazards shatter on, in global coordinates.
+     */
+    void AddSolid(const Rect2 &box);
+
+    /**
+     * @brief Removes every solid.
+     */
+    void ClearSolids();
+
+    /**
+     * @brief Cuts a hole out of the solids hazards shatter on, such as a wall or floor crumbling.
+     *
+     * Only the solids around the hole and their grid cells are updated, so this is cheap enough to call
+     * every tick.
+     *
+     * Emits `solids_changed` with the area whose solids changed. This node only keeps its own copy of the
+     * solids, so the scene refits its collision shapes there from `GetSolids`.
+     *
+     * @param hole The area to clear, in global coordinates.
+     * @return The number of solids that were cut.
+     */
+    int64_t Carve(const Rect2 &hole);
+
+    /**
+     * @brief Gets the solids hazards shatter on that overlap an area, such as the one reported by `solids_changed`.
+     *
+     * @param area The area to search, in global coordinates.
+     * @return The solids as `Rect2`s.
+     */
+    Array GetSolids(const Rect2 &area) const;
+
+    /**
+     * @brief Removes every hazard.
+     */
+    void Clear();
+
+    /**
+     * @brief Gets the number of hazards in flight.
+     */
+    int64_t GetCount() const;
+
+    int64_t GetCapacity() const { return capacity; }
+
+    void SetCapacity(int64_t newCapacity) { capacity = newCapacity > 0 ? newCapacity : 1; }
+
+    double GetGravity() const { return gravity; }
+
+    void SetGravity(double newGravity) { gravity = static_cast<float>(newGravity); }
+
+    Rect2 GetBounds() const { return bounds; }
+
+    void SetBounds(const Rect2 &newBounds) { bounds = newBounds; }
+
+    NodePath GetPlayerPath() const { return playerPath; }
+
+    void SetPlayerPath(const NodePath &path) { playerPath = path; }
+
+    Vector2 GetPlayerExtent() const { return playerExtent; }
+
+    void SetPlayerExtent(const Vector2 &extent) { playerExtent = extent; }
+
+protected:
+    /**
+     * @brief Binds methods to Godot for use in the editor or scripts.
+     */
+    static void _bind_methods();
+
+private:
+    /**
+     * @brief Gets the next pseudo-random number for spreading bursts.
+     */
+    std::uint32_t NextRandom();
+
+    int64_t capacity = 4096;
+    float gravity = 980.0f;
+    Rect2 bounds{-4096.0f, -65536.0f, 8192.0f, 69632.0f};
+    NodePath playerPath;
+    Vector2 playerExtent{8.0f, 16.0f};
+    Hazards hazards{0};
+    World world;
+    bool solidsChanged = false;
+    std::vector<std::uint32_t> hits;
+    std::uint32_t random = 0x9E3779B9u;
+};
+
+#endif // HAZARDSYSTEM_H
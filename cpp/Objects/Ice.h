@@ -6,34 +6,27 @@
 #ifndef ICE_H
 #define ICE_H
 
-#include "Environment.h"
+#include "EnvironmentElement.h"
 #include <iostream>
 
 /**
  * @class Ice
  * @brief Represents an icy surface in the game world that affects the player's speed.
  *
- * The Ice class modifies the player's speed when colliding with it, simulating slippery conditions.
+ * The player slides on the ice through its `SurfaceMaterial`, which sets how quickly they speed up, slow
+ * down and how fast they can go while standing on it.
  */
-class Ice : public Environment {
-    GDCLASS(Ice, Environment) // Godot class registration
-
-private:
-    /**
-     * @brief The factor by which the player's speed is multiplied when colliding with the ice.
-     */
-    float speedMultiplier;
+class Ice : public EnvironmentElement {
+    GDCLASS(Ice, EnvironmentElement) // Godot class registration
 
 public:
     /**
      * @brief Constructor for the Ice class.
      *
-     * Initializes the speed multiplier for the ice and its collision state.
-     *
-     * @param newSpeedMultiplier The multiplier to apply to the player's speed when on the ice.
+     * Initializes the ice with the default ice material and its collision state. The player cannot push into
+     * the ice any more than into a wall.
      */
-    Ice(float newSpeedMultiplier = 1.5f)
-        : speedMultiplier(newSpeedMultiplier) {
+    Ice() : EnvironmentElement(SurfaceKind::Wall, SurfaceMaterials::Ice) {
         SetCollision(true); // Ice always has a collision state
     }
 
@@ -44,8 +37,7 @@ public:
      *
      * @param other The Ice instance to copy from.
      */
-    Ice(const Ice &other)
-        : Environment(other), speedMultiplier(other.speedMultiplier) {
+    Ice(const Ice &other) : EnvironmentElement(other) {
     }
 
     /**
@@ -59,8 +51,7 @@ public:
     Ice &operator=(const Ice &other) {
         if (this != &other) {
             // Avoid self-assignment
-            Environment::operator=(other);
-            speedMultiplier = other.speedMultiplier;
+            EnvironmentElement::operator=(other);
         }
         return *this;
     }
@@ -68,52 +59,107 @@ public:
     /**
      * @brief Stream insertion operator for the Ice class.
      *
-     * Outputs the ice's speed multiplier and collision state.
+     * Outputs the ice's material and collision state.
      *
      * @param os The output stream.
      * @param ice The Ice instance to output.
      * @return A reference to the updated output stream.
      */
     friend std::ostream &operator<<(std::ostream &os, const Ice &ice) {
-        os << "Ice(Speed Multiplier: " << ice.speedMultiplier << ", Collision: "
+        os << "Ice(" << ice.GetMaterial() << ", Collision: "
                 << (ice.GetCollision() ? "true" : "false") << ")";
         return os;
     }
 
     /**
-     * @brief Gets the speed multiplier for the ice.
+     * @brief Gets how quickly the player picks up speed on the ice from standstill.
+     *
+     * @return The material's acceleration, in pixels per second squared.
+     */
+    double GetAcceleration() const { return GetMaterial().acceleration; }
+
+    /**
+     * @brief Sets how quickly the player picks up speed on the ice; edits the ice's `SurfaceMaterial`.
+     *
+     * @param acceleration The new acceleration from standstill, in pixels per second squared.
+     */
+
+    void SetAcceleration(double acceleration) {
+        SurfaceMaterial material = GetMaterial();
+        material.acceleration = static_cast<float>(acceleration);
+        SetMaterial(material);
+    }
+
+    /**
+     * @brief Gets how quickly the player slows down on the ice once no direction is held.
      *
-     * @return The multiplier that modifies the player's speed when on the ice.
+     * @return The material's friction, a decay rate per second; 0 never stops.
      */
-    float GetSpeedMultiplier() const { return speedMultiplier; }
+    double GetFriction() const { return GetMaterial().friction; }
+
+    /**
+     * @brief Sets how quickly the player slows down on the ice; edits the ice's `SurfaceMaterial`.
+     *
+     * @param friction The new decay rate per second; 0 never stops.
+     */
+
+    void SetFriction(double friction) {
+        SurfaceMaterial material = GetMaterial();
+        material.friction = static_cast<float>(friction);
+        SetMaterial(material);
+    }
 
     /**
-     * @brief Sets the speed multiplier for the ice.
+     * @brief Gets the speed the player approaches on the ice while holding a direction.
      *
-     * @param multiplier The new speed multiplier for the ice.
+     * @return The material's top speed, in pixels per second.
      */
-    void SetSpeedMultiplier(float multiplier) { speedMultiplier = multiplier; }
+    double GetMaxSpeed() const { return GetMaterial().maxSpeed; }
+
+    /**
+     * @brief Sets the speed the player approaches on the ice; edits the ice's `SurfaceMaterial`.
+     *
+     * @param maxSpeed The new top speed, in pixels per second.
+     */
+
+    void SetMaxSpeed(double maxSpeed) {
+        SurfaceMaterial material = GetMaterial();
+        material.maxSpeed = static_cast<float>(maxSpeed);
+        SetMaterial(material);
+    }
 
     /**
-     * @brief Applies the effect of ice to the player's speed when colliding with it.
+     * @brief Moves the player along the ice for one physics step.
      *
-     * This function should be called when checking if the player is colliding with the ice. It modifies
-     * the player's speed based on the ice's speed multiplier.
+     * The horizontal speed follows the ice's material in closed form, so the same time on the ice gives the
+     * same speed at any tick rate. The vertical speed is left to gravity.
      *
-     * @param playerSpeed The player's current speed to modify.
-     * @return The modified player speed after applying the ice effect.
+     * @param playerSpeed The player's speed at the start of the step.
+     * @param direction The held direction: -1, 0 or 1.
+     * @param delta The step length in seconds.
+     * @return The player's speed at the end of the step.
      */
-    Vector2 ApplyIceEffect(Vector2 playerSpeed) const {
-        return playerSpeed * speedMultiplier;
+    Vector2 ApplySurface(Vector2 playerSpeed, double direction, double delta) const {
+        PROFILE_ZONE("Ice::ApplySurface");
+        const SurfaceMotion motion = GetMaterial().Step(playerSpeed.x, static_cast<float>(direction),
+                                                        static_cast<float>(delta));
+        return Vector2(motion.velocity, playerSpeed.y);
     }
 
     /**
      * @brief Binds methods to Godot for use in the editor or scripts.
      */
     static void _bind_methods() {
-        ClassDB::bind_method(D_METHOD("GetSpeedMultiplier"), &Ice::GetSpeedMultiplier);
-        ClassDB::bind_method(D_METHOD("SetSpeedMultiplier", "multiplier"), &Ice::SetSpeedMultiplier);
-        ClassDB::bind_method(D_METHOD("ApplyIceEffect", "playerSpeed"), &Ice::ApplyIceEffect);
+        ClassDB::bind_method(D_METHOD("ApplySurface", "playerSpeed", "direction", "delta"), &Ice::ApplySurface);
+        ClassDB::bind_method(D_METHOD("GetAcceleration"), &Ice::GetAcceleration);
+        ClassDB::bind_method(D_METHOD("SetAcceleration", "acceleration"), &Ice::SetAcceleration);
+        ClassDB::bind_method(D_METHOD("GetFriction"), &Ice::GetFriction);
+        ClassDB::bind_method(D_METHOD("SetFriction", "friction"), &Ice::SetFriction);
+        ClassDB::bind_method(D_METHOD("GetMaxSpeed"), &Ice::GetMaxSpeed);
+        ClassDB::bind_method(D_METHOD("SetMaxSpeed", "maxSpeed"), &Ice::SetMaxSpeed);
+        ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "acceleration"), "SetAcceleration", "GetAcceleration");
+        ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "friction"), "SetFriction", "GetFriction");
+        ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_speed"), "SetMaxSpeed", "GetMaxSpeed");
     }
 };
 
@@ -0,0 +1,69 @@
+#include "InputActions.h"
+
+#include <godot_cpp/classes/engine.hpp> // For the physics frame counter
+#include <godot_cpp/classes/input.hpp>  // For Input handling
+
+std::unique_ptr<InputActions::NameTable> InputActions::names;
+InputSnapshot InputActions::current;
+uint64_t InputActions::currentFrame = UINT64_MAX;
+
+/**
+ * @brief Interns the action names.
+ *
+ * `StringName`s can only be created once the engine is running, so this runs from `initialize_oop_module`.
+ */
+void InputActions::Initialize() {
+    names = std::make_unique<NameTable>(NameTable{
+        StringName("ui_left"),
+        StringName("ui_right"),
+        StringName("ui_up"),
+    });
+    currentFrame = UINT64_MAX;
+}
+
+/**
+ * @brief Releases the action names before godot-cpp shuts down.
+ */
+void InputActions::Uninitialize() {
+    names.reset();
+}
+
+/**
+ * @brief Gets the interned Godot action name of a gameplay action.
+ *
+ * @param action The gameplay action.
+ * @return The `StringName` registered in the input map for that action.
+ */
+const StringName &InputActions::GetName(InputAction action) {
+    return (*names)[static_cast<size_t>(action)];
+}
+
+/**
+ * @brief Reads the current state of every gameplay action from the input system.
+ *
+ * @return A fresh snapshot.
+ */
+InputSnapshot InputActions::Capture() {
+    const Input *input = Input::get_singleton();
+    InputSnapshot snapshot;
+    for (uint8_t index = 0; index < static_cast<uint8_t>(InputAction::Count); ++index) {
+        const auto action = static_cast<InputAction>(index);
+        const StringName &name = GetName(action);
+        snapshot.Set(action, input->is_action_pressed(name), input->is_action_just_pressed(name));
+    }
+    return snapshot;
+}
+
+/**
+ * @brief Gets the snapshot of the current physics frame, capturing it on first use in the frame.
+ *
+ * @return The snapshot shared by all gameplay code this frame.
+ */
+const InputSnapshot &InputActions::GetCurrent() {
+    const uint64_t frame = Engine::get_singleton()->get_physics_frames();
+    if (frame != currentFrame) {
+        current = Capture();
+        currentFrame = frame;
+    }
+    return current;
+}
@@ -0,0 +1,75 @@
+#ifndef INPUTACTIONS_H
+#define INPUTACTIONS_H
+
+#include <godot_cpp/variant/string_name.hpp> // For StringName class
+#include "../Core/InputSnapshot.h"
+#include <array>
+#include <memory>
+
+using namespace godot;
+
+/**
+ * @class InputActions
+ * @brief Bridges Godot's input map to the shared per-tick `InputSnapshot`.
+ *
+ * Action names are interned into `StringName`s once, and the input system is queried at most once per
+ * physics frame; every caller in the same frame gets the same snapshot.
+ */
+class InputActions {
+public:
+    /**
+     * @brief Interns the action names; called when the extension's scene level is initialized.
+     */
+    static void Initialize();
+
+    /**
+     * @brief Releases the action names while godot-cpp can still free them; called when the extension's scene
+     *        level is uninitialized.
+     */
+    static void Uninitialize();
+
+    /**
+     * @brief Gets the interned Godot action name of a gameplay action.
+     *
+     * @param action The gameplay action.
+     * @return The `StringName` registered in the input map for that action.
+     */
+    static const StringName &GetName(InputAction action);
+
+    /**
+     * @brief Reads the current state of every gameplay action from the input system.
+     *
+     * @return A fresh snapshot.
+     */
+    static InputSnapshot Capture();
+
+    /**
+     * @brief Gets the snapshot of the current physics frame, capturing it on first use in the frame.
+     *
+     * @return The snapshot shared by all gameplay code this frame.
+     */
+    static const InputSnapshot &GetCurrent();
+
+private:
+    using NameTable = std::array<StringName, static_cast<size_t>(InputAction::Count)>;
+
+    /**
+     * @brief The interned action names, owned by the module between `Initialize` and `Uninitialize`.
+     *
+     * Not a function-local static: that would be destroyed during static destruction, after godot-cpp has
+     * shut down.
+     */
+    static std::unique_ptr<NameTable> names;
+
+    /**
+     * @brief The snapshot of the last captured physics frame.
+     */
+    static InputSnapshot current;
+
+    /**
+     * @brief The physics frame `current` was captured in.
+     */
+    static uint64_t currentFrame;
+};
+
+#endif // INPUTACTIONS_H
@@ -0,0 +1,59 @@
+#include "PlatformSystem.h"
+#include "../include/Profiler.h"
+#include <godot_cpp/core/object.hpp> // For ObjectDB
+
+void PlatformSystem::_ready() {
+    set_physics_process_priority(-1);
+}
+
+void PlatformSystem::_physics_process(double delta) {
+    if (paths.IsEmpty() || delta <= 0.0) {
+        return;
+    }
+    PROFILE_ZONE("PlatformSystem::_physics_process");
+    time += delta;
+    MoveBodies();
+}
+
+int64_t PlatformSystem::AddPlatform(AnimatableBody2D *body, const Vector2 &halfExtent, const Vector2 &from,
+                                    const Vector2 &to, double secondsPerKey, double phaseSeconds) {
+    if (body == nullptr || secondsPerKey <= 0.0) {
+        return -1;
+    }
+    const float keys[] = {from.x, from.y, to.x, to.y};
+    const std::uint32_t index = paths.Add(halfExtent.x, halfExtent.y, keys, static_cast<float>(secondsPerKey),
+                                          static_cast<float>(phaseSeconds));
+    body->set_sync_to_physics(true);
+    bodies.push_back(body->get_instance_id());
+    positionsX.resize(paths.GetCount());
+    positionsY.resize(paths.GetCount());
+
+    float x, y;
+    paths.SampleOne(index, time, x, y);
+    body->set_global_position(Vector2(x, y));
+    return index;
+}
+
+int64_t PlatformSystem::GetCount() const {
+    return paths.GetCount();
+}
+
+void PlatformSystem::MoveBodies() {
+    paths.Sample(time, positionsX, positionsY);
+    for (std::size_t index = 0; index < bodies.size(); ++index) {
+        // Freed platforms simply stop resolving; their path keeps its slot
+        AnimatableBody2D *body = Object::cast_to<AnimatableBody2D>(ObjectDB::get_instance(bodies[index]));
+        if (body != nullptr) {
+            body->set_global_position(Vector2(positionsX[index], positionsY[index]));
+        }
+    }
+}
+
+void PlatformSystem::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("AddPlatform", "body", "half_extent", "from", "to", "seconds_per_key",
+                                  "phase_seconds"), &PlatformSystem::AddPlatform, DEFVAL(0.0));
+    ClassDB::bind_method(D_METHOD("GetCount"), &PlatformSystem::GetCount);
+    ClassDB::bind_method(D_METHOD("GetTime"), &PlatformSystem::GetTime);
+    ClassDB::bind_method(D_METHOD("SetTime", "time"), &PlatformSystem::SetTime);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "time"), "SetTime", "GetTime");
+}
@@ -0,0 +1,93 @@
+#ifndef PLATFORMSYSTEM_H
+#define PLATFORMSYSTEM_H
+
+#include <godot_cpp/classes/animatable_body2d.hpp> // For the bodies the platforms move
+#include <godot_cpp/classes/node.hpp>             // For Node class
+#include <godot_cpp/core/class_db.hpp>            // For GDCLASS macro
+#include <godot_cpp/variant/vector2.hpp>          // For Vector2 class
+#include "../Core/PlatformPaths.h"                // For the closed-form platform paths
+#include <cstdint>
+#include <vector>
+
+using namespace godot;
+
+/**
+ * @class PlatformSystem
+ * @brief Moves every shuttling platform of a level from one node.
+ *
+ * Each platform is an `AnimatableBody2D`, usually a child of this node, registered with `AddPlatform`. Once per
+ * physics tick the node samples every path in one `PlatformPaths::Sample` pass at the level's time and moves the
+ * bodies there. It processes before the default priority, so the bodies have reached this tick's position by the
+ * time the player moves.
+ *
+ * The player rides the platforms through Godot's physics: with `sync_to_physics` on, which `AddPlatform`
+ * enforces, an `AnimatableBody2D` moved during the physics step reports its velocity, and `move_and_slide`
+ * carries a `CharacterBody2D` standing on it along and collides it against the body's swept motion.
+ */
+class PlatformSystem : public Node {
+    GDCLASS(PlatformSystem, Node)
+
+public:
+    /**
+     * @brief Runs before the nodes that ride the platforms.
+     */
+    void _ready() override;
+
+    /**
+     * @brief Advances the level's time and moves every platform to its position at that time.
+     *
+     * @param delta The time elapsed since the previous tick.
+     */
+    void _physics_process(double delta) override;
+
+    /**
+     * @brief Makes a body shuttle between two points and back.
+     *
+     * @param body The platform's body; it is moved to the path at once.
+     * @param halfExtent Half of the platform's size.
+     * @param from The body's global position at the first keyframe.
+     * @param to The body's global position at the second keyframe; equal to `from` for a platform that stays put.
+     * @param secondsPerKey Time spent travelling from one keyframe to the other.
+     * @param phaseSeconds Time offset into the loop at time zero.
+     * @return The index of the platform, or -1 if `body` is null or `secondsPerKey` is not positive.
+     */
+    int64_t AddPlatform(AnimatableBody2D *body, const Vector2 &halfExtent, const Vector2 &from, const Vector2 &to,
+                        double secondsPerKey, double phaseSeconds);
+
+    /**
+     * @brief Gets the number of platforms.
+     */
+    int64_t GetCount() const;
+
+    /**
+     * @brief Gets the level's time the platforms are at, in seconds.
+     */
+    double GetTime() const { return time; }
+
+    /**
+     * @brief Sets the level's time, such as when loading a save; the platforms jump there on the next tick.
+     *
+     * @param newTime The time in seconds; negative times are clamped to 0.
+     */
+    void SetTime(double newTime) { time = newTime > 0.0 ? newTime : 0.0; }
+
+protected:
+    /**
+     * @brief Binds methods to Godot for use in the editor or scripts.
+     */
+    static void _bind_methods();
+
+private:
+    /**
+     * @brief Moves every platform's body to the sampled positions.
+     */
+    void MoveBodies();
+
+    PlatformPaths paths;
+    std::vector<uint64_t> bodies; // Instance id per platform
+    std::vector<float> positionsX;
+    std::vector<float> positionsY;
+    double time = 0.0;
+};
+
+#endif // PLATFORMSYSTEM_H
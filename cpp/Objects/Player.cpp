@@ -1,15 +1,26 @@
 #include "Player.h"
+#include "InputActions.h"
+#include "CounterMonitors.h"
+#include "../include/AllocationTracker.h"
+#include "../include/BinaryLog.h"
+#include "../include/Counters.h"
+#include "../include/FrameHistogram.h"
+#include "../include/Profiler.h"
+#include <godot_cpp/classes/engine.hpp>               // For the physics frame counter
+#include <godot_cpp/classes/kinematic_collision2d.hpp> // For the contacts of move_and_slide
+#include <godot_cpp/classes/os.hpp>                   // For Godot allocator statistics
+#include <algorithm>
+#include <chrono>
 
 /**
  * @brief Default constructor for the Player class.
  *
- * Initializes the player's movement direction, speed, gravity, and jump status.
+ * Initializes the player's movement direction, movement mode, and jump status.
  */
 Player::Player()
     : CharacterBody2D(),
       movementDirection(Vector2(0.0, 0.0)),
-      movementSpeed(Vector2(100.0, 100.0)),
-      gravityForce(9.8),
+      movementMode(MOVEMENT_NORMAL),
       canJump(false),
       velocity(Vector2(0.0, 0.0)) {
 } // Initialize velocity
@@ -23,6 +34,8 @@ Player::Player()
 void Player::_ready() {
     movementDirection = Vector2(0.0, 0.0); // Reset movement direction
     canJump = true; // Player is ready to jump once the scene starts
+    spawnY = get_global_position().y;
+    CounterMonitors::Register(); // Show the gameplay counters in the debugger
 }
 
 /**
@@ -34,37 +47,388 @@ void Player::_ready() {
  * @param delta The time elapsed since the last physics frame.
  */
 void Player::_physics_process(float delta) {
-    // Apply gravity if the player is not on the floor
+    PROFILE_ZONE("Player::_physics_process");
+    const auto tickStart = std::chrono::steady_clock::now();
+    const uint64_t godotMemoryBefore = OS::get_singleton()->get_static_memory_usage();
+    Counters::BeginTick(Engine::get_singleton()->get_physics_frames());
+    const MovementInput movementInput = InputActions::GetCurrent().ToMovementInput(canJump);
+    const MovementState current{velocity.x, velocity.y, canJump};
+
+    // Each mode is its own instantiation, so the tuning values are folded into the step
+    MovementState next;
+    switch (movementMode) {
+        case MOVEMENT_ICE:
+            next = MovementStep<IceTuning>(current, movementInput, is_on_floor(), delta);
+            break;
+        case MOVEMENT_LOW_GRAVITY:
+            next = MovementStep<LowGravityTuning>(current, movementInput, is_on_floor(), delta);
+            break;
+        default:
+            next = MovementStep<NormalTuning>(current, movementInput, is_on_floor(), delta);
+            break;
+    }
+
+    // Standing on an element, its material sets the running speed in place of the mode's traction
+    if (floorMaterial && is_on_floor()) {
+        next = ApplyFloorMaterial(*floorMaterial, current.velocityX, next, movementInput, delta);
+    }
+
+    velocity = Vector2(next.velocityX, next.velocityY);
+    canJump = next.canJump;
+
+    // Wind and updrafts accelerate the player on top of the movement rules
+    if (!wind.IsEmpty()) {
+        const Vector2 position = get_global_position();
+        float forceX, forceY;
+        wind.SampleOne(position.x, position.y, forceX, forceY);
+        velocity += Vector2(forceX, forceY) * delta;
+    }
+
+    // Hand the velocity to the body and move the player
+    set_velocity(velocity);
+    {
+        PROFILE_ZONE("Collision::move_and_slide");
+        move_and_slide();
+    }
+    Counters::Add(Counter::MoveAndSlideCalls);
+    Counters::Add(Counter::CollisionTests, static_cast<uint64_t>(get_slide_collision_count()));
+
+    // Each contact applies the surface of the element the body is made of, bound when the body entered the tree.
+    // Bodies without one act as plain walls, so slippery modes do not keep building speed against them. Floor
+    // contacts also pick the material the next tick runs on
+    const SurfaceTable &surfaces = EnvironmentElement::GetSurfaces();
+    MovementState touched{velocity.x, velocity.y, canJump};
+    for (int32_t index = 0; index < get_slide_collision_count(); ++index) {
+        const Ref<KinematicCollision2D> collision = get_slide_collision(index);
+        const Vector2 normal = collision->get_normal();
+        const SurfaceBinding *surface = surfaces.Find(collision->get_collider_id());
+        touched = ApplySurfaceEffect(surface != nullptr ? surface->GetEffect(normal.x, normal.y)
+                                                        : SurfaceEffect{WallEffect{normal.x, normal.y}}, touched);
+        if (collision->get_angle(get_up_direction()) <= get_floor_max_angle()) {
+            floorMaterial = surface != nullptr ? std::optional(surface->material) : std::nullopt;
+        }
+    }
     if (!is_on_floor()) {
-        velocity.y += gravityForce * delta; // Apply gravity over time
-    } else {
-        velocity.y = 0; // Stop vertical velocity when grounded
-
-        // Handle jumping when the player is grounded and the jump button is pressed
-        if (canJump && Input::get_singleton()->is_action_just_pressed("ui_up")) {
-            velocity.y = -300.0f; // Current jump power
-            canJump = false; // Prevent double jump
+        floorMaterial.reset();
+    }
+    velocity = Vector2(touched.velocityX, touched.velocityY);
+
+    // Trace the full state cheaply; the text is only rendered offline by oop_logdecode
+    const Vector2 position = get_position();
+    BINARY_LOG("Player position=({}, {}) velocity=({}, {}) canJump={} mode={}",
+               position.x, position.y, velocity.x, velocity.y, canJump, static_cast<int>(movementMode));
+    if (telemetry) {
+        const auto collisionFlags = static_cast<uint8_t>((is_on_floor() ? TELEMETRY_ON_FLOOR : 0) |
+                                                         (is_on_wall() ? TELEMETRY_ON_WALL : 0) |
+                                                         (is_on_ceiling() ? TELEMETRY_ON_CEILING : 0));
+        const SurfaceMaterialId surface = floorMaterial ? floorMaterial->id : SurfaceMaterialId::None;
+        telemetry->Record({position.x, position.y, velocity.x, velocity.y, canJump, static_cast<uint8_t>(surface),
+                           collisionFlags});
+    }
+    if (ghostSender) {
+        ghostSender->Update(static_cast<uint32_t>(Engine::get_singleton()->get_physics_frames()),
+                            GhostState::Quantize(position.x, position.y, velocity.x, velocity.y, canJump,
+                                                 static_cast<uint8_t>(movementMode)));
+    }
+    saveState.progress.bestHeight = std::max(saveState.progress.bestHeight, spawnY - get_global_position().y);
+    ++saveState.progress.playTicks;
+    if (autosaver) {
+        sinceAutosave += delta;
+        if (sinceAutosave >= autosaveInterval) {
+            // Only copies; the writer thread compresses and syncs the file
+            sinceAutosave = 0.0;
+            UpdateSaveState();
+            autosaver->Snapshot(saveState);
         }
     }
 
-    // Horizontal movement input
-    if (Input::get_singleton()->is_action_pressed("ui_right")) {
-        velocity.x = movementSpeed.x; // Move right
-    } else if (Input::get_singleton()->is_action_pressed("ui_left")) {
-        velocity.x = -movementSpeed.x; // Move left
-    } else {
-        velocity.x = 0.0f; // No horizontal movement
+    // Godot's allocator cannot be hooked from an extension, so track how much its static pool grew instead
+    const uint64_t godotMemoryAfter = OS::get_singleton()->get_static_memory_usage();
+    if (godotMemoryAfter > godotMemoryBefore) {
+        Counters::Add(Counter::GodotMemoryGrowth, godotMemoryAfter - godotMemoryBefore);
     }
 
-    // Set the velocity directly and move the player
-    this->velocity = velocity; // Update the velocity property
-    move_and_slide(); // No need to pass velocity, as it's already set
+    FrameHistogram::PhysicsTicks().Record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tickStart).count()));
+}
+
+/**
+ * @brief Gets the movement mode of the player.
+ *
+ * @return The current movement mode as an integer, for use from scripts.
+ */
+int Player::GetMovementMode() const {
+    return movementMode;
+}
+
+/**
+ * @brief Sets the movement mode of the player.
+ *
+ * Unknown values fall back to the normal mode.
+ *
+ * @param mode The new movement mode.
+ */
+void Player::SetMovementMode(int mode) {
+    switch (mode) {
+        case MOVEMENT_ICE:
+        case MOVEMENT_LOW_GRAVITY:
+            movementMode = static_cast<MovementMode>(mode);
+            break;
+        default:
+            movementMode = MOVEMENT_NORMAL;
+            break;
+    }
+}
+
+/**
+ * @brief Gets the tuning values of the current movement mode.
+ *
+ * @return The tuning values used by the current mode.
+ */
+const MovementTuning &Player::GetTuning() const {
+    switch (movementMode) {
+        case MOVEMENT_ICE:
+            return IceTuning::Values;
+        case MOVEMENT_LOW_GRAVITY:
+            return LowGravityTuning::Values;
+        default:
+            return NormalTuning::Values;
+    }
+}
+
+/**
+ * @brief Exports every recorded profiling zone as a Chrome trace.
+ *
+ * @param path The file to write.
+ * @return `true` if the file was written.
+ */
+bool Player::WriteProfileTrace(const String &path) const {
+    return Profiler::WriteChromeTrace(std::string(path.utf8().get_data()));
+}
+
+/**
+ * @brief Starts writing the binary trace log.
+ *
+ * @param path The file to write.
+ * @return `true` if the log was started.
+ */
+bool Player::StartBinaryLog(const String &path) {
+    return BinaryLog::Start(std::string(path.utf8().get_data()));
+}
+
+/**
+ * @brief Stops writing the binary trace log and closes the file.
+ */
+void Player::StopBinaryLog() {
+    BinaryLog::Stop();
+}
+
+/**
+ * @brief Starts recording the player's state every tick into columnar telemetry files.
+ *
+ * @param directory An existing directory to write the column files into.
+ * @return `true` if every column file was opened.
+ */
+bool Player::StartTelemetry(const String &directory) {
+    telemetry = std::make_unique<TelemetryRecorder>(std::string(directory.utf8().get_data()));
+    if (!telemetry->IsOpen()) {
+        telemetry.reset();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Stops recording telemetry and flushes the last chunk.
+ */
+void Player::StopTelemetry() {
+    telemetry.reset();
+}
+
+/**
+ * @brief Starts streaming the player's state every tick to a ghost race relay over UDP.
+ *
+ * @param host Dotted IPv4 address of the relay.
+ * @param port UDP port of the relay.
+ * @param ghostId The id other racers see this player under.
+ * @return `true` if the socket was opened.
+ */
+bool Player::StartGhostStream(const String &host, int port, int ghostId) {
+    UdpAddress relay;
+    if (!UdpAddress::Parse(std::string(host.utf8().get_data()), static_cast<uint16_t>(port), relay)) {
+        return false;
+    }
+    ghostSender = std::make_unique<GhostSender>(relay, static_cast<uint16_t>(ghostId));
+    if (!ghostSender->IsOpen()) {
+        ghostSender.reset();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Stops streaming the player's state.
+ */
+void Player::StopGhostStream() {
+    ghostSender.reset();
+}
+
+/**
+ * @brief Adds a wind or updraft zone that accelerates the player while inside it.
+ *
+ * @param area The zone in global coordinates.
+ * @param force The acceleration inside the zone.
+ * @param fade The distance over which the force falls to zero at the zone's edges.
+ */
+void Player::AddWindZone(const Rect2 &area, const Vector2 &force, double fade) {
+    const Rect2 zone = area.abs();
+    wind.AddZone(ForceZone{Aabb{zone.position.x, zone.position.y, zone.position.x + zone.size.x,
+                                zone.position.y + zone.size.y}, force.x, force.y, static_cast<float>(fade)});
+}
+
+/**
+ * @brief Removes every wind and updraft zone.
+ */
+void Player::ClearWindZones() {
+    wind.Clear();
+}
+
+/**
+ * @brief Gets the number of wind and updraft zones.
+ */
+int64_t Player::GetWindZoneCount() const {
+    return static_cast<int64_t>(wind.GetZoneCount());
+}
+
+/**
+ * @brief Replaces the player's velocity, such as when letting go of a swinging rope.
+ *
+ * @param newVelocity The velocity to continue with, in pixels per second.
+ */
+void Player::Launch(const Vector2 &newVelocity) {
+    velocity = newVelocity;
+}
+
+/**
+ * @brief Starts saving the player, their progress and the level changes to a file at a fixed interval.
+ *
+ * @param path The save file.
+ * @param interval Seconds between saves.
+ * @return `true` if autosave was started.
+ */
+bool Player::StartAutosave(const String &path, double interval) {
+    if (path.is_empty() || interval <= 0.0) {
+        return false;
+    }
+    autosaver = std::make_unique<Autosaver>(std::string(path.utf8().get_data()));
+    autosaveInterval = interval;
+    sinceAutosave = 0.0;
+    return true;
+}
+
+/**
+ * @brief Saves one last time, waits for the file to be written and stops autosaving.
+ */
+void Player::StopAutosave() {
+    if (!autosaver) {
+        return;
+    }
+    UpdateSaveState();
+    autosaver->Snapshot(saveState);
+    autosaver.reset(); // Writes the last snapshot before the thread stops
+}
+
+/**
+ * @brief Restores the player, their progress and the recorded level changes from a save file.
+ *
+ * @param path The save file.
+ * @return `false` if the file could not be loaded or belongs to another level.
+ */
+bool Player::LoadSave(const String &path) {
+    SaveFile file;
+    if (!file.Load(std::string(path.utf8().get_data()))) {
+        return false;
+    }
+    const SaveView &view = file.GetView();
+    const SaveProgress *progress = view.GetProgress();
+    if (progress && progress->levelId != levelId) {
+        return false; // Its holes would be cut into the wrong level
+    }
+    if (const SavePlayer *saved = view.GetPlayer()) {
+        set_global_position(Vector2(saved->positionX, saved->positionY));
+        velocity = Vector2(saved->velocityX, saved->velocityY);
+        SetMovementMode(static_cast<int>(saved->mode));
+        canJump = saved->canJump != 0;
+    }
+    if (progress) {
+        saveState.progress = *progress;
+    }
+    const std::span<const SaveMutation> mutations = view.GetMutations();
+    saveState.mutations.assign(mutations.begin(), mutations.end());
+
+    // Cut the holes again in the order they were made, so every system ends up with the same solids
+    const Array holes = GetSaveMutations();
+    for (int64_t target = 0; target < carveTargets.size(); ++target) {
+        Node *node = get_node_or_null(carveTargets[target]);
+        if (!node || !node->has_method("Carve")) {
+            continue;
+        }
+        for (int64_t hole = 0; hole < holes.size(); ++hole) {
+            node->call("Carve", holes[hole]);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Records a hole carved into the level, so saves can restore it.
+ *
+ * @param hole The carved area in global coordinates.
+ */
+void Player::AddSaveMutation(const Rect2 &hole) {
+    const Rect2 area = hole.abs();
+    SaveMutation mutation;
+    mutation.minX = area.position.x;
+    mutation.minY = area.position.y;
+    mutation.maxX = area.position.x + area.size.x;
+    mutation.maxY = area.position.y + area.size.y;
+    saveState.mutations.push_back(mutation);
+}
+
+/**
+ * @brief Gets the recorded level changes as `Rect2` holes, oldest first.
+ */
+Array Player::GetSaveMutations() const {
+    Array holes;
+    for (const SaveMutation &mutation : saveState.mutations) {
+        holes.push_back(Rect2(mutation.minX, mutation.minY, mutation.maxX - mutation.minX,
+                              mutation.maxY - mutation.minY));
+    }
+    return holes;
+}
+
+/**
+ * @brief Gets the highest point reached, in pixels above the spawn.
+ */
+double Player::GetBestHeight() const {
+    return saveState.progress.bestHeight;
+}
+
+/**
+ * @brief Copies the player's current state and level into `saveState`.
+ */
+void Player::UpdateSaveState() {
+    const Vector2 position = get_global_position();
+    saveState.progress.levelId = levelId;
+    saveState.player = SavePlayer{position.x, position.y, velocity.x, velocity.y,
+                                  static_cast<uint32_t>(movementMode), canJump ? 1u : 0u,
+                                  Engine::get_singleton()->get_physics_frames()};
 }
 
 /**
  * @brief Stream insertion operator for the Player class.
  *
- * Outputs the Player's state (movement direction, speed, gravity, and jump ability)
+ * Outputs the Player's state (movement direction, tuning of the current mode, and jump ability)
  * to the given output stream.
  *
  * @param os The output stream.
@@ -74,8 +438,8 @@ void Player::_physics_process(float delta) {
 std::ostream &operator<<(std::ostream &os, const Player &player) {
     os << "Player("
             << "MovementDirection: (" << player.movementDirection.x << ", " << player.movementDirection.y << "), "
-            << "MovementSpeed: (" << player.movementSpeed.x << ", " << player.movementSpeed.y << "), "
-            << "GravityForce: " << player.gravityForce << ", "
+            << "MovementMode: " << player.movementMode << ", "
+            << player.GetTuning() << ", "
             << "CanJump: " << (player.canJump ? "true" : "false") << ")";
     return os;
 }
@@ -89,4 +453,29 @@ std::ostream &operator<<(std::ostream &os, const Player &player) {
 void Player::_bind_methods() {
     ClassDB::bind_method(D_METHOD("_ready"), &Player::_ready);
     ClassDB::bind_method(D_METHOD("_physics_process", "delta"), &Player::_physics_process);
+    ClassDB::bind_method(D_METHOD("GetMovementMode"), &Player::GetMovementMode);
+    ClassDB::bind_method(D_METHOD("SetMovementMode", "mode"), &Player::SetMovementMode);
+    ClassDB::bind_method(D_METHOD("WriteProfileTrace", "path"), &Player::WriteProfileTrace);
+    ClassDB::bind_method(D_METHOD("StartBinaryLog", "path"), &Player::StartBinaryLog);
+    ClassDB::bind_method(D_METHOD("StopBinaryLog"), &Player::StopBinaryLog);
+    ClassDB::bind_method(D_METHOD("StartTelemetry", "directory"), &Player::StartTelemetry);
+    ClassDB::bind_method(D_METHOD("StopTelemetry"), &Player::StopTelemetry);
+    ClassDB::bind_method(D_METHOD("StartGhostStream", "host", "port", "ghost_id"), &Player::StartGhostStream);
+    ClassDB::bind_method(D_METHOD("StopGhostStream"), &Player::StopGhostStream);
+    ClassDB::bind_method(D_METHOD("AddWindZone", "area", "force", "fade"), &Player::AddWindZone);
+    ClassDB::bind_method(D_METHOD("ClearWindZones"), &Player::ClearWindZones);
+    ClassDB::bind_method(D_METHOD("GetWindZoneCount"), &Player::GetWindZoneCount);
+    ClassDB::bind_method(D_METHOD("Launch", "velocity"), &Player::Launch);
+    ClassDB::bind_method(D_METHOD("StartAutosave", "path", "interval"), &Player::StartAutosave);
+    ClassDB::bind_method(D_METHOD("StopAutosave"), &Player::StopAutosave);
+    ClassDB::bind_method(D_METHOD("LoadSave", "path"), &Player::LoadSave);
+    ClassDB::bind_method(D_METHOD("AddSaveMutation", "hole"), &Player::AddSaveMutation);
+    ClassDB::bind_method(D_METHOD("GetSaveMutations"), &Player::GetSaveMutations);
+    ClassDB::bind_method(D_METHOD("GetBestHeight"), &Player::GetBestHeight);
+    ClassDB::bind_method(D_METHOD("GetLevelId"), &Player::GetLevelId);
+    ClassDB::bind_method(D_METHOD("SetLevelId", "id"), &Player::SetLevelId);
+    ClassDB::bind_method(D_METHOD("GetCarveTargets"), &Player::GetCarveTargets);
+    ClassDB::bind_method(D_METHOD("SetCarveTargets", "targets"), &Player::SetCarveTargets);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "level_id"), "SetLevelId", "GetLevelId");
+    ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "carve_targets"), "SetCarveTargets", "GetCarveTargets");
 }
@@ -3,10 +3,22 @@
 
 // Include necessary Godot headers
 #include <godot_cpp/classes/character_body2d.hpp> // For CharacterBody2D class
-#include <godot_cpp/classes/input.hpp>           // For Input handling
 #include <godot_cpp/variant/vector2.hpp>         // For Vector2 class
 #include <godot_cpp/variant/string_name.hpp>     // For StringName class
+#include <godot_cpp/variant/rect2.hpp>           // For Rect2 class
+#include <godot_cpp/variant/array.hpp>           // For the saved level changes
+#include <godot_cpp/variant/node_path.hpp>       // For the nodes saved holes are carved into
 #include <godot_cpp/core/class_db.hpp>           // For GDCLASS macro
+#include "EnvironmentElement.h"                  // For the elements bodies are made of
+#include "../Core/MovementTuning.h"              // For the movement rules
+#include "../Core/SurfaceEffects.h"              // For statically dispatched surface effects
+#include "../Core/SurfaceMaterial.h"             // For the material of the floor underfoot
+#include "../Core/ForceField.h"                  // For wind and updraft zones
+#include "../include/Telemetry.h"                // For the columnar per-tick recorder
+#include "../include/GhostNet.h"                 // For streaming the player as a ghost
+#include "../include/SaveGame.h"                 // For autosaves
+#include <memory>
+#include <optional>
 
 using namespace godot;
 
@@ -20,27 +32,32 @@ using namespace godot;
 class Player : public CharacterBody2D {
  GDCLASS(Player, CharacterBody2D)
 
-private:
+public:
  /**
-  * @brief The current movement direction of the player.
+  * @brief The movement rules the player currently follows.
   *
-  * A 2D vector representing the player's movement in the X and Y axes.
+  * Each mode maps to a compile-time tuning policy from `MovementTuning.h`.
   */
- Vector2 movementDirection;
+ enum MovementMode {
+  MOVEMENT_NORMAL = 0,
+  MOVEMENT_ICE = 1,
+  MOVEMENT_LOW_GRAVITY = 2,
+ };
 
+private:
  /**
-  * @brief The player's movement speed.
+  * @brief The current movement direction of the player.
   *
-  * A 2D vector representing the player's speed in the X and Y directions.
+  * A 2D vector representing the player's movement in the X and Y axes.
   */
- Vector2 movementSpeed;
+ Vector2 movementDirection;
 
  /**
-  * @brief The gravitational force acting on the player.
+  * @brief The movement rules currently applied to the player.
   *
-  * This constant determines how strongly gravity affects the player's vertical movement.
+  * Selects which tuning policy `_physics_process` steps with, replacing the old runtime speed and gravity fields.
   */
- const float gravityForce;
+ MovementMode movementMode;
 
  /**
   * @brief Indicates whether the player can jump.
@@ -56,6 +73,62 @@ private:
   */
  Vector2 velocity;
 
+ /**
+  * @brief The per-tick telemetry recorder, or null while telemetry is off.
+  */
+ std::unique_ptr<TelemetryRecorder> telemetry;
+
+ /**
+  * @brief Streams the player's state to a ghost relay, or null while not racing.
+  */
+ std::unique_ptr<GhostSender> ghostSender;
+
+ /**
+  * @brief The wind and updraft zones of the level, baked into one grid.
+  */
+ ForceField wind;
+
+ /**
+  * @brief Writes autosaves on a background thread, or null while autosave is off.
+  */
+ std::unique_ptr<Autosaver> autosaver;
+
+ /**
+  * @brief What the next save holds; the player fields are refreshed right before each snapshot.
+  */
+ SaveState saveState;
+
+ /**
+  * @brief Seconds between autosaves, and seconds since the last one.
+  */
+ double autosaveInterval = 0.0;
+ double sinceAutosave = 0.0;
+
+ /**
+  * @brief The height the progress is measured from, set when the player enters the scene.
+  */
+ float spawnY = 0.0f;
+
+ /**
+  * @brief The `World::MakeTower` id of the level the player is in, written into every save.
+  */
+ uint32_t levelId = 0;
+
+ /**
+  * @brief The nodes, as `NodePath`s, that `LoadSave` carves the saved holes into.
+  */
+ Array carveTargets;
+
+ /**
+  * @brief Copies the player's current state and level into `saveState`.
+  */
+ void UpdateSaveState();
+
+ /**
+  * @brief The material of the element the player last landed on, or empty on plain floors and in the air.
+  */
+ std::optional<SurfaceMaterial> floorMaterial;
+
 public:
  /**
   * @brief Default constructor for the Player class.
@@ -103,6 +176,167 @@ public:
   */
  void _physics_process(float delta);
 
+ /**
+  * @brief Gets the movement mode of the player.
+  *
+  * @return The current movement mode as an integer, for use from scripts.
+  */
+ int GetMovementMode() const;
+
+ /**
+  * @brief Sets the movement mode of the player.
+  *
+  * Levels call this when the player enters or leaves ice and low-gravity sections.
+  *
+  * @param mode The new movement mode.
+  */
+ void SetMovementMode(int mode);
+
+ /**
+  * @brief Gets the tuning values of the current movement mode.
+  *
+  * @return The tuning values used by the current mode.
+  */
+ const MovementTuning &GetTuning() const;
+
+ /**
+  * @brief Exports every recorded profiling zone as a Chrome trace.
+  *
+  * Does nothing useful unless the extension was built with `OOP_PROFILING`.
+  *
+  * @param path The file to write.
+  * @return `true` if the file was written.
+  */
+ bool WriteProfileTrace(const String &path) const;
+
+ /**
+  * @brief Starts writing the binary trace log, which records the player's state every tick.
+  *
+  * Decode the file offline with `oop_logdecode`.
+  *
+  * @param path The file to write.
+  * @return `true` if the log was started.
+  */
+ bool StartBinaryLog(const String &path);
+
+ /**
+  * @brief Stops writing the binary trace log and closes the file.
+  */
+ void StopBinaryLog();
+
+ /**
+  * @brief Starts recording the player's state every tick into columnar telemetry files.
+  *
+  * One compressed file per column is written into the directory; read them back with `TelemetryColumnReader`.
+  *
+  * @param directory An existing directory to write the column files into.
+  * @return `true` if every column file was opened.
+  */
+ bool StartTelemetry(const String &directory);
+
+ /**
+  * @brief Stops recording telemetry and flushes the last chunk.
+  */
+ void StopTelemetry();
+
+ /**
+  * @brief Starts streaming the player's state every tick to a ghost race relay over UDP.
+  *
+  * @param host Dotted IPv4 address of the relay.
+  * @param port UDP port of the relay.
+  * @param ghostId The id other racers see this player under.
+  * @return `true` if the socket was opened.
+  */
+ bool StartGhostStream(const String &host, int port, int ghostId);
+
+ /**
+  * @brief Stops streaming the player's state.
+  */
+ void StopGhostStream();
+
+ /**
+  * @brief Adds a wind or updraft zone that accelerates the player while inside it.
+  *
+  * Overlapping zones add up. Horizontal wind only builds up speed where the movement mode has low
+  * traction, such as on ice, since the other modes set the running speed every tick.
+  *
+  * @param area The zone in global coordinates.
+  * @param force The acceleration inside the zone, in pixels per second squared (negative Y is up).
+  * @param fade The distance over which the force falls to zero at the zone's edges.
+  */
+ void AddWindZone(const Rect2 &area, const Vector2 &force, double fade);
+
+ /**
+  * @brief Removes every wind and updraft zone.
+  */
+ void ClearWindZones();
+
+ /**
+  * @brief Gets the number of wind and updraft zones.
+  */
+ int64_t GetWindZoneCount() const;
+
+ /**
+  * @brief Replaces the player's velocity, such as when letting go of a swinging rope.
+  *
+  * @param newVelocity The velocity to continue with, in pixels per second.
+  */
+ void Launch(const Vector2 &newVelocity);
+
+ /**
+  * @brief Starts saving the player, their progress and the level changes to a file at a fixed interval.
+  *
+  * Each autosave only copies the state on the physics thread; compressing and writing the file happen on a
+  * background thread.
+  *
+  * @param path The save file.
+  * @param interval Seconds between saves.
+  * @return `true` if autosave was started.
+  */
+ bool StartAutosave(const String &path, double interval);
+
+ /**
+  * @brief Saves one last time, waits for the file to be written and stops autosaving.
+  */
+ void StopAutosave();
+
+ /**
+  * @brief Restores the player, their progress and the recorded level changes from a save file.
+  *
+  * The saved holes are carved again, oldest first, into every node of `carve_targets` with a `Carve` method,
+  * such as the level's `HazardSystem` and `RopeSystem`.
+  *
+  * @param path The save file.
+  * @return `false` if the file is missing, from a newer version, corrupt or saved on another level; nothing
+  *         is restored then.
+  */
+ bool LoadSave(const String &path);
+
+ /**
+  * @brief Records a hole carved into the level, so saves can restore it.
+  *
+  * @param hole The carved area in global coordinates.
+  */
+ void AddSaveMutation(const Rect2 &hole);
+
+ /**
+  * @brief Gets the recorded level changes as `Rect2` holes, oldest first.
+  */
+ Array GetSaveMutations() const;
+
+ /**
+  * @brief Gets the highest point reached, in pixels above the spawn.
+  */
+ double GetBestHeight() const;
+
+ int64_t GetLevelId() const { return levelId; }
+
+ void SetLevelId(int64_t id) { levelId = static_cast<uint32_t>(id); }
+
+ Array GetCarveTargets() const { return carveTargets; }
+
+ void SetCarveTargets(const Array &targets) { carveTargets = targets; }
+
  /**
   * @brief Binds methods to Godot for use in the editor or scripts.
   *
@@ -0,0 +1,217 @@
+#include "RopeSystem.h"
+#include "InputActions.h"
+#include "Player.h"
+#include "../include/Profiler.h"
+#include <godot_cpp/variant/color.hpp> // For the rope colour
+#include <algorithm>
+
+void RopeSystem::_ready() {
+    solver = std::make_unique<RopeSolver>();
+}
+
+void RopeSystem::_physics_process(double delta) {
+    // A tick of zero length moves nothing, and `lastDelta` divides the rope motion into a velocity
+    if (!solver || ropes.GetCount() == 0 || delta <= 0.0) {
+        return;
+    }
+    PROFILE_ZONE("RopeSystem::_physics_process");
+    lastDelta = static_cast<float>(delta);
+
+    if (solidsChanged) {
+        world.BuildGrid();
+        solidsChanged = false;
+    }
+
+    Player *player = holding ? GetPlayer() : nullptr;
+    if (holding && player == nullptr) {
+        Release();
+    }
+    if (player != nullptr) {
+        const InputSnapshot &input = InputActions::GetCurrent();
+        if (input.WasPressed(InputAction::Jump)) {
+            float x, y;
+            ropes.GetMotion(heldRope, heldNode, x, y);
+            Release();
+            player->Launch(Vector2(x, y) / lastDelta + Vector2(0.0f, MovementConstants::JumpImpulse));
+            player = nullptr;
+        } else {
+            const float direction = static_cast<float>(input.IsHeld(InputAction::Right)) -
+                                    static_cast<float>(input.IsHeld(InputAction::Left));
+            ropes.Push(heldRope, heldNode, direction * swingForce * lastDelta * lastDelta, 0.0f);
+        }
+    }
+
+    solver->Step(ropes, lastDelta, gravity, world, iterations);
+
+    if (player != nullptr) {
+        float x, y;
+        ropes.GetNode(heldRope, heldNode, x, y);
+        player->set_global_position(Vector2(x, y) - handOffset);
+    }
+    queue_redraw();
+}
+
+void RopeSystem::_draw() {
+    PROFILE_ZONE("RopeSystem::_draw");
+    // Ropes live in global coordinates, whatever this node's own transform
+    draw_set_transform_matrix(get_global_transform().affine_inverse());
+    const Color color(0.6f, 0.45f, 0.25f);
+    for (std::size_t rope = 0; rope < ropes.GetCount(); ++rope) {
+        float fromX, fromY;
+        ropes.GetNode(rope, 0, fromX, fromY);
+        for (std::size_t node = 1; node < ropes.GetNodesPerRope(); ++node) {
+            float toX, toY;
+            ropes.GetNode(rope, node, toX, toY);
+            draw_line(Vector2(fromX, fromY), Vector2(toX, toY), color, 2.0f);
+            fromX = toX;
+            fromY = toY;
+        }
+    }
+}
+
+int64_t RopeSystem::AddRope(const Vector2 &anchor) {
+    return static_cast<int64_t>(ropes.Add(anchor.x, anchor.y, segmentLength));
+}
+
+void RopeSystem::ClearRopes() {
+    if (holding) {
+        Release();
+    }
+    ropes.Clear();
+    queue_redraw();
+}
+
+void RopeSystem::SetNodesPerRope(int64_t nodes) {
+    if (ropes.GetCount() == 0) {
+        ropes = Ropes(static_cast<std::size_t>(std::max<int64_t>(nodes, 2)));
+    }
+}
+
+void RopeSystem::AddSolid(const Rect2 &box) {
+    const Rect2 solid = box.abs();
+    world.solids.push_back(Aabb{solid.position.x, solid.position.y, solid.position.x + solid.size.x,
+                                solid.position.y + solid.size.y});
+    solidsChanged = true;
+}
+
+void RopeSystem::ClearSolids() {
+    world.solids.clear();
+    world.freeSolids.clear();
+    solidsChanged = true;
+}
+
+int64_t RopeSystem::Carve(const Rect2 &hole) {
+    if (solidsChanged) {
+        world.BuildGrid();
+        solidsChanged = false;
+    }
+    const Rect2 area = hole.abs();
+    const std::size_t cut = world.Carve(Aabb{area.position.x, area.position.y, area.position.x + area.size.x,
+                                             area.position.y + area.size.y});
+    Aabb region{};
+    if (world.TakeDirtyRegion(region)) {
+        emit_signal("solids_changed", Rect2(region.minX, region.minY, region.maxX - region.minX,
+                                            region.maxY - region.minY));
+    }
+    return static_cast<int64_t>(cut);
+}
+
+Array RopeSystem::GetSolids(const Rect2 &area) const {
+    const Rect2 bounds = area.abs();
+    const Aabb query{bounds.position.x, bounds.position.y, bounds.position.x + bounds.size.x,
+                     bounds.position.y + bounds.size.y};
+    Array solids;
+    for (const Aabb &solid: world.solids) {
+        if (World::IsSolid(solid) && solid.Overlaps(query)) {
+            solids.push_back(Rect2(solid.minX, solid.minY, solid.maxX - solid.minX, solid.maxY - solid.minY));
+        }
+    }
+    return solids;
+}
+
+bool RopeSystem::Grab() {
+    Player *player = GetPlayer();
+    if (holding || player == nullptr) {
+        return false;
+    }
+    const Vector2 hands = player->get_global_position() + handOffset;
+    if (!ropes.FindNearest(hands.x, hands.y, grabRadius, heldRope, heldNode)) {
+        return false;
+    }
+    holding = true;
+    ropes.SetInverseMass(heldRope, heldNode, Ropes::NodeInverseMass / playerWeight);
+    // The rope moves the player now; the player's own movement would fight it
+    player->set_physics_process(false);
+    return true;
+}
+
+void RopeSystem::Release() {
+    if (!holding) {
+        return;
+    }
+    holding = false;
+    ropes.SetInverseMass(heldRope, heldNode, Ropes::NodeInverseMass);
+    if (Player *player = GetPlayer()) {
+        float x, y;
+        ropes.GetMotion(heldRope, heldNode, x, y);
+        player->Launch(Vector2(x, y) / lastDelta);
+        player->set_physics_process(true);
+    }
+}
+
+void RopeSystem::Climb(int64_t nodes) {
+    if (!holding) {
+        return;
+    }
+    const auto last = static_cast<int64_t>(ropes.GetNodesPerRope()) - 1;
+    const auto next = static_cast<std::size_t>(std::clamp(static_cast<int64_t>(heldNode) - nodes, int64_t{1}, last));
+    ropes.SetInverseMass(heldRope, heldNode, Ropes::NodeInverseMass);
+    heldNode = next;
+    ropes.SetInverseMass(heldRope, heldNode, Ropes::NodeInverseMass / playerWeight);
+}
+
+Player *RopeSystem::GetPlayer() const {
+    return playerPath.is_empty() ? nullptr : Object::cast_to<Player>(get_node_or_null(playerPath));
+}
+
+void RopeSystem::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("AddRope", "anchor"), &RopeSystem::AddRope);
+    ClassDB::bind_method(D_METHOD("ClearRopes"), &RopeSystem::ClearRopes);
+    ClassDB::bind_method(D_METHOD("AddSolid", "box"), &RopeSystem::AddSolid);
+    ClassDB::bind_method(D_METHOD("ClearSolids"), &RopeSystem::ClearSolids);
+    ClassDB::bind_method(D_METHOD("Carve", "hole"), &RopeSystem::Carve);
+    ClassDB::bind_method(D_METHOD("GetSolids", "area"), &RopeSystem::GetSolids);
+    ClassDB::bind_method(D_METHOD("Grab"), &RopeSystem::Grab);
+    ClassDB::bind_method(D_METHOD("Release"), &RopeSystem::Release);
+    ClassDB::bind_method(D_METHOD("Climb", "nodes"), &RopeSystem::Climb);
+    ClassDB::bind_method(D_METHOD("IsHolding"), &RopeSystem::IsHolding);
+    ClassDB::bind_method(D_METHOD("GetRopeCount"), &RopeSystem::GetRopeCount);
+    ClassDB::bind_method(D_METHOD("GetNodesPerRope"), &RopeSystem::GetNodesPerRope);
+    ClassDB::bind_method(D_METHOD("SetNodesPerRope", "nodes"), &RopeSystem::SetNodesPerRope);
+    ClassDB::bind_method(D_METHOD("GetSegmentLength"), &RopeSystem::GetSegmentLength);
+    ClassDB::bind_method(D_METHOD("SetSegmentLength", "length"), &RopeSystem::SetSegmentLength);
+    ClassDB::bind_method(D_METHOD("GetGravity"), &RopeSystem::GetGravity);
+    ClassDB::bind_method(D_METHOD("SetGravity", "gravity"), &RopeSystem::SetGravity);
+    ClassDB::bind_method(D_METHOD("GetIterations"), &RopeSystem::GetIterations);
+    ClassDB::bind_method(D_METHOD("SetIterations", "iterations"), &RopeSystem::SetIterations);
+    ClassDB::bind_method(D_METHOD("GetPlayerPath"), &RopeSystem::GetPlayerPath);
+    ClassDB::bind_method(D_METHOD("SetPlayerPath", "path"), &RopeSystem::SetPlayerPath);
+    ClassDB::bind_method(D_METHOD("GetGrabRadius"), &RopeSystem::GetGrabRadius);
+    ClassDB::bind_method(D_METHOD("SetGrabRadius", "radius"), &RopeSystem::SetGrabRadius);
+    ClassDB::bind_method(D_METHOD("GetHandOffset"), &RopeSystem::GetHandOffset);
+    ClassDB::bind_method(D_METHOD("SetHandOffset", "offset"), &RopeSystem::SetHandOffset);
+    ClassDB::bind_method(D_METHOD("GetSwingForce"), &RopeSystem::GetSwingForce);
+    ClassDB::bind_method(D_METHOD("SetSwingForce", "force"), &RopeSystem::SetSwingForce);
+    ClassDB::bind_method(D_METHOD("GetPlayerWeight"), &RopeSystem::GetPlayerWeight);
+    ClassDB::bind_method(D_METHOD("SetPlayerWeight", "weight"), &RopeSystem::SetPlayerWeight);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "nodes_per_rope"), "SetNodesPerRope", "GetNodesPerRope");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "segment_length"), "SetSegmentLength", "GetSegmentLength");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "gravity"), "SetGravity", "GetGravity");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "iterations"), "SetIterations", "GetIterations");
+    ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "player_path"), "SetPlayerPath", "GetPlayerPath");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "grab_radius"), "SetGrabRadius", "GetGrabRadius");
+    ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "hand_offset"), "SetHandOffset", "GetHandOffset");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "swing_force"), "SetSwingForce", "GetSwingForce");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "player_weight"), "SetPlayerWeight", "GetPlayerWeight");
+    ADD_SIGNAL(MethodInfo("solids_changed", PropertyInfo(Variant::RECT2, "region")));
+}
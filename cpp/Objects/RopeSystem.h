@@ -0,0 +1,187 @@
+#ifndef ROPESYSTEM_H
+#define ROPESYSTEM_H
+
+#include <godot_cpp/classes/node2d.hpp>         // For Node2D class
+#include <godot_cpp/core/class_db.hpp>          // For GDCLASS macro
+#include <godot_cpp/variant/array.hpp>          // For the solids handed to the scene
+#include <godot_cpp/variant/node_path.hpp>      // For the player path
+#include <godot_cpp/variant/rect2.hpp>          // For Rect2 class
+#include "../Core/MovementConstants.h"          // For the default gravity
+#include "../Core/Ropes.h"                      // For the rope nodes
+#include "../Core/World.h"                      // For the solids ropes rest against
+#include "../include/RopeSolver.h"              // For the worker threads
+#include <cstdint>
+#include <memory>
+
+using namespace godot;
+
+class Player;
+
+/**
+ * @class RopeSystem
+ * @brief Simulates, draws and lets the player climb every rope of a level from one node.
+ *
+ * Ropes hang from the anchors added with `AddRope` and rest against the solids added with `AddSolid`, usually
+ * the level's walls and ledges. `Grab` attaches the node at `player_path` to the closest rope node within
+ * reach: from then on the rope carries the player, left and right swing it, and jumping lets go with the
+ * rope's momentum. The batches of ropes are stepped on a `RopeSolver`'s worker threads.
+ */
+class RopeSystem : public Node2D {
+    GDCLASS(RopeSystem, Node2D)
+
+public:
+    /**
+     * @brief Starts the worker threads.
+     */
+    void _ready() override;
+
+    /**
+     * @brief Applies the player's swing, steps every rope, and moves the player along with the held rope.
+     *
+     * @param delta The time elapsed since the previous tick.
+     */
+    void _physics_process(double delta) override;
+
+    /**
+     * @brief Draws every rope as a line strip.
+     */
+    void _draw() override;
+
+    /**
+     * @brief Adds a rope hanging straight down.
+     *
+     * @param anchor Where the rope is fixed, in global coordinates.
+     * @return The index of the new rope.
+     */
+    int64_t AddRope(const Vector2 &anchor);
+
+    /**
+     * @brief Removes every rope, letting go of the held one.
+     */
+    void ClearRopes();
+
+    /**
+     * @brief Adds a box ropes rest against, in global coordinates.
+     */
+    void AddSolid(const Rect2 &box);
+
+    /**
+     * @brief Removes every solid.
+     */
+    void ClearSolids();
+
+    /**
+     * @brief Cuts a hole out of the solids ropes rest against, such as a wall or floor crumbling.
+     *
+     * Only the solids around the hole and their grid cells are updated, so this is cheap enough to call
+     * every tick.
+     *
+     * Emits `solids_changed` with the area whose solids changed. This node only keeps its own copy of the
+     * solids, so the scene refits its collision shapes there from `GetSolids`.
+     *
+     * @param hole The area to clear, in global coordinates.
+     * @return The number of solids that were cut.
+     */
+    int64_t Carve(const Rect2 &hole);
+
+    /**
+     * @brief Gets the solids ropes rest against that overlap an area, such as the one reported by `solids_changed`.
+     *
+     * @param area The area to search, in global coordinates.
+     * @return The solids as `Rect2`s.
+     */
+    Array GetSolids(const Rect2 &area) const;
+
+    /**
+     * @brief Attaches the player to the closest rope node within `grab_radius` of their hands.
+     *
+     * @return `false` if no rope is within reach or the player is already holding one.
+     */
+    bool Grab();
+
+    /**
+     * @brief Lets go of the held rope, keeping the rope's velocity.
+     */
+    void Release();
+
+    /**
+     * @brief Moves the player's grip along the held rope.
+     *
+     * @param nodes How many nodes to climb; positive is up towards the anchor.
+     */
+    void Climb(int64_t nodes);
+
+    bool IsHolding() const { return holding; }
+
+    int64_t GetRopeCount() const { return static_cast<int64_t>(ropes.GetCount()); }
+
+    int64_t GetNodesPerRope() const { return static_cast<int64_t>(ropes.GetNodesPerRope()); }
+
+    /**
+     * @brief Sets the node count of new ropes; only takes effect while there are no ropes.
+     */
+    void SetNodesPerRope(int64_t nodes);
+
+    double GetSegmentLength() const { return segmentLength; }
+
+    void SetSegmentLength(double length) { segmentLength = static_cast<float>(length); }
+
+    double GetGravity() const { return gravity; }
+
+    void SetGravity(double newGravity) { gravity = static_cast<float>(newGravity); }
+
+    int64_t GetIterations() const { return iterations; }
+
+    void SetIterations(int64_t newIterations) { iterations = static_cast<int>(newIterations > 1 ? newIterations : 1); }
+
+    NodePath GetPlayerPath() const { return playerPath; }
+
+    void SetPlayerPath(const NodePath &path) { playerPath = path; }
+
+    double GetGrabRadius() const { return grabRadius; }
+
+    void SetGrabRadius(double radius) { grabRadius = static_cast<float>(radius); }
+
+    Vector2 GetHandOffset() const { return handOffset; }
+
+    void SetHandOffset(const Vector2 &offset) { handOffset = offset; }
+
+    double GetSwingForce() const { return swingForce; }
+
+    void SetSwingForce(double force) { swingForce = static_cast<float>(force); }
+
+    double GetPlayerWeight() const { return playerWeight; }
+
+    void SetPlayerWeight(double weight) { playerWeight = static_cast<float>(weight > 0.01 ? weight : 0.01); }
+
+protected:
+    /**
+     * @brief Binds methods to Godot for use in the editor or scripts.
+     */
+    static void _bind_methods();
+
+private:
+    /**
+     * @brief Gets the node at `player_path`, or null if there is none.
+     */
+    Player *GetPlayer() const;
+
+    Ropes ropes{48};
+    std::unique_ptr<RopeSolver> solver;
+    World world;
+    bool solidsChanged = false;
+    float segmentLength = 6.0f;
+    float gravity = MovementConstants::Gravity * MovementConstants::TicksPerSecond;
+    int iterations = Ropes::DefaultIterations;
+    NodePath playerPath;
+    float grabRadius = 24.0f;
+    Vector2 handOffset{0.0f, -12.0f}; // From the player's origin to their hands
+    float swingForce = 600.0f;
+    float playerWeight = 10.0f; // In rope nodes
+    float lastDelta = MovementConstants::TickDelta;
+    bool holding = false;
+    std::size_t heldRope = 0;
+    std::size_t heldNode = 0;
+};
+
+#endif // ROPESYSTEM_H
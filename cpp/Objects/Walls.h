@@ -5,7 +5,7 @@
 #ifndef WALLS_H
 #define WALLS_H
 
-#include "Environment.h"
+#include "EnvironmentElement.h"
 #include <array>
 #include <iostream>
 
@@ -13,21 +13,22 @@
  * @class Walls
  * @brief Represents a collection of environmental elements forming walls.
  *
- * This class manages the dimensions and coordinates of walls in the game world.
+ * This class manages the dimensions and coordinates of walls in the game world. Walls stop the player from
+ * pushing into them.
  */
-class Walls : public Environment {
-    GDCLASS(Walls, Environment) // Godot class registration
+class Walls : public EnvironmentElement {
+    GDCLASS(Walls, EnvironmentElement) // Godot class registration
 
 private:
     /**
      * @brief Array of coordinates defining the positions of the walls.
      */
-    std::array<Environment, 4> coordinates;
+    std::array<EnvironmentElement, 4> coordinates;
 
     /**
      * @brief Array of dimensions defining the sizes of the walls.
      */
-    std::array<Environment, 4> dimensions;
+    std::array<EnvironmentElement, 4> dimensions;
 
 public:
     /**
@@ -38,9 +39,10 @@ public:
      * @param newCoordinates The array of coordinates for the walls.
      * @param newDimensions The array of dimensions for the walls.
      */
-    Walls(const std::array<Environment, 4> &newCoordinates,
-          const std::array<Environment, 4> &newDimensions)
-        : coordinates(newCoordinates), dimensions(newDimensions) {
+    Walls(const std::array<EnvironmentElement, 4> &newCoordinates,
+          const std::array<EnvironmentElement, 4> &newDimensions)
+        : EnvironmentElement(SurfaceKind::Wall, SurfaceMaterials::Ground), coordinates(newCoordinates),
+          dimensions(newDimensions) {
     }
 
     /**
@@ -51,7 +53,7 @@ public:
      * @param other The Walls instance to copy from.
      */
     Walls(const Walls &other)
-        : Environment(other), coordinates(other.coordinates), dimensions(other.dimensions) {
+        : EnvironmentElement(other), coordinates(other.coordinates), dimensions(other.dimensions) {
     }
 
     /**
@@ -65,7 +67,7 @@ public:
     Walls &operator=(const Walls &other) {
         if (this != &other) {
             // Avoid self-assignment
-            Environment::operator=(other);
+            EnvironmentElement::operator=(other);
             coordinates = other.coordinates;
             dimensions = other.dimensions;
         }
@@ -97,16 +99,16 @@ public:
     /**
      * @brief Gets the coordinates of the walls.
      *
-     * @return An array of Environment instances representing the wall coordinates.
+     * @return An array of EnvironmentElement instances representing the wall coordinates.
      */
-    std::array<Environment, 4> GetCoordinates() const { return coordinates; }
+    std::array<EnvironmentElement, 4> GetCoordinates() const { return coordinates; }
 
     /**
      * @brief Gets the dimensions of the walls.
      *
-     * @return An array of Environment instances representing the wall dimensions.
+     * @return An array of EnvironmentElement instances representing the wall dimensions.
      */
-    std::array<Environment, 4> GetDimensions() const { return dimensions; }
+    std::array<EnvironmentElement, 4> GetDimensions() const { return dimensions; }
 
     /**
      * @brief Binds methods to Godot for use in the editor or scripts.
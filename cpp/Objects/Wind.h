@@ -0,0 +1,156 @@
+#ifndef WIND_H
+#define WIND_H
+
+#include "EnvironmentElement.h"
+#include "../Core/ForceField.h"
+#include <godot_cpp/variant/rect2.hpp>
+#include <iostream>
+
+/**
+ * @class Wind
+ * @brief Represents a zone of wind or updraft in the game world that pushes the player while inside it.
+ *
+ * A wind zone has no surface to touch, so instead of a `SurfaceEffect` it hands out a `ForceZone`, which the
+ * level bakes into the player's `ForceField` (see `Player::AddWindZone`).
+ */
+class Wind : public EnvironmentElement {
+    GDCLASS(Wind, EnvironmentElement) // Godot class registration
+
+private:
+    /**
+     * @brief The zone in global coordinates.
+     */
+    Rect2 area;
+
+    /**
+     * @brief The acceleration inside the zone, in pixels per second squared (negative Y is up).
+     */
+    Vector2 force;
+
+    /**
+     * @brief The distance over which the force falls to zero at the zone's edges.
+     */
+    float fade;
+
+public:
+    /**
+     * @brief Constructor for the Wind class.
+     *
+     * @param newArea The zone in global coordinates.
+     * @param newForce The acceleration inside the zone.
+     * @param newFade The distance over which the force falls to zero at the zone's edges.
+     */
+    Wind(const Rect2 &newArea = Rect2(), const Vector2 &newForce = Vector2(), float newFade = 16.0f)
+        : area(newArea), force(newForce), fade(newFade) {
+    }
+
+    /**
+     * @brief Copy constructor for the Wind class.
+     *
+     * @param other The Wind instance to copy from.
+     */
+    Wind(const Wind &other)
+        : EnvironmentElement(other), area(other.area), force(other.force), fade(other.fade) {
+    }
+
+    /**
+     * @brief Assignment operator for the Wind class.
+     *
+     * @param other The Wind instance to copy data from.
+     * @return A reference to the updated Wind instance.
+     */
+    Wind &operator=(const Wind &other) {
+        if (this != &other) {
+            // Avoid self-assignment
+            EnvironmentElement::operator=(other);
+            area = other.area;
+            force = other.force;
+            fade = other.fade;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Stream insertion operator for the Wind class.
+     *
+     * @param os The output stream.
+     * @param wind The Wind instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const Wind &wind) {
+        os << "Wind(" << wind.GetZone() << ")";
+        return os;
+    }
+
+    /**
+     * @brief Gets the zone the wind blows in.
+     *
+     * @return The zone in global coordinates.
+     */
+    Rect2 GetArea() const { return area; }
+
+    /**
+     * @brief Sets the zone the wind blows in; takes effect the next time the zone is baked into a `ForceField`.
+     *
+     * @param newArea The zone in global coordinates; a negative size is flipped.
+     */
+    void SetArea(const Rect2 &newArea) { area = newArea; }
+
+    /**
+     * @brief Gets the acceleration the wind gives the player inside the zone.
+     *
+     * @return The acceleration in pixels per second squared; negative Y pushes up.
+     */
+    Vector2 GetForce() const { return force; }
+
+    /**
+     * @brief Sets the acceleration the wind gives the player inside the zone.
+     *
+     * @param newForce The acceleration in pixels per second squared; negative Y pushes up.
+     */
+    void SetForce(const Vector2 &newForce) { force = newForce; }
+
+    /**
+     * @brief Gets how far in from the zone's edges the force takes to reach full strength.
+     *
+     * @return The distance in pixels over which the force rises from zero at each edge; 0 is a hard edge.
+     */
+    double GetFade() const { return fade; }
+
+    /**
+     * @brief Sets how far in from the zone's edges the force takes to reach full strength.
+     *
+     * @param newFade The distance in pixels over which the force rises from zero at each edge; 0 is a hard edge.
+     */
+    void SetFade(double newFade) { fade = static_cast<float>(newFade); }
+
+    /**
+     * @brief Gets the zone to bake into a `ForceField`.
+     *
+     * @return The zone's area, force and fade.
+     */
+    ForceZone GetZone() const {
+        const Rect2 zone = area.abs();
+        return ForceZone{
+            Aabb{zone.position.x, zone.position.y, zone.position.x + zone.size.x, zone.position.y + zone.size.y},
+            force.x, force.y, fade
+        };
+    }
+
+    /**
+     * @brief Binds methods to Godot for use in the editor or scripts.
+     */
+    static void _bind_methods() {
+        ClassDB::bind_method(D_METHOD("GetArea"), &Wind::GetArea);
+        ClassDB::bind_method(D_METHOD("SetArea", "area"), &Wind::SetArea);
+        ClassDB::bind_method(D_METHOD("GetForce"), &Wind::GetForce);
+        ClassDB::bind_method(D_METHOD("SetForce", "force"), &Wind::SetForce);
+        ClassDB::bind_method(D_METHOD("GetFade"), &Wind::GetFade);
+        ClassDB::bind_method(D_METHOD("SetFade", "fade"), &Wind::SetFade);
+        ADD_PROPERTY(PropertyInfo(Variant::RECT2, "area"), "SetArea", "GetArea");
+        ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "force"), "SetForce", "GetForce");
+        ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "fade"), "SetFade", "GetFade");
+    }
+};
+
+#endif // WIND_H
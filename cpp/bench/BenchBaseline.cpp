@@ -0,0 +1,166 @@
+#include "BenchBaseline.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    /**
+     * @brief Reads the string value of `"key": "..."` inside `object`.
+     */
+    bool ReadString(const std::string &object, const std::string &key, std::string &value) {
+        const std::string pattern = "\"" + key + "\"";
+        std::size_t position = object.find(pattern);
+        if (position == std::string::npos) {
+            return false;
+        }
+        position = object.find('"', object.find(':', position + pattern.size()));
+        const std::size_t end = object.find('"', position + 1);
+        if (position == std::string::npos || end == std::string::npos) {
+            return false;
+        }
+        value = object.substr(position + 1, end - position - 1);
+        return true;
+    }
+
+    /**
+     * @brief Reads the numeric value of `"key": 1.23` inside `object`.
+     */
+    bool ReadNumber(const std::string &object, const std::string &key, double &value) {
+        const std::string pattern = "\"" + key + "\"";
+        const std::size_t position = object.find(pattern);
+        if (position == std::string::npos) {
+            return false;
+        }
+        const std::size_t colon = object.find(':', position + pattern.size());
+        if (colon == std::string::npos) {
+            return false;
+        }
+        char *end = nullptr;
+        value = std::strtod(object.c_str() + colon + 1, &end);
+        return end != object.c_str() + colon + 1;
+    }
+
+    const char *GetStatusName(BenchComparison::Status status) {
+        switch (status) {
+            case BenchComparison::Status::Ok:
+                return "ok";
+            case BenchComparison::Status::Improved:
+                return "improved";
+            case BenchComparison::Status::Regressed:
+                return "REGRESSED";
+            case BenchComparison::Status::Noisy:
+                return "noisy";
+            default:
+                return "new";
+        }
+    }
+}
+
+double BenchTolerances::GetPercent(const std::string &name) const {
+    for (const auto &[benchmark, percent]: overrides) {
+        if (benchmark == name) {
+            return percent;
+        }
+    }
+    return defaultPercent;
+}
+
+std::ostream &operator<<(std::ostream &os, const BenchComparison &comparison) {
+    const std::ios::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+    os << std::left << std::setw(40) << comparison.name << std::right << std::fixed << std::setprecision(2);
+    if (comparison.status == BenchComparison::Status::New) {
+        os << std::setw(12) << "-" << " -> " << std::setw(10) << comparison.currentNs << " ns";
+    } else {
+        os << std::setw(12) << comparison.baselineNs << " -> " << std::setw(10) << comparison.currentNs << " ns"
+                << std::showpos << std::setw(9) << comparison.changePercent << "%" << std::noshowpos
+                << " (allowed " << comparison.allowedPercent << "%)";
+    }
+    os << "  " << GetStatusName(comparison.status);
+    os.flags(flags);
+    os.precision(precision);
+    return os;
+}
+
+bool BenchBaseline::Load(const std::string &path, std::vector<BenchResult> &results, std::string &error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+
+    // Our own writer puts every benchmark in one flat object, so splitting on braces is enough
+    const std::size_t list = text.find("\"benchmarks\"");
+    if (list == std::string::npos) {
+        error = path + " has no \"benchmarks\" list";
+        return false;
+    }
+    results.clear();
+    std::size_t open = text.find('{', list);
+    while (open != std::string::npos) {
+        const std::size_t close = text.find('}', open);
+        if (close == std::string::npos) {
+            break;
+        }
+        const std::string object = text.substr(open, close - open + 1);
+        BenchResult result;
+        if (ReadString(object, "name", result.name) && ReadNumber(object, "median_ns", result.medianNs)) {
+            ReadNumber(object, "mad_ns", result.madNs);
+            ReadNumber(object, "p99_ns", result.p99Ns);
+            results.push_back(result);
+        }
+        open = text.find('{', close);
+    }
+    return true;
+}
+
+bool BenchBaseline::Save(const std::string &path, const std::vector<BenchResult> &results) {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    BenchRegistry::WriteJson(file, results);
+    return static_cast<bool>(file);
+}
+
+std::vector<BenchComparison> BenchBaseline::Compare(const std::vector<BenchResult> &baseline,
+                                                    const std::vector<BenchResult> &current,
+                                                    const BenchTolerances &tolerances) {
+    std::vector<BenchComparison> comparisons;
+    for (const BenchResult &result: current) {
+        BenchComparison comparison;
+        comparison.name = result.name;
+        comparison.currentNs = result.medianNs;
+
+        const auto match = std::find_if(baseline.begin(), baseline.end(), [&result](const BenchResult &entry) {
+            return entry.name == result.name;
+        });
+        if (match == baseline.end() || match->medianNs <= 0.0) {
+            comparisons.push_back(comparison);
+            continue;
+        }
+
+        comparison.baselineNs = match->medianNs;
+        comparison.changePercent = (result.medianNs - match->medianNs) / match->medianNs * 100.0;
+        const double noise = std::max(result.GetRelativeNoise(), match->GetRelativeNoise());
+        comparison.allowedPercent = tolerances.GetPercent(result.name) + 3.0 * noise * 100.0;
+
+        if (result.GetRelativeNoise() > tolerances.noiseLimit) {
+            comparison.status = BenchComparison::Status::Noisy;
+        } else if (comparison.changePercent > comparison.allowedPercent) {
+            comparison.status = BenchComparison::Status::Regressed;
+        } else if (comparison.changePercent < -comparison.allowedPercent) {
+            comparison.status = BenchComparison::Status::Improved;
+        } else {
+            comparison.status = BenchComparison::Status::Ok;
+        }
+        comparisons.push_back(comparison);
+    }
+    return comparisons;
+}
@@ -0,0 +1,93 @@
+#ifndef OOP_BENCHBASELINE_H
+#define OOP_BENCHBASELINE_H
+
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BenchHarness.h"
+
+/**
+ * @struct BenchTolerances
+ * @brief How much slower than the baseline a benchmark may get before it counts as a regression.
+ */
+struct BenchTolerances {
+    double defaultPercent = 10.0;
+    double noiseLimit = 0.10; // Relative MAD above which a result is reported as noisy instead of judged
+    std::vector<std::pair<std::string, double> > overrides; // Exact benchmark name -> percent
+
+    /**
+     * @brief Gets the tolerance of one benchmark in percent.
+     */
+    double GetPercent(const std::string &name) const;
+};
+
+/**
+ * @struct BenchComparison
+ * @brief The verdict for one benchmark against the baseline.
+ */
+struct BenchComparison {
+    enum class Status { Ok, Improved, Regressed, Noisy, New };
+
+    std::string name;
+    double baselineNs = 0.0;
+    double currentNs = 0.0;
+    double changePercent = 0.0;
+    double allowedPercent = 0.0;
+    Status status = Status::New;
+
+    /**
+     * @brief Stream insertion operator for the BenchComparison struct.
+     *
+     * @param os The output stream.
+     * @param comparison The BenchComparison instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const BenchComparison &comparison);
+};
+
+/**
+ * @class BenchBaseline
+ * @brief Saves benchmark results as a baseline and judges later runs against it.
+ *
+ * The baseline is the JSON written by `BenchRegistry::WriteJson`. A benchmark regresses when its median
+ * is slower than the baseline median by more than its tolerance, widened by three times the measured
+ * relative noise of either side, so a shared machine does not produce false alarms. Results noisier than
+ * `BenchTolerances::noiseLimit` are reported but never fail the run.
+ */
+class BenchBaseline {
+public:
+    /**
+     * @brief Reads a baseline file.
+     *
+     * @param path The file to read.
+     * @param results Receives the name, median and MAD of every benchmark in the file.
+     * @param error Receives a message if the file cannot be read.
+     * @return `true` if the file was read.
+     */
+    static bool Load(const std::string &path, std::vector<BenchResult> &results, std::string &error);
+
+    /**
+     * @brief Writes results as a baseline file.
+     *
+     * @param path The file to write.
+     * @param results The results to save.
+     * @return `true` if the file was written.
+     */
+    static bool Save(const std::string &path, const std::vector<BenchResult> &results);
+
+    /**
+     * @brief Compares a run against the baseline.
+     *
+     * @param baseline The baseline results.
+     * @param current The results of this run.
+     * @param tolerances The per-benchmark tolerances.
+     * @return One verdict per benchmark of the current run.
+     */
+    static std::vector<BenchComparison> Compare(const std::vector<BenchResult> &baseline,
+                                                const std::vector<BenchResult> &current,
+                                                const BenchTolerances &tolerances);
+};
+
+#endif //OOP_BENCHBASELINE_H
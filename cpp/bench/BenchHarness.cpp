@@ -0,0 +1,144 @@
+#include "BenchHarness.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+namespace {
+    /**
+     * @brief Time spent inside `PauseTiming` scopes during the current sample.
+     */
+    double pausedNs = 0.0;
+
+    double TimeSample(const BenchRegistry::Body &body, std::uint64_t iterations) {
+        pausedNs = 0.0;
+        const auto start = std::chrono::steady_clock::now();
+        body(iterations);
+        ClobberMemory();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() - pausedNs;
+    }
+
+    double Percentile(const std::vector<double> &sorted, double percentile) {
+        const double rank = percentile / 100.0 * static_cast<double>(sorted.size() - 1);
+        const auto lower = static_cast<std::size_t>(rank);
+        const std::size_t upper = std::min(lower + 1, sorted.size() - 1);
+        const double fraction = rank - static_cast<double>(lower);
+        return sorted[lower] + (sorted[upper] - sorted[lower]) * fraction;
+    }
+}
+
+PauseTiming::PauseTiming() {
+    ClobberMemory();
+    start = std::chrono::steady_clock::now();
+}
+
+PauseTiming::~PauseTiming() {
+    ClobberMemory();
+    pausedNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::ostream &operator<<(std::ostream &os, const BenchResult &result) {
+    const std::ios::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+    os << std::left << std::setw(40) << result.name << std::right << std::fixed << std::setprecision(2)
+            << " median " << std::setw(10) << result.medianNs << " ns"
+            << "  p99 " << std::setw(10) << result.p99Ns << " ns"
+            << "  noise " << std::setw(5) << result.GetRelativeNoise() * 100.0 << "%"
+            << "  (" << result.runs << " x " << result.samples << " x " << result.iterations << ")";
+    os.flags(flags);
+    os.precision(precision);
+    return os;
+}
+
+void BenchRegistry::Add(std::string name, Body body) {
+    entries.push_back(Entry{std::move(name), std::move(body)});
+}
+
+std::vector<BenchResult> BenchRegistry::Run(const BenchOptions &options, std::ostream &progress) const {
+    std::vector<BenchResult> results;
+    for (const Entry &entry: entries) {
+        if (!options.filter.empty() && entry.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+
+        // Grow the iteration count until a sample is long enough to time reliably
+        std::uint64_t iterations = 1;
+        while (TimeSample(entry.body, iterations) < options.minSampleNs && iterations < (1ull << 40)) {
+            iterations *= 2;
+        }
+
+        std::vector<double> runMedians;
+        std::vector<double> runP99s;
+        std::vector<double> pooled;
+        for (std::size_t run = 0; run < options.runs; ++run) {
+            for (std::size_t warmup = 0; warmup < options.warmupSamples; ++warmup) {
+                TimeSample(entry.body, iterations);
+            }
+
+            std::vector<double> perOp;
+            perOp.reserve(options.samples);
+            for (std::size_t sample = 0; sample < options.samples; ++sample) {
+                perOp.push_back(TimeSample(entry.body, iterations) / static_cast<double>(iterations));
+            }
+            std::sort(perOp.begin(), perOp.end());
+            runMedians.push_back(Percentile(perOp, 50.0));
+            runP99s.push_back(Percentile(perOp, 99.0));
+            pooled.insert(pooled.end(), perOp.begin(), perOp.end());
+        }
+        std::sort(runMedians.begin(), runMedians.end());
+        std::sort(runP99s.begin(), runP99s.end());
+        std::sort(pooled.begin(), pooled.end());
+
+        BenchResult result;
+        result.name = entry.name;
+        result.iterations = iterations;
+        result.samples = options.samples;
+        result.runs = options.runs;
+        if (!pooled.empty()) {
+            double sum = 0.0;
+            for (const double value: pooled) {
+                sum += value;
+            }
+            result.medianNs = Percentile(runMedians, 50.0);
+            result.p99Ns = Percentile(runP99s, 50.0);
+            result.meanNs = sum / static_cast<double>(pooled.size());
+            result.minNs = pooled.front();
+            result.maxNs = pooled.back();
+
+            std::vector<double> deviations;
+            deviations.reserve(pooled.size());
+            for (const double value: pooled) {
+                deviations.push_back(value > result.medianNs ? value - result.medianNs : result.medianNs - value);
+            }
+            std::sort(deviations.begin(), deviations.end());
+            result.madNs = Percentile(deviations, 50.0);
+        }
+        progress << result << "\n";
+        results.push_back(result);
+    }
+    return results;
+}
+
+void BenchRegistry::WriteJson(std::ostream &os, const std::vector<BenchResult> &results) {
+    const std::ios::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(4) << "{\n  \"benchmarks\": [";
+    for (std::size_t index = 0; index < results.size(); ++index) {
+        const BenchResult &result = results[index];
+        os << (index == 0 ? "\n" : ",\n")
+                << "    {\"name\": \"" << result.name << "\""
+                << ", \"iterations\": " << result.iterations
+                << ", \"samples\": " << result.samples
+                << ", \"runs\": " << result.runs
+                << ", \"median_ns\": " << result.medianNs
+                << ", \"mad_ns\": " << result.madNs
+                << ", \"p99_ns\": " << result.p99Ns
+                << ", \"mean_ns\": " << result.meanNs
+                << ", \"min_ns\": " << result.minNs
+                << ", \"max_ns\": " << result.maxNs << "}";
+    }
+    os << "\n  ]\n}\n";
+    os.flags(flags);
+    os.precision(precision);
+}
@@ -0,0 +1,165 @@
+#ifndef OOP_BENCHHARNESS_H
+#define OOP_BENCHHARNESS_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Forces the compiler to materialize `value` without emitting any instructions.
+ *
+ * Use on benchmark results so the measured work cannot be optimized away.
+ */
+template<typename T>
+inline void DoNotOptimize(T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : "+r,m"(value) : : "memory");
+#else
+    const volatile auto *sink = &value;
+    static_cast<void>(sink);
+#endif
+}
+
+/**
+ * @brief Forces the compiler to assume all memory may have been read or written.
+ */
+inline void ClobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+/**
+ * @class PauseTiming
+ * @brief Leaves whatever runs during its lifetime out of the sample being timed, such as restoring a fixture.
+ *
+ * Costs two clock reads, so pause around work that dwarfs them rather than around every operation.
+ */
+class PauseTiming {
+public:
+    PauseTiming();
+
+    ~PauseTiming();
+
+    PauseTiming(const PauseTiming &) = delete;
+
+    PauseTiming &operator=(const PauseTiming &) = delete;
+
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * @struct BenchResult
+ * @brief Timing statistics of one benchmark, in nanoseconds per operation.
+ */
+struct BenchResult {
+    std::string name;
+    std::uint64_t iterations = 0; // Operations per sample
+    std::size_t samples = 0;      // Samples per run
+    std::size_t runs = 0;
+    double medianNs = 0.0;        // Median of the per-run medians
+    double madNs = 0.0;           // Median absolute deviation of every sample from the median
+    double p99Ns = 0.0;
+    double meanNs = 0.0;
+    double minNs = 0.0;
+    double maxNs = 0.0;
+
+    /**
+     * @brief Gets the spread of the samples relative to the median.
+     */
+    double GetRelativeNoise() const { return medianNs > 0.0 ? madNs / medianNs : 0.0; }
+
+    /**
+     * @brief Stream insertion operator for the BenchResult struct.
+     *
+     * @param os The output stream.
+     * @param result The BenchResult instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const BenchResult &result);
+};
+
+/**
+ * @struct BenchOptions
+ * @brief Knobs shared by every benchmark in a run.
+ */
+struct BenchOptions {
+    std::size_t warmupSamples = 3;
+    std::size_t samples = 50;
+    std::size_t runs = 1;             // Independent repetitions of the whole measurement
+    double minSampleNs = 2'000'000.0; // Iterations are scaled until one sample takes at least this long
+    std::string filter;               // Only benchmarks whose name contains this run
+};
+
+/**
+ * @class BenchRegistry
+ * @brief A dependency-free microbenchmark runner.
+ *
+ * A benchmark is a callable that performs its operation `iterations` times. The runner calibrates the
+ * iteration count so each sample is long enough to time reliably, discards warmup samples, then reports the
+ * median and p99 over the remaining samples. With several runs the reported median is the median of the
+ * per-run medians, which shrugs off a run disturbed by other load on a shared machine.
+ */
+class BenchRegistry {
+public:
+    using Body = std::function<void(std::uint64_t iterations)>;
+
+    /**
+     * @brief Adds a benchmark to the registry.
+     *
+     * @param name A unique name, conventionally "Group/Case".
+     * @param body The callable that runs the operation `iterations` times.
+     */
+    void Add(std::string name, Body body);
+
+    /**
+     * @brief Runs every benchmark matching the filter.
+     *
+     * @param options The run options.
+     * @param progress Receives one line per finished benchmark.
+     * @return The results, in registration order.
+     */
+    std::vector<BenchResult> Run(const BenchOptions &options, std::ostream &progress) const;
+
+    /**
+     * @brief Writes results as a JSON document.
+     *
+     * @param os The output stream.
+     * @param results The results to write.
+     */
+    static void WriteJson(std::ostream &os, const std::vector<BenchResult> &results);
+
+private:
+    struct Entry {
+        std::string name;
+        Body body;
+    };
+
+    std::vector<Entry> entries;
+};
+
+/**
+ * @brief Registers the movement step benchmarks.
+ */
+void RegisterMovementBenchmarks(BenchRegistry &registry);
+
+/**
+ * @brief Registers the environment, surface effect and printer benchmarks.
+ */
+void RegisterEnvironmentBenchmarks(BenchRegistry &registry);
+
+/**
+ * @brief Registers the collision query benchmarks.
+ */
+void RegisterCollisionBenchmarks(BenchRegistry &registry);
+
+/**
+ * @brief Registers the headless replay benchmarks.
+ */
+void RegisterReplayBenchmarks(BenchRegistry &registry);
+
+#endif //OOP_BENCHHARNESS_H
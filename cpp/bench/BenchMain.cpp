@@ -0,0 +1,111 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "BenchBaseline.h"
+#include "BenchHarness.h"
+
+namespace {
+    void PrintUsage() {
+        std::cout << "Usage: oop_bench [--filter TEXT] [--samples N] [--runs N] [--warmup N]"
+                " [--min-sample-ms MS] [--json FILE]\n"
+                "                 [--save-baseline FILE] [--baseline FILE] [--tolerance PERCENT]\n"
+                "                 [--tolerance-for NAME=PERCENT]... [--noise-limit PERCENT]\n"
+                "Exits with 1 when --baseline is given and a benchmark regressed.\n";
+    }
+
+    bool ParseOverride(const std::string &text, BenchTolerances &tolerances) {
+        const std::size_t equals = text.rfind('=');
+        if (equals == std::string::npos || equals == 0) {
+            return false;
+        }
+        tolerances.overrides.emplace_back(text.substr(0, equals), std::strtod(text.c_str() + equals + 1, nullptr));
+        return true;
+    }
+}
+
+int main(int argc, char **argv) {
+    BenchOptions options;
+    BenchTolerances tolerances;
+    std::string jsonPath;
+    std::string baselinePath;
+    std::string saveBaselinePath;
+
+    for (int index = 1; index < argc; ++index) {
+        const std::string argument = argv[index];
+        const bool hasValue = index + 1 < argc;
+        if (argument == "--filter" && hasValue) {
+            options.filter = argv[++index];
+        } else if (argument == "--samples" && hasValue) {
+            options.samples = std::strtoull(argv[++index], nullptr, 10);
+        } else if (argument == "--runs" && hasValue) {
+            options.runs = std::strtoull(argv[++index], nullptr, 10);
+        } else if (argument == "--warmup" && hasValue) {
+            options.warmupSamples = std::strtoull(argv[++index], nullptr, 10);
+        } else if (argument == "--min-sample-ms" && hasValue) {
+            options.minSampleNs = std::strtod(argv[++index], nullptr) * 1'000'000.0;
+        } else if (argument == "--json" && hasValue) {
+            jsonPath = argv[++index];
+        } else if (argument == "--baseline" && hasValue) {
+            baselinePath = argv[++index];
+        } else if (argument == "--save-baseline" && hasValue) {
+            saveBaselinePath = argv[++index];
+        } else if (argument == "--tolerance" && hasValue) {
+            tolerances.defaultPercent = std::strtod(argv[++index], nullptr);
+        } else if (argument == "--tolerance-for" && hasValue && ParseOverride(argv[index + 1], tolerances)) {
+            ++index;
+        } else if (argument == "--noise-limit" && hasValue) {
+            tolerances.noiseLimit = std::strtod(argv[++index], nullptr) / 100.0;
+        } else {
+            PrintUsage();
+            return argument == "--help" ? 0 : 2;
+        }
+    }
+    if (options.samples == 0 || options.runs == 0) {
+        std::cerr << "--samples and --runs must be at least 1\n";
+        return 2;
+    }
+
+    // Load the baseline before measuring so a bad path fails fast
+    std::vector<BenchResult> baseline;
+    if (!baselinePath.empty()) {
+        std::string error;
+        if (!BenchBaseline::Load(baselinePath, baseline, error)) {
+            std::cerr << "Could not load baseline: " << error << "\n";
+            return 2;
+        }
+    }
+
+    BenchRegistry registry;
+    RegisterMovementBenchmarks(registry);
+    RegisterEnvironmentBenchmarks(registry);
+    RegisterCollisionBenchmarks(registry);
+    RegisterReplayBenchmarks(registry);
+
+    const std::vector<BenchResult> results = registry.Run(options, std::cout);
+
+    if (!jsonPath.empty()) {
+        std::ofstream json(jsonPath);
+        if (!json) {
+            std::cerr << "Could not write " << jsonPath << "\n";
+            return 1;
+        }
+        BenchRegistry::WriteJson(json, results);
+    }
+    if (!saveBaselinePath.empty() && !BenchBaseline::Save(saveBaselinePath, results)) {
+        std::cerr << "Could not write " << saveBaselinePath << "\n";
+        return 1;
+    }
+
+    if (baselinePath.empty()) {
+        return 0;
+    }
+    std::cout << "\nComparison against " << baselinePath << ":\n";
+    bool regressed = false;
+    for (const BenchComparison &comparison: BenchBaseline::Compare(baseline, results, tolerances)) {
+        std::cout << comparison << "\n";
+        regressed = regressed || comparison.status == BenchComparison::Status::Regressed;
+    }
+    return regressed ? 1 : 0;
+}
@@ -0,0 +1,107 @@
+#include <cstdint>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "../Core/ActivationRegion.h"
+#include "../Core/Collision.h"
+#include "../Core/SpatialGrid.h"
+#include "../Core/World.h"
+
+namespace {
+    /**
+     * @brief Builds a tower of alternating wall tiles, `rows` tiles high.
+     */
+    std::vector<Aabb> MakeTower(int rows) {
+        std::vector<Aabb> boxes;
+        for (int row = 0; row < rows; ++row) {
+            const float y = static_cast<float>(-row) * 64.0f;
+            const float x = (row % 2 == 0) ? 0.0f : 160.0f;
+            boxes.push_back(Aabb{x, y, x + 128.0f, y + 16.0f});
+            boxes.push_back(Aabb{-32.0f, y - 64.0f, 0.0f, y}); // Left wall
+            boxes.push_back(Aabb{320.0f, y - 64.0f, 352.0f, y}); // Right wall
+        }
+        return boxes;
+    }
+
+    /**
+     * @brief Buckets the tower's boxes into a grid of one-row cells.
+     */
+    SpatialGrid MakeGrid(const std::vector<Aabb> &boxes) {
+        Aabb bounds = boxes.front();
+        for (const Aabb &box: boxes) {
+            bounds = bounds.Merge(box);
+        }
+        SpatialGrid grid(bounds, 64.0f);
+        for (std::size_t index = 0; index < boxes.size(); ++index) {
+            grid.Insert(static_cast<std::uint32_t>(index), boxes[index]);
+        }
+        return grid;
+    }
+}
+
+void RegisterCollisionBenchmarks(BenchRegistry &registry) {
+    // The fixtures are built once here, so the timed bodies only run the queries
+    for (const int rows: {64, 1024}) {
+        const std::vector<Aabb> tower = MakeTower(rows);
+        const SpatialGrid grid = MakeGrid(tower);
+        registry.Add("Collision/QueryOverlaps rows=" + std::to_string(rows), [tower](std::uint64_t iterations) {
+            std::vector<std::uint32_t> hits;
+            Aabb player{100.0f, -40.0f, 116.0f, -8.0f};
+            for (std::uint64_t index = 0; index < iterations; ++index) {
+                DoNotOptimize(player);
+                std::size_t count = QueryOverlaps(tower, player, hits);
+                DoNotOptimize(count);
+            }
+        });
+        registry.Add("Collision/SpatialGrid::Query rows=" + std::to_string(rows),
+                     [tower, grid](std::uint64_t iterations) {
+            std::vector<std::uint32_t> hits;
+            hits.reserve(tower.size());
+            Aabb player{100.0f, -40.0f, 116.0f, -8.0f};
+            for (std::uint64_t index = 0; index < iterations; ++index) {
+                DoNotOptimize(player);
+                std::size_t count = grid.Query(player, hits);
+                DoNotOptimize(count);
+            }
+        });
+        // A camera climbing the tower one pixel per iteration, wrapping at the top
+        registry.Add("Collision/ActivationRegion::Update rows=" + std::to_string(rows),
+                     [rows, grid](std::uint64_t iterations) {
+            ActivationRegion region(grid, 128.0f, 256.0f);
+            const float height = static_cast<float>(rows) * 64.0f;
+            for (std::uint64_t index = 0; index < iterations; ++index) {
+                const float top = -static_cast<float>(index % static_cast<std::uint64_t>(height));
+                region.Update(Aabb{0.0f, top - 360.0f, 320.0f, top});
+                std::size_t active = region.GetActive().size();
+                DoNotOptimize(active);
+            }
+        });
+    }
+
+    // Crumbling walls: a hole punched through a wall segment and the floor of the shaft next to it, a row
+    // higher every time, against rebuilding the whole grid. The level is restored after every climb, untimed.
+    for (const std::uint32_t level: {0u, 3u}) {
+        const World tower = World::MakeTower(level);
+        const int rows = 32 + static_cast<int>(level) * 32;
+        registry.Add("World/Carve rows=" + std::to_string(rows), [tower, rows](std::uint64_t iterations) {
+            World world;
+            for (std::uint64_t index = 0; index < iterations; ++index) {
+                const int row = static_cast<int>(index % static_cast<std::uint64_t>(rows));
+                if (row == 0) {
+                    PauseTiming pause;
+                    world = tower;
+                }
+                const float y = -static_cast<float>(row) * World::RowHeight;
+                std::size_t cut = world.Carve(Aabb{-16.0f, y - 40.0f, 24.0f, y + 8.0f});
+                DoNotOptimize(cut);
+            }
+        });
+        registry.Add("World/BuildGrid rows=" + std::to_string(rows), [tower](std::uint64_t iterations) {
+            World world = tower;
+            for (std::uint64_t index = 0; index < iterations; ++index) {
+                world.BuildGrid();
+                DoNotOptimize(world);
+            }
+        });
+    }
+}
@@ -0,0 +1,179 @@
+#include <sstream>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "../include/RopeSolver.h"
+#include "../Core/Hazards.h"
+#include "../Core/JumpArc.h"
+#include "../Core/PlatformPaths.h"
+#include "../Core/Ropes.h"
+#include "../Core/World.h"
+#include "../Core/SurfaceEffects.h"
+#include "../Core/SurfaceMaterial.h"
+
+void RegisterEnvironmentBenchmarks(BenchRegistry &registry) {
+    registry.Add("SurfaceEffects/Visit x3", [](std::uint64_t iterations) {
+        const std::vector<SurfaceEffect> effects{NoEffect{}, WallEffect{0.0f, -1.0f}, WallEffect{-1.0f, 0.0f}};
+        MovementState state{100.0f, -20.0f, false};
+        for (std::uint64_t index = 0; index < iterations; ++index) {
+            DoNotOptimize(state);
+            MovementState result = ApplySurfaceEffects(effects, state);
+            DoNotOptimize(result);
+        }
+    });
+
+    // A crowd of agents on mixed ground and ice, each holding left, right or nothing
+    registry.Add("SurfaceMaterial/StepBatch x4096", [](std::uint64_t iterations) {
+        const SurfaceResponse responses[] = {
+            SurfaceMaterials::Ground.GetResponse(MovementConstants::TickDelta),
+            SurfaceMaterials::Ice.GetResponse(MovementConstants::TickDelta)
+        };
+        std::vector<std::uint8_t> materials(4096);
+        std::vector<float> directions(4096);
+        std::vector<float> velocities(4096, 0.0f);
+        std::vector<float> displacements(4096);
+        for (std::size_t agent = 0; agent < materials.size(); ++agent) {
+            materials[agent] = static_cast<std::uint8_t>(agent % 3u == 0 ? 1 : 0);
+            directions[agent] = static_cast<float>(agent % 3u) - 1.0f;
+        }
+        float *moved = displacements.data();
+        for (std::uint64_t index = 0; index < iterations; ++index) {
+            SurfaceResponse::StepBatch(responses, materials, directions, velocities, displacements);
+            DoNotOptimize(moved);
+        }
+    });
+
+    // Thousands of platforms shuttling diagonally, updated in one pass and one at a time
+    PlatformPaths platforms;
+    for (std::uint32_t index = 0; index < 4096; ++index) {
+        const float y = -static_cast<float>(index) * 16.0f;
+        const float keys[] = {32.0f, y, 288.0f, y - 8.0f};
+        platforms.Add(32.0f, 8.0f, keys, 1.0f + static_cast<float>(index % 5u) * 0.5f,
+                      static_cast<float>(index % 7u) * 0.3f);
+    }
+    registry.Add("Platforms/Sample count=4096", [platforms](std::uint64_t iterations) {
+        std::vector<float> x(platforms.GetCount());
+        std::vector<float> y(platforms.GetCount());
+        float *sampled = x.data();
+        double time = 0.0;
+        for (std::uint64_t index = 0; index < iterations; ++index) {
+            time += 1.0 / 60.0;
+            platforms.Sample(time, x, y);
+            DoNotOptimize(sampled);
+        }
+    });
+    registry.Add("Platforms/SampleOne x4096", [platforms](std::uint64_t iterations) {
+        std::vector<float> x(platforms.GetCount());
+        std::vector<float> y(platforms.GetCount());
+        float *sampled = x.data();
+        double time = 0.0;
+        for (std::uint64_t index = 0; index < iterations; ++index) {
+            time += 1.0 / 60.0;
+            for (std::uint32_t platform = 0; platform < platforms.GetCount(); ++platform) {
+                platforms.SampleOne(platform, time, x[platform], y[platform]);
+            }
+            DoNotOptimize(sampled);
+        }
+    });
+
+    // A crowd spread over the storm at the top of the tallest tower, sampled in one pass and one at a time
+    const World storm = World::MakeTower(World::StormBit | 3u);
+    std::vector<float> crowdX(4096);
+    std::vector<float> crowdY(4096);
+    for (std::size_t agent = 0; agent < crowdX.size(); ++agent) {
+        crowdX[agent] = static_cast<float>(agent * 37u % 320u);
+        crowdY[agent] = -static_cast<float>(agent * 53u % 2048u) - 96.0f * World::RowHeight;
+    }
+    registry.Add("ForceField/Sample x4096", [storm, crowdX, crowdY](std::uint64_t iterations) {
+        std::vector<float> forceX(crowdX.size());
+        std::vector<float> forceY(crowdX.size());
+        float *sampled = forceX.data();
+        for (std::uint64_t index = 0; index < iterations; ++index) {
+            storm.wind.Sample(crowdX, crowdY, forceX, forceY);
+            DoNotOptimize(sampled);
+        }
+    });
+    registry.Add("ForceField/SampleOne x4096", [storm, crowdX, crowdY](std::uint64_t iterations) {
+        std::vector<float> forceX(crowdX.size());
+        std::vector<float> forceY(crowdX.size());
+        float *sampled = forceX.data();
+        for (std::uint64_t index = 0; index < iterations; ++index) {
+            for (std::size_t agent = 0; agent < crowdX.size(); ++agent) {
+                storm.wind.SampleOne(crowdX[agent], crowdY[agent], forceX[agent], forceY[agent]);
+            }
+            DoNotOptimize(sampled);
+        }
+    });
+
+    // An avalanche over the same tower: every tick moves, collides and compacts, then refills what shattered
+    registry.Add("Hazards/Step x4096", [storm](std::uint64_t iterations) {
+        const Aabb bounds{-4096.0f, -1048576.0f, 4096.0f, 4096.0f};
+        Hazards hazards(4096);
+        std::uint32_t spawned = 0;
+        for (std::uint64_t index = 0; index < iterations; ++index) {
+            while (hazards.GetCount() < hazards.GetCapacity()) {
+                const float x = static_cast<float>(spawned * 37u % 320u);
+                const float y = -static_cast<float>(spawned * 53u % 4096u) - 64.0f * World::RowHeight;
+                hazards.Spawn(spawned % 4u == 0 ? HazardKind::Icicle : HazardKind::Rock, x, y, 0.0f, 0.0f);
+                ++spawned;
+            }
+            hazards.Integrate(MovementConstants::TickDelta, 980.0f);
+            std::size_t removed = hazards.Collide(storm, bounds);
+            DoNotOptimize(removed);
+        }
+    });
+
+    // Four dozen 64-node ropes hanging between the platforms of a tower, stepped inline and on the worker pool
+    const World tower = World::MakeTower(3u);
+    Ropes ropes(64);
+    // Per tick in the movement rules, per second squared here
+    constexpr float ropeGravity = MovementConstants::Gravity * MovementConstants::TicksPerSecond;
+    for (std::uint32_t rope = 0; rope < 48; ++rope) {
+        ropes.Add(16.0f + static_cast<float>(rope * 61u % 288u), -static_cast<float>(rope * 2u + 8u) * World::RowHeight,
+                  4.0f);
+    }
+    registry.Add("Ropes/Step ropes=48 nodes=64", [tower, ropes](std::uint64_t iterations) mutable {
+        for (std::uint64_t index = 0; index < iterations; ++index) {
+            ropes.Step(MovementConstants::TickDelta, ropeGravity, tower);
+            DoNotOptimize(ropes);
+        }
+    });
+    registry.Add("RopeSolver/Step ropes=48 nodes=64", [tower, ropes](std::uint64_t iterations) mutable {
+        static RopeSolver solver;
+        for (std::uint64_t index = 0; index < iterations; ++index) {
+            solver.Step(ropes, MovementConstants::TickDelta, ropeGravity, tower);
+            DoNotOptimize(ropes);
+        }
+    });
+
+    registry.Add("JumpArc/CanReach", [](std::uint64_t iterations) {
+        Ledge from{0.0f, 64.0f, 0.0f};
+        const Ledge to{200.0f, 264.0f, -300.0f};
+        for (std::uint64_t index = 0; index < iterations; ++index) {
+            DoNotOptimize(from);
+            bool reachable = JumpArc::CanReach(from, to);
+            DoNotOptimize(reachable);
+        }
+    });
+
+    // The Godot-bound classes print through the same pattern as these value types
+    registry.Add("Printers/MovementState", [](std::uint64_t iterations) {
+        std::ostringstream os;
+        const MovementState state{100.0f, -20.0f, true};
+        for (std::uint64_t index = 0; index < iterations; ++index) {
+            os.str({});
+            os << state;
+            DoNotOptimize(os);
+        }
+    });
+
+    registry.Add("Printers/SurfaceEffect", [](std::uint64_t iterations) {
+        std::ostringstream os;
+        const SurfaceEffect effect = WallEffect{-1.0f, 0.0f};
+        for (std::uint64_t index = 0; index < iterations; ++index) {
+            os.str({});
+            os << effect;
+            DoNotOptimize(os);
+        }
+    });
+}
@@ -0,0 +1,68 @@
+#include <cstdint>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "../Core/MovementTuning.h"
+
+namespace {
+    constexpr std::size_t AgentCount = 1024;
+
+    /**
+     * @brief Builds a deterministic, branch-unfriendly input sequence.
+     */
+    std::vector<MovementInput> MakeInputs(std::size_t count) {
+        std::vector<MovementInput> inputs(count);
+        std::uint32_t seed = 0x2545F491u;
+        for (auto &input: inputs) {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            input = MovementInput{(seed & 1u) != 0, (seed & 2u) != 0, (seed & 12u) == 12u};
+        }
+        return inputs;
+    }
+
+    /**
+     * @brief Builds a benchmark stepping `AgentCount` agents per iteration with `step`.
+     *
+     * Floor and air ticks alternate so both halves of the rules are exercised.
+     */
+    template<typename Step>
+    BenchRegistry::Body MakeStepBody(Step step) {
+        return [step](std::uint64_t iterations) {
+            static const std::vector<MovementInput> inputs = MakeInputs(AgentCount);
+            std::vector<MovementState> agents(AgentCount, MovementState{0.0f, 0.0f, true});
+            for (std::uint64_t tick = 0; tick < iterations; ++tick) {
+                const bool onFloor = (tick & 7u) == 0;
+                for (std::size_t index = 0; index < AgentCount; ++index) {
+                    agents[index] = step(agents[index], inputs[index], onFloor);
+                }
+                ClobberMemory();
+            }
+            DoNotOptimize(agents);
+        };
+    }
+}
+
+void RegisterMovementBenchmarks(BenchRegistry &registry) {
+    const float delta = MovementConstants::TickDelta;
+
+    // Read the tuning through a volatile so the generic step cannot be constant-folded
+    static volatile float traction = NormalTuning::Values.traction;
+    const MovementTuning runtimeTuning{
+        NormalTuning::Values.gravity, NormalTuning::Values.jumpImpulse, NormalTuning::Values.runSpeed, traction
+    };
+
+    registry.Add("PlayerStep/Runtime x1024", MakeStepBody([runtimeTuning, delta](
+            MovementState state, MovementInput input, bool onFloor) {
+                return MovementStep(runtimeTuning, state, input, onFloor, delta);
+            }));
+    registry.Add("PlayerStep/NormalTuning x1024", MakeStepBody([delta](
+            MovementState state, MovementInput input, bool onFloor) {
+                return MovementStep<NormalTuning>(state, input, onFloor, delta);
+            }));
+    registry.Add("PlayerStep/IceTuning x1024", MakeStepBody([delta](
+            MovementState state, MovementInput input, bool onFloor) {
+                return MovementStep<IceTuning>(state, input, onFloor, delta);
+            }));
+}
@@ -0,0 +1,54 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "BenchHarness.h"
+#include <Replay.h>
+#include <SaveGame.h>
+
+void RegisterReplayBenchmarks(BenchRegistry &registry) {
+    // One short and one long level, and long ones with moving platforms and with wind; a full replay exercises
+    // movement, contacts and collision queries together
+    for (const std::uint32_t seed: {0u, 3u, 11u, 19u}) {
+        const Replay replay = Replay::Generate(seed, 600);
+        registry.Add("Replay/Run level=" + std::to_string(replay.levelId), [replay](std::uint64_t iterations) {
+            for (std::uint64_t index = 0; index < iterations; ++index) {
+                ReplayResult result = replay.Run();
+                DoNotOptimize(result);
+            }
+        });
+    }
+
+    // A save with a long run of level changes; Serialize is the part the physics thread pays for
+    SaveState state;
+    state.player = SavePlayer{120.0f, -2400.0f, 35.0f, -180.0f, 1, 0, 36000};
+    state.progress = SaveProgress{3, 2400.0f, 36000};
+    for (std::uint32_t index = 0; index < 256; ++index) {
+        const float x = static_cast<float>(index % 16) * 32.0f;
+        const float y = -static_cast<float>(index / 16) * 48.0f;
+        state.mutations.push_back(SaveMutation{SaveMutationKind::Carve, 0, x, y, x + 24.0f, y + 16.0f});
+    }
+    std::vector<std::uint64_t> payload;
+    const std::size_t bytes = SaveGame::Serialize(state, payload);
+    registry.Add("SaveGame/Serialize mutations=256", [state](std::uint64_t iterations) {
+        std::vector<std::uint64_t> out;
+        for (std::uint64_t index = 0; index < iterations; ++index) {
+            std::size_t written = SaveGame::Serialize(state, out);
+            DoNotOptimize(written);
+        }
+    });
+    registry.Add("SaveGame/Compress mutations=256", [payload, bytes](std::uint64_t iterations) {
+        std::vector<std::uint8_t> out;
+        for (std::uint64_t index = 0; index < iterations; ++index) {
+            SaveGame::Compress(reinterpret_cast<const std::uint8_t *>(payload.data()), bytes, out);
+            DoNotOptimize(out);
+        }
+    });
+    registry.Add("SaveGame/Open mutations=256", [payload, bytes](std::uint64_t iterations) {
+        SaveView view;
+        for (std::uint64_t index = 0; index < iterations; ++index) {
+            bool opened = view.Open(reinterpret_cast<const std::uint8_t *>(payload.data()), bytes);
+            DoNotOptimize(opened);
+        }
+    });
+}
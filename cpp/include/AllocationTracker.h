@@ -0,0 +1,113 @@
+#ifndef OOP_ALLOCATIONTRACKER_H
+#define OOP_ALLOCATIONTRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @class AllocationTracker
+ * @brief Counts heap allocations and attributes them to the current tick and profiling zone.
+ *
+ * The standalone build routes every `operator new` through `OnAllocate` (see `AllocationHooks.cpp`); each
+ * allocation bumps `Counter::Allocations`, so the per-tick value shows up next to the other gameplay
+ * counters. When built with `OOP_ALLOC_GUARD`, allocating inside a `NO_ALLOCATION_SCOPE` prints the scope
+ * and zone and aborts, which makes hitch-causing allocations in the tick impossible to miss.
+ *
+ * Only the headless targets are hooked. The Godot extension shares the engine's allocator and cannot replace
+ * `operator new`, so nothing is counted there and no-allocation scopes never fire; the guarded scopes sit on
+ * the core code that both run, such as `PlayerSim::Step`, which replays and `oop` exercise with the guard on.
+ * In the extension, `Player` tracks the growth of Godot's own memory pool instead.
+ */
+class AllocationTracker {
+public:
+    /**
+     * @brief Number of distinct zones allocations can be attributed to; later zones are folded into "other".
+     */
+    static constexpr std::size_t MaxZones = 64;
+
+    /**
+     * @brief Records one allocation; called by the allocation hooks.
+     *
+     * @param size The number of bytes requested.
+     */
+    static void OnAllocate(std::size_t size);
+
+    /**
+     * @brief Gets the total number of allocations recorded.
+     */
+    static std::uint64_t GetAllocationCount();
+
+    /**
+     * @brief Gets the total number of bytes requested.
+     */
+    static std::uint64_t GetAllocatedBytes();
+
+    /**
+     * @brief Writes the allocation count of every profiling zone that allocated.
+     *
+     * Zones are only known in builds with `OOP_PROFILING`; everything else is reported as "(no zone)".
+     *
+     * @param os The output stream.
+     */
+    static void WriteZoneTable(std::ostream &os);
+
+private:
+    friend class NoAllocationScope;
+    friend class AllowAllocationScope;
+
+    /**
+     * @brief Name of the innermost no-allocation scope on each thread, or `nullptr`.
+     */
+    static inline thread_local const char *guardedScope = nullptr;
+
+    /**
+     * @brief Depth of `AllowAllocationScope`s on each thread; while positive the guard is suspended.
+     */
+    static inline thread_local int allowDepth = 0;
+};
+
+/**
+ * @class NoAllocationScope
+ * @brief Marks a scope that must not allocate; use through `NO_ALLOCATION_SCOPE`.
+ */
+class NoAllocationScope {
+public:
+    explicit NoAllocationScope(const char *scopeName) : parent(AllocationTracker::guardedScope) {
+        AllocationTracker::guardedScope = scopeName;
+    }
+
+    ~NoAllocationScope() { AllocationTracker::guardedScope = parent; }
+
+    NoAllocationScope(const NoAllocationScope &) = delete;
+
+    NoAllocationScope &operator=(const NoAllocationScope &) = delete;
+
+private:
+    const char *parent;
+};
+
+/**
+ * @class AllowAllocationScope
+ * @brief Suspends the no-allocation guard for one-time setup, such as registering a thread's profiler ring.
+ */
+class AllowAllocationScope {
+public:
+    AllowAllocationScope() { ++AllocationTracker::allowDepth; }
+
+    ~AllowAllocationScope() { --AllocationTracker::allowDepth; }
+
+    AllowAllocationScope(const AllowAllocationScope &) = delete;
+
+    AllowAllocationScope &operator=(const AllowAllocationScope &) = delete;
+};
+
+#ifdef OOP_ALLOC_GUARD
+#define NO_ALLOCATION_SCOPE(name) const NoAllocationScope OOP_ALLOC_CONCAT(noAllocationScope, __LINE__)(name)
+#define OOP_ALLOC_CONCAT_IMPL(a, b) a##b
+#define OOP_ALLOC_CONCAT(a, b) OOP_ALLOC_CONCAT_IMPL(a, b)
+#else
+#define NO_ALLOCATION_SCOPE(name) static_cast<void>(0)
+#endif
+
+#endif //OOP_ALLOCATIONTRACKER_H
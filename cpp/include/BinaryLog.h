@@ -0,0 +1,151 @@
+#ifndef OOP_BINARYLOG_H
+#define OOP_BINARYLOG_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+/**
+ * @brief Maps a log argument type to the one-character code stored in the format table.
+ */
+template<typename T>
+struct LogTypeCode {
+    static_assert(std::is_arithmetic_v<T>, "BINARY_LOG only accepts arithmetic arguments");
+    static constexpr char value = std::is_same_v<T, bool>
+                                      ? 'b'
+                                      : std::is_floating_point_v<T>
+                                            ? (sizeof(T) == 4 ? 'f' : 'd')
+                                            : std::is_signed_v<T>
+                                                  ? (sizeof(T) <= 4 ? 'i' : 'q')
+                                                  : (sizeof(T) <= 4 ? 'u' : 'Q');
+};
+
+/**
+ * @brief The argument codes of a log call as a null-terminated string, e.g. "ffb".
+ */
+template<typename... Args>
+struct LogTypeCodes {
+    static constexpr char value[sizeof...(Args) + 1] = {LogTypeCode<std::decay_t<Args> >::value..., '\0'};
+};
+
+/**
+ * @class BinaryLog
+ * @brief An asynchronous binary logger for per-tick tracing.
+ *
+ * The hot path stores only a format id, a timestamp and the raw argument bytes into the calling thread's
+ * lock-free ring, with no formatting and no locks. A background thread drains every ring into a binary file
+ * together with the format table, and `oop_logdecode` renders the file as text offline. When a ring is full
+ * the record is dropped and counted rather than blocking the game.
+ *
+ * Argument values are stored in their widened form: `int`, `unsigned`, `float` and `bool` take four bytes,
+ * 64-bit integers and `double` take eight.
+ */
+class BinaryLog {
+public:
+    /**
+     * @brief Bytes of ring storage per thread.
+     */
+    static constexpr std::uint32_t RingBytes = 1u << 16;
+
+    /**
+     * @brief Registers a format and returns its id; called once per call site.
+     *
+     * @param text The text with one `{}` per argument; must point to a string literal.
+     * @param codes The argument codes from `LogTypeCodes`.
+     * @return The id of the format.
+     */
+    static std::uint16_t RegisterFormat(const char *text, const char *codes);
+
+    /**
+     * @brief Starts the background writer.
+     *
+     * @param path The binary file to write.
+     * @return `true` if the file was opened and the writer started.
+     */
+    static bool Start(const std::string &path);
+
+    /**
+     * @brief Drains every ring, stops the background writer and closes the file.
+     */
+    static void Stop();
+
+    /**
+     * @brief Checks whether the writer is running; records made while it is not are discarded.
+     */
+    static bool IsRunning() { return running.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the number of records dropped because a ring was full.
+     */
+    static std::uint64_t GetDroppedCount();
+
+    /**
+     * @brief Copies a record into the calling thread's ring.
+     *
+     * @param id The format id from `RegisterFormat`.
+     * @param args The arguments, in format order.
+     */
+    template<typename... Args>
+    static void Write(std::uint16_t id, const Args &... args) {
+        constexpr std::size_t size = (0 + ... + WidenedSize<Args>());
+        unsigned char payload[size > 0 ? size : 1];
+        std::size_t offset = 0;
+        (Pack(payload, offset, args), ...);
+        WriteRecord(id, payload, static_cast<std::uint16_t>(size));
+    }
+
+    /**
+     * @brief Gets the argument codes of a call by deducing the argument types.
+     */
+    template<typename... Args>
+    static constexpr const char *GetCodes(const Args &...) {
+        return LogTypeCodes<Args...>::value;
+    }
+
+private:
+    template<typename T>
+    static constexpr std::size_t WidenedSize() {
+        return sizeof(T) > 4 ? 8 : 4;
+    }
+
+    template<typename T>
+    static void Pack(unsigned char *payload, std::size_t &offset, const T &value) {
+        using Arg = std::decay_t<T>;
+        if constexpr (std::is_same_v<Arg, bool>) {
+            const std::uint32_t widened = value ? 1u : 0u;
+            std::memcpy(payload + offset, &widened, 4);
+        } else if constexpr (std::is_floating_point_v<Arg>) {
+            std::memcpy(payload + offset, &value, sizeof(Arg));
+        } else if constexpr (sizeof(Arg) <= 4) {
+            using Wide = std::conditional_t<std::is_signed_v<Arg>, std::int32_t, std::uint32_t>;
+            const Wide widened = static_cast<Wide>(value);
+            std::memcpy(payload + offset, &widened, 4);
+        } else {
+            std::memcpy(payload + offset, &value, 8);
+        }
+        offset += WidenedSize<Arg>();
+    }
+
+    static void WriteRecord(std::uint16_t id, const void *payload, std::uint16_t size);
+
+    static std::atomic<bool> running;
+};
+
+/**
+ * @brief Logs a record with arithmetic arguments if the binary log is running.
+ *
+ * The format id is registered the first time the call site runs, which evaluates the arguments one extra
+ * time; after that the cost is one relaxed load, one timestamp and a copy of the arguments.
+ */
+#define BINARY_LOG(text, ...)                                                                               \
+    do {                                                                                                    \
+        if (BinaryLog::IsRunning()) {                                                                       \
+            static const std::uint16_t binaryLogId = BinaryLog::RegisterFormat(                             \
+                text, BinaryLog::GetCodes(__VA_ARGS__));                                                    \
+            BinaryLog::Write(binaryLogId __VA_OPT__(,) __VA_ARGS__);                                        \
+        }                                                                                                   \
+    } while (false)
+
+#endif //OOP_BINARYLOG_H
@@ -0,0 +1,117 @@
+#ifndef OOP_COUNTERS_H
+#define OOP_COUNTERS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @brief The gameplay performance counters tracked by `Counters`.
+ */
+enum class Counter : std::uint8_t {
+    CollisionTests,
+    BroadphaseCandidates,
+    MoveAndSlideCalls,
+    Allocations,
+    GodotMemoryGrowth,
+    ResimulatedTicks,
+    Count
+};
+
+/**
+ * @class Counters
+ * @brief A registry of gameplay counters that can be bumped cheaply from any thread.
+ *
+ * Every counter lives on its own cache line and is incremented with a relaxed atomic add. Besides the
+ * running total, the registry keeps the value of the last completed tick, which is what the Godot debugger
+ * monitors display. Code that runs many times per tick bumps a per-thread tally with `AddDeferred` instead,
+ * which the thread publishes once per tick or batch with `Flush`.
+ */
+class Counters {
+public:
+    /**
+     * @brief Adds to a counter.
+     *
+     * @param counter The counter to bump.
+     * @param amount The amount to add.
+     */
+    static void Add(Counter counter, std::uint64_t amount = 1) {
+        slots[Index(counter)].total.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Adds to the calling thread's tally of a counter; a plain add with no shared cache line.
+     *
+     * The amount only reaches the counter at the thread's next `Flush` or `BeginTick`.
+     *
+     * @param counter The counter to bump.
+     * @param amount The amount to add.
+     */
+    static void AddDeferred(Counter counter, std::uint64_t amount = 1) {
+        pending[Index(counter)] += amount;
+    }
+
+    /**
+     * @brief Publishes the calling thread's deferred tallies, one atomic add per counter that grew.
+     *
+     * Call at the end of a tick or batch on every thread that uses `AddDeferred`.
+     */
+    static void Flush();
+
+    /**
+     * @brief Gets the running total of a counter.
+     */
+    static std::uint64_t GetTotal(Counter counter) {
+        return slots[Index(counter)].total.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the amount a counter grew by during the last completed tick.
+     */
+    static std::uint64_t GetLastTick(Counter counter) {
+        return slots[Index(counter)].lastTick.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the display name of a counter.
+     */
+    static const char *GetName(Counter counter);
+
+    /**
+     * @brief Flushes the calling thread, then closes the current tick and starts a new one.
+     *
+     * Safe to call several times for the same tick: only the first call with a new `tick` number rolls over,
+     * so every system stepping in a frame can call it.
+     *
+     * @param tick A number identifying the tick that is starting, such as the physics frame.
+     */
+    static void BeginTick(std::uint64_t tick);
+
+    /**
+     * @brief Writes every counter as a table of totals and last-tick values.
+     *
+     * @param os The output stream.
+     */
+    static void WriteTable(std::ostream &os);
+
+private:
+    /**
+     * @brief One counter, padded so counters bumped by different threads never share a cache line.
+     */
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> total{0};
+        std::atomic<std::uint64_t> tickStart{0};
+        std::atomic<std::uint64_t> lastTick{0};
+    };
+
+    static constexpr std::size_t Index(Counter counter) { return static_cast<std::size_t>(counter); }
+
+    static std::array<Slot, static_cast<std::size_t>(Counter::Count)> slots;
+
+    static std::atomic<std::uint64_t> currentTick;
+
+    static constinit thread_local std::array<std::uint64_t, static_cast<std::size_t>(Counter::Count)> pending;
+};
+
+#endif //OOP_COUNTERS_H
@@ -0,0 +1,102 @@
+#ifndef OOP_FRAMEHISTOGRAM_H
+#define OOP_FRAMEHISTOGRAM_H
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @class FrameHistogram
+ * @brief A fixed-memory, HDR-style histogram of durations in nanoseconds.
+ *
+ * Values are bucketed log-linearly: every power of two is split into `SubBucketCount / 2` equal buckets, so
+ * the relative error stays below 1/64 (about 1.6%) from a nanosecond up to the `MaxValue` of about 18 minutes,
+ * in a constant 18 KB. Recording is a handful of integer operations with no allocation. A histogram is
+ * meant to be written by a single thread.
+ */
+class FrameHistogram {
+public:
+    /**
+     * @brief Number of linear buckets in the first group; also sets the precision of every other group.
+     */
+    static constexpr std::uint64_t SubBucketCount = 128;
+
+    /**
+     * @brief Largest value the histogram distinguishes; larger values are clamped.
+     */
+    static constexpr std::uint64_t MaxValue = (1ull << 40) - 1;
+
+    /**
+     * @brief Records one duration.
+     *
+     * @param nanoseconds The duration to record.
+     */
+    void Record(std::uint64_t nanoseconds);
+
+    /**
+     * @brief Gets the value at or below which `percentile` percent of the recorded values fall.
+     *
+     * The answer is the upper edge of the matching bucket, capped at the largest recorded value.
+     *
+     * @param percentile The percentile, between 0 and 100.
+     * @return The duration in nanoseconds, or 0 if nothing was recorded.
+     */
+    std::uint64_t GetPercentile(double percentile) const;
+
+    /**
+     * @brief Gets the number of recorded values.
+     */
+    std::uint64_t GetCount() const { return count; }
+
+    /**
+     * @brief Gets the largest recorded value.
+     */
+    std::uint64_t GetMax() const { return max; }
+
+    /**
+     * @brief Gets the mean of the recorded values.
+     */
+    double GetMean() const { return count == 0 ? 0.0 : static_cast<double>(sum) / static_cast<double>(count); }
+
+    /**
+     * @brief Forgets every recorded value.
+     */
+    void Reset();
+
+    /**
+     * @brief Gets the histogram of physics tick durations.
+     */
+    static FrameHistogram &PhysicsTicks();
+
+    /**
+     * @brief Gets the histogram of render frame durations.
+     */
+    static FrameHistogram &RenderFrames();
+
+    /**
+     * @brief Stream insertion operator for the FrameHistogram class.
+     *
+     * Outputs the count and the p50/p90/p99/p99.9/max durations in milliseconds.
+     *
+     * @param os The output stream.
+     * @param histogram The FrameHistogram instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const FrameHistogram &histogram);
+
+private:
+    static constexpr std::uint64_t HalfCount = SubBucketCount / 2;
+    static constexpr unsigned SubBucketBits = 7; // log2(SubBucketCount)
+    static constexpr std::size_t BucketCount = (40 - SubBucketBits + 1) * HalfCount + HalfCount;
+
+    static std::size_t GetIndex(std::uint64_t value);
+
+    static std::uint64_t GetUpperEdge(std::size_t index);
+
+    std::array<std::uint64_t, BucketCount> buckets{};
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+    std::uint64_t max = 0;
+};
+
+#endif //OOP_FRAMEHISTOGRAM_H
@@ -0,0 +1,165 @@
+#ifndef OOP_GHOSTCODEC_H
+#define OOP_GHOSTCODEC_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @brief Bits of `GhostState::flags`.
+ */
+enum GhostFlags : std::uint8_t {
+    GHOST_CAN_JUMP = 1u << 0,
+};
+
+/**
+ * @struct GhostState
+ * @brief The quantized state of a ghost: what other players need to draw someone else's run.
+ *
+ * Positions are stored in 1/`PositionScale` pixels and velocities in 1/`VelocityScale` pixels per second, so
+ * consecutive ticks differ by small integers that delta-encode into a byte or two.
+ */
+struct GhostState {
+    static constexpr float PositionScale = 8.0f;
+    static constexpr float VelocityScale = 4.0f;
+
+    std::int32_t positionX = 0;
+    std::int32_t positionY = 0;
+    std::int16_t velocityX = 0;
+    std::int16_t velocityY = 0;
+    std::uint8_t flags = 0; // GhostFlags
+    std::uint8_t mode = 0;  // Player::MovementMode
+
+    /**
+     * @brief Quantizes the player's state.
+     *
+     * @param x Position X in pixels.
+     * @param y Position Y in pixels.
+     * @param vx Velocity X in pixels per second.
+     * @param vy Velocity Y in pixels per second.
+     * @param canJump Whether the player can jump.
+     * @param mode The movement mode.
+     * @return The quantized state; out-of-range velocities saturate.
+     */
+    static GhostState Quantize(float x, float y, float vx, float vy, bool canJump, std::uint8_t mode);
+
+    float GetPositionX() const { return static_cast<float>(positionX) / PositionScale; }
+
+    float GetPositionY() const { return static_cast<float>(positionY) / PositionScale; }
+
+    float GetVelocityX() const { return static_cast<float>(velocityX) / VelocityScale; }
+
+    float GetVelocityY() const { return static_cast<float>(velocityY) / VelocityScale; }
+
+    friend bool operator==(const GhostState &, const GhostState &) = default;
+
+    /**
+     * @brief Stream insertion operator for the GhostState struct.
+     *
+     * @param os The output stream.
+     * @param state The GhostState instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const GhostState &state) {
+        os << "GhostState(Position: (" << state.GetPositionX() << ", " << state.GetPositionY() << "), Velocity: ("
+                << state.GetVelocityX() << ", " << state.GetVelocityY() << "), Flags: "
+                << static_cast<unsigned>(state.flags) << ", Mode: " << static_cast<unsigned>(state.mode) << ")";
+        return os;
+    }
+};
+
+/**
+ * @class GhostCodec
+ * @brief Delta-encodes a ghost state against a baseline the other side is known to have.
+ *
+ * The encoding is a mask byte naming the changed fields, then zigzag varints of the integer differences.
+ * A ghost at rest costs one byte and a running or falling ghost two to four. Without a baseline the state is
+ * encoded against zero and the mask says so, so a receiver can always decode it.
+ */
+class GhostCodec {
+public:
+    /**
+     * @brief Upper bound of the bytes `Encode` writes.
+     */
+    static constexpr std::size_t MaxEncodedBytes = 1 + 5 + 5 + 3 + 3 + 1 + 1;
+
+    /**
+     * @brief Encodes a state.
+     *
+     * @param base The baseline the receiver holds, or null to encode the full state.
+     * @param state The state to encode.
+     * @param out Receives at most `MaxEncodedBytes` bytes.
+     * @return The number of bytes written.
+     */
+    static std::size_t Encode(const GhostState *base, const GhostState &state, std::uint8_t *out);
+
+    /**
+     * @brief Decodes a state written by `Encode`.
+     *
+     * @param base The baseline named by the packet, or null if the receiver does not have it.
+     * @param in The read position; advanced past the encoded state even if it cannot be decoded.
+     * @param end The end of the buffer.
+     * @param state Receives the decoded state.
+     * @return `true` if the state was decoded; `false` if it was truncated or needs a baseline that is missing.
+     */
+    static bool Decode(const GhostState *base, const std::uint8_t *&in, const std::uint8_t *end, GhostState &state);
+};
+
+/**
+ * @class GhostHistory
+ * @brief The states of one ghost over the last `Capacity` ticks.
+ *
+ * Both ends of a connection keep one so that deltas can be encoded against, and decoded from, whichever tick
+ * was last acknowledged. Receivers also interpolate between the stored ticks.
+ */
+class GhostHistory {
+public:
+    static constexpr std::uint32_t Capacity = 64;
+
+    /**
+     * @brief Stores the state of a tick, replacing whatever was stored `Capacity` ticks earlier.
+     *
+     * Ticks `Capacity` or more behind the latest one are dropped: their slot belongs to a newer tick.
+     */
+    void Put(std::uint32_t tick, const GhostState &state);
+
+    /**
+     * @brief Finds the state of a tick.
+     *
+     * @return The state, or null if the tick was never stored or has been overwritten.
+     */
+    const GhostState *Find(std::uint32_t tick) const;
+
+    /**
+     * @brief Gets the most recent tick stored.
+     *
+     * @return `false` if nothing has been stored yet.
+     */
+    bool GetLatestTick(std::uint32_t &tick) const;
+
+    /**
+     * @brief Interpolates the position between the stored ticks around `tick`.
+     *
+     * Before the first stored tick the oldest state is used, after the latest one the latest state is held.
+     *
+     * @param tick The possibly fractional tick to sample.
+     * @param x Receives the position X in pixels.
+     * @param y Receives the position Y in pixels.
+     * @return `false` if nothing has been stored yet, or the latest state is no longer stored.
+     */
+    bool Interpolate(double tick, float &x, float &y) const;
+
+private:
+    struct Entry {
+        std::uint32_t tick = 0;
+        bool valid = false;
+        GhostState state;
+    };
+
+    std::array<Entry, Capacity> entries{};
+    std::uint32_t latestTick = 0;
+    bool hasLatest = false;
+};
+
+#endif //OOP_GHOSTCODEC_H
@@ -0,0 +1,301 @@
+#ifndef OOP_GHOSTNET_H
+#define OOP_GHOSTNET_H
+
+#include <GhostCodec.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct UdpAddress
+ * @brief An IPv4 address and port, both in host byte order.
+ */
+struct UdpAddress {
+    std::uint32_t ip = 0;
+    std::uint16_t port = 0;
+
+    /**
+     * @brief Gets 127.0.0.1 with the given port.
+     */
+    static UdpAddress Loopback(std::uint16_t port) { return UdpAddress{0x7F000001u, port}; }
+
+    /**
+     * @brief Parses a dotted IPv4 address.
+     *
+     * @return `false` if the text is not an IPv4 address.
+     */
+    static bool Parse(const std::string &text, std::uint16_t port, UdpAddress &address);
+
+    friend bool operator==(const UdpAddress &, const UdpAddress &) = default;
+};
+
+/**
+ * @class UdpSocket
+ * @brief A non-blocking IPv4 UDP socket.
+ */
+class UdpSocket {
+public:
+    /**
+     * @brief Largest datagram the ghost protocol sends, small enough to avoid IP fragmentation.
+     */
+    static constexpr std::size_t MaxDatagram = 1200;
+
+    /**
+     * @brief Requested kernel send and receive buffer size.
+     */
+    static constexpr int BufferBytes = 1 << 20;
+
+    UdpSocket() = default;
+
+    ~UdpSocket();
+
+    UdpSocket(const UdpSocket &) = delete;
+
+    UdpSocket &operator=(const UdpSocket &) = delete;
+
+    /**
+     * @brief Opens the socket bound to a local port.
+     *
+     * @param port The port to bind, or 0 for any free port.
+     * @return `true` if the socket is ready.
+     */
+    bool Open(std::uint16_t port);
+
+    void Close();
+
+    bool IsOpen() const { return handle != InvalidHandle; }
+
+    /**
+     * @brief Gets the bound local port.
+     */
+    std::uint16_t GetPort() const;
+
+    /**
+     * @brief Sends a datagram; delivery is not guaranteed.
+     */
+    bool SendTo(const UdpAddress &address, const std::uint8_t *data, std::size_t size);
+
+    /**
+     * @brief Receives one pending datagram without blocking.
+     *
+     * @return The datagram size, or -1 if nothing is pending.
+     */
+    long Receive(std::uint8_t *data, std::size_t capacity, UdpAddress &from);
+
+    /**
+     * @brief Drops the given percentage of outgoing datagrams, to exercise packet loss over loopback.
+     */
+    void SetLossPercent(std::uint32_t percent) { lossPercent = percent; }
+
+private:
+    static constexpr std::intptr_t InvalidHandle = -1;
+
+    std::intptr_t handle = InvalidHandle;
+    std::uint32_t lossPercent = 0;
+    std::uint32_t lossSeed = 0x9E3779B9u;
+};
+
+/**
+ * @brief The first byte of every ghost datagram.
+ */
+enum class GhostMessage : std::uint8_t {
+    Join = 'J',      // Receiver -> relay: start sending me ghosts
+    Upload = 'S',    // Sender -> relay: u16 ghost, u32 tick, u8 base age, encoded state
+    UploadAck = 'A', // Relay -> sender: u16 ghost, u32 tick
+    Batch = 'B',     // Relay -> receiver: u32 tick, u8 base age, u8 part, u8 parts, u16 count, ghosts
+    BatchAck = 'K',  // Receiver -> relay: u32 tick
+};
+
+/**
+ * @brief Tick number meaning "no baseline".
+ *
+ * On the wire the baseline is sent as its age in ticks, where 0 means none.
+ */
+inline constexpr std::uint32_t GhostNoBase = 0xFFFFFFFFu;
+
+/**
+ * @class GhostSender
+ * @brief Uploads the local player's state to a relay at a fixed tick interval.
+ *
+ * Every upload is delta-encoded against the last tick the relay acknowledged. All buffers are fixed-size,
+ * so `Update` can run inside the player's no-allocation tick.
+ */
+class GhostSender {
+public:
+    /**
+     * @param relay The relay to send to.
+     * @param ghostId The id other players see this ghost under.
+     * @param sendInterval Send every this many ticks.
+     */
+    GhostSender(const UdpAddress &relay, std::uint16_t ghostId, std::uint32_t sendInterval = 1);
+
+    bool IsOpen() const { return socket.IsOpen(); }
+
+    /**
+     * @brief Reads acknowledgements and sends the state if this tick is due.
+     *
+     * @param tick The local physics tick.
+     * @param state The player's state this tick.
+     */
+    void Update(std::uint32_t tick, const GhostState &state);
+
+    std::uint64_t GetBytesSent() const { return bytesSent; }
+
+    std::uint64_t GetPacketsSent() const { return packetsSent; }
+
+    UdpSocket &GetSocket() { return socket; }
+
+private:
+    UdpSocket socket;
+    UdpAddress relay;
+    std::uint16_t ghostId;
+    std::uint32_t sendInterval;
+    GhostHistory sent;
+    std::uint32_t ackedTick = GhostNoBase;
+    std::uint64_t bytesSent = 0;
+    std::uint64_t packetsSent = 0;
+};
+
+/**
+ * @class GhostRelay
+ * @brief Collects ghost uploads and broadcasts every ghost to every receiver at a fixed rate.
+ *
+ * Each broadcast is one relay tick. A receiver gets all ghosts delta-encoded against the last relay tick it
+ * acknowledged, split into datagrams of at most `UdpSocket::MaxDatagram` bytes, so the cost per ghost stays
+ * at a few bytes per tick and a single relay serves hundreds of ghosts.
+ */
+class GhostRelay {
+public:
+    /**
+     * @brief Receivers and ghosts silent for this many relay ticks are dropped.
+     */
+    static constexpr std::uint32_t TimeoutTicks = 600;
+
+    /**
+     * @param port The port to listen on, or 0 for any free port.
+     */
+    explicit GhostRelay(std::uint16_t port);
+
+    bool IsOpen() const { return socket.IsOpen(); }
+
+    std::uint16_t GetPort() const { return socket.GetPort(); }
+
+    /**
+     * @brief Handles every pending upload, join and acknowledgement.
+     */
+    void Poll();
+
+    /**
+     * @brief Advances the relay tick and sends the ghosts to every receiver.
+     */
+    void Broadcast();
+
+    std::uint32_t GetTick() const { return tick; }
+
+    std::size_t GetGhostCount() const { return ghosts.size(); }
+
+    std::size_t GetReceiverCount() const { return receivers.size(); }
+
+    std::uint64_t GetBytesSent() const { return bytesSent; }
+
+    std::uint64_t GetGhostTicksSent() const { return ghostTicksSent; }
+
+    UdpSocket &GetSocket() { return socket; }
+
+private:
+    struct Ghost {
+        GhostHistory uploads;   // Keyed by the sender's ticks
+        GhostHistory broadcast; // Keyed by relay ticks
+        GhostState latest;
+        std::uint32_t lastHeard = 0;
+    };
+
+    struct Receiver {
+        UdpAddress address;
+        std::uint32_t ackedTick = GhostNoBase;
+        std::uint32_t lastHeard = 0;
+    };
+
+    void HandleUpload(const UdpAddress &from, const std::uint8_t *data, const std::uint8_t *end);
+
+    Receiver &FindReceiver(const UdpAddress &address);
+
+    void SendBatch(const Receiver &receiver, const std::vector<std::uint16_t> &ids);
+
+    UdpSocket socket;
+    std::unordered_map<std::uint16_t, Ghost> ghosts;
+    std::vector<Receiver> receivers;
+    std::vector<std::uint8_t> scratch;     // Encoded entries of the batch being sent
+    std::vector<std::size_t> scratchEnds;  // End offset of each entry
+    std::vector<std::size_t> scratchCuts;  // First entry of each datagram
+    std::uint32_t tick = 0;
+    std::uint64_t bytesSent = 0;
+    std::uint64_t ghostTicksSent = 0;
+};
+
+/**
+ * @class GhostReceiver
+ * @brief Receives ghosts from a relay and interpolates them for drawing.
+ */
+class GhostReceiver {
+public:
+    /**
+     * @brief Ticks the rendered ghosts trail the newest relay tick, to hide jitter and loss.
+     */
+    static constexpr double InterpolationDelay = 3.0;
+
+    explicit GhostReceiver(const UdpAddress &relay);
+
+    bool IsOpen() const { return socket.IsOpen(); }
+
+    /**
+     * @brief Handles every pending batch and acknowledges the complete ones.
+     */
+    void Poll();
+
+    /**
+     * @brief Gets the relay tick the ghosts should be drawn at: the newest tick minus the delay.
+     */
+    double GetRenderTick() const;
+
+    /**
+     * @brief Interpolates a ghost's position.
+     *
+     * @return `false` if the ghost is unknown.
+     */
+    bool Sample(std::uint16_t ghostId, double tick, float &x, float &y) const;
+
+    /**
+     * @brief Gets the ids of every ghost received so far.
+     */
+    std::vector<std::uint16_t> GetGhostIds() const;
+
+    std::uint32_t GetLatestTick() const { return latestTick; }
+
+    std::uint64_t GetBytesReceived() const { return bytesReceived; }
+
+    UdpSocket &GetSocket() { return socket; }
+
+private:
+    struct PartSet {
+        std::uint32_t tick = GhostNoBase;
+        std::uint64_t received = 0; // One bit per datagram of the tick
+        bool failed = false;        // A ghost could not be decoded
+    };
+
+    void HandleBatch(const std::uint8_t *data, const std::uint8_t *end);
+
+    UdpSocket socket;
+    UdpAddress relay;
+    std::unordered_map<std::uint16_t, GhostHistory> ghosts;
+    std::array<PartSet, GhostHistory::Capacity> parts{};
+    std::uint32_t latestTick = 0;
+    bool hasTick = false;
+    std::uint32_t pollsSinceData = 0;
+    std::uint64_t bytesReceived = 0;
+};
+
+#endif //OOP_GHOSTNET_H
@@ -0,0 +1,141 @@
+#ifndef OOP_PROFILER_H
+#define OOP_PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @struct ProfileEvent
+ * @brief One completed profiling zone.
+ */
+struct ProfileEvent {
+    /**
+     * @brief Name of the zone; must point to a string literal.
+     */
+    const char *name;
+
+    /**
+     * @brief Start time in nanoseconds since the profiler epoch.
+     */
+    std::uint64_t start;
+
+    /**
+     * @brief Duration of the zone in nanoseconds.
+     */
+    std::uint64_t duration;
+};
+
+/**
+ * @class Profiler
+ * @brief Records profiling zones into per-thread ring buffers and exports them as a Chrome trace.
+ *
+ * Each thread owns a fixed-size ring it writes without locks; the exporter reads all rings and skips any
+ * events that were overwritten while it was reading. The only lock is taken once per thread, when its ring
+ * is registered. The output loads in `chrome://tracing` and in Perfetto.
+ */
+class Profiler {
+public:
+    /**
+     * @brief Number of events kept per thread; older events are overwritten.
+     */
+    static constexpr std::uint64_t RingCapacity = 1u << 14;
+
+    /**
+     * @brief Gets the current time in nanoseconds since the profiler epoch.
+     */
+    static std::uint64_t Now();
+
+    /**
+     * @brief Records a completed zone into the calling thread's ring.
+     *
+     * @param name The zone name; must point to a string literal.
+     * @param start The start time returned by `Now()`.
+     * @param end The end time returned by `Now()`.
+     */
+    static void Record(const char *name, std::uint64_t start, std::uint64_t end);
+
+    /**
+     * @brief Writes every recorded event in the Chrome trace event JSON format.
+     *
+     * @param os The output stream.
+     */
+    static void WriteChromeTrace(std::ostream &os);
+
+    /**
+     * @brief Writes every recorded event to a Chrome trace JSON file.
+     *
+     * @param path The file to write.
+     * @return `true` if the file was written.
+     */
+    static bool WriteChromeTrace(const std::string &path);
+
+    /**
+     * @brief Drops every recorded event.
+     */
+    static void Clear();
+
+    /**
+     * @brief Gets the innermost zone open on the calling thread.
+     *
+     * @return The zone name, or `nullptr` outside any zone.
+     */
+    static const char *GetCurrentZone() { return currentZone; }
+
+private:
+    friend class ProfileZone;
+
+    /**
+     * @brief The innermost zone open on each thread, used to attribute allocations and log records.
+     */
+    static inline thread_local const char *currentZone = nullptr;
+};
+
+/**
+ * @class ProfileZone
+ * @brief Records the lifetime of the enclosing scope as a profiling zone.
+ *
+ * Use the `PROFILE_ZONE` macro instead of naming this class, so zones disappear from builds without
+ * `OOP_PROFILING`.
+ */
+class ProfileZone {
+public:
+    /**
+     * @brief Starts the zone.
+     *
+     * @param zoneName The zone name; must point to a string literal.
+     */
+    explicit ProfileZone(const char *zoneName)
+        : name(zoneName), parent(Profiler::currentZone), start(Profiler::Now()) {
+        Profiler::currentZone = zoneName;
+    }
+
+    /**
+     * @brief Ends the zone and records it.
+     */
+    ~ProfileZone() {
+        Profiler::Record(name, start, Profiler::Now());
+        Profiler::currentZone = parent;
+    }
+
+    ProfileZone(const ProfileZone &) = delete;
+
+    ProfileZone &operator=(const ProfileZone &) = delete;
+
+private:
+    const char *name;
+    const char *parent;
+    std::uint64_t start;
+};
+
+#define OOP_PROFILE_CONCAT_IMPL(a, b) a##b
+#define OOP_PROFILE_CONCAT(a, b) OOP_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef OOP_PROFILING
+#define PROFILE_ZONE(name) const ProfileZone OOP_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) static_cast<void>(0)
+#endif
+
+#endif //OOP_PROFILER_H
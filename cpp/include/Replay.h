@@ -0,0 +1,111 @@
+#ifndef OOP_REPLAY_H
+#define OOP_REPLAY_H
+
+#include "../Core/InputSnapshot.h"
+
+struct World;
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ReplayResult
+ * @brief Where a replay ends up, as produced by `Replay::Run` or claimed by the recording.
+ */
+struct ReplayResult {
+    std::uint64_t ticks = 0;
+    float positionX = 0.0f;
+    float positionY = 0.0f;
+    std::uint64_t stateHash = 0; // PlayerSim::GetStateHash after the last tick
+
+    friend bool operator==(const ReplayResult &, const ReplayResult &) = default;
+
+    /**
+     * @brief Stream insertion operator for the ReplayResult struct.
+     *
+     * @param os The output stream.
+     * @param result The ReplayResult instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const ReplayResult &result);
+};
+
+/**
+ * @class Replay
+ * @brief A recorded run: the level, the movement mode and one `InputSnapshot` per physics tick.
+ *
+ * Replays are the headless input corpus: `PlayerSim` re-simulates them without Godot to train profile-guided
+ * builds and to verify submitted runs against the result they claim.
+ *
+ * File layout (little-endian): "OOPRPLY1", u32 level id, u8 mode, 3 reserved bytes, u64 tick count, the
+ * claimed result (u64 ticks, f32 x, f32 y, u64 state hash), then `held` and `pressed` for every tick.
+ */
+class Replay {
+public:
+    std::uint32_t levelId = 0;
+    std::uint8_t mode = 0;             // Player::MovementMode value
+    std::vector<InputSnapshot> inputs; // One per tick
+    ReplayResult claimed;              // The result the recording says it reached
+
+    /**
+     * @brief The most ticks `Load` ever accepts; about 50 days at 60 ticks per second.
+     */
+    static constexpr std::uint64_t MaxTicks = std::uint64_t{1} << 28;
+
+    /**
+     * @brief Reads a replay file.
+     *
+     * The tick count in the header is checked against `maxTicks` and against the size of the file before
+     * anything is allocated, so a forged header cannot make the reader allocate more than the file holds.
+     *
+     * @param path The file to read.
+     * @param maxTicks Replays longer than this are rejected.
+     * @return `true` if the file was a complete replay no longer than `maxTicks`.
+     */
+    bool Load(const std::string &path, std::uint64_t maxTicks = MaxTicks);
+
+    /**
+     * @brief Writes the replay to a file.
+     *
+     * @param path The file to write.
+     * @return `true` if the file was written.
+     */
+    bool Save(const std::string &path) const;
+
+    /**
+     * @brief Re-simulates the replay headlessly.
+     *
+     * @return The result the inputs lead to.
+     */
+    ReplayResult Run() const;
+
+    /**
+     * @brief Re-simulates the replay on an already built level.
+     *
+     * @param world The level of `levelId`, as built by `World::MakeTower`.
+     * @return The result the inputs lead to.
+     */
+    ReplayResult Run(const World &world) const;
+
+    /**
+     * @brief Checks whether re-simulating the inputs reaches the claimed result.
+     */
+    bool Verify() const { return Run() == claimed; }
+
+    /**
+     * @brief Builds a synthetic replay whose claimed result is its actual result.
+     *
+     * The inputs imitate play: runs of held directions, jumps pressed every second or so, and idle pauses.
+     * The level and mode are derived from the seed; seeds with bit 3 set play towers with moving platforms,
+     * seeds with bit 4 set towers topped by a storm, and seeds with bit 5 set towers with icy ledges.
+     *
+     * @param seed Selects the inputs, level and mode.
+     * @param ticks The number of ticks to record.
+     * @return The replay.
+     */
+    static Replay Generate(std::uint32_t seed, std::uint32_t ticks);
+};
+
+#endif //OOP_REPLAY_H
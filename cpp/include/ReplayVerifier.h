@@ -0,0 +1,104 @@
+#ifndef OOP_REPLAYVERIFIER_H
+#define OOP_REPLAYVERIFIER_H
+
+#include <Replay.h>
+
+#include "../Core/World.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief What the verifier decided about one submitted replay.
+ */
+enum class ReplayVerdict : std::uint8_t {
+    Accepted,  // Re-simulation reached the claimed result
+    Rejected,  // Re-simulation disagreed with the claim
+    Malformed, // Not a replay, truncated, or longer than allowed
+};
+
+/**
+ * @brief Gets a display name for a verdict.
+ */
+const char *GetVerdictName(ReplayVerdict verdict);
+
+/**
+ * @struct ReplayCheck
+ * @brief The verdict for one replay file and the result re-simulation actually reached.
+ */
+struct ReplayCheck {
+    ReplayVerdict verdict = ReplayVerdict::Malformed;
+    ReplayResult claimed;
+    ReplayResult actual;
+};
+
+/**
+ * @class ReplayVerifier
+ * @brief Re-simulates batches of submitted replays on a fixed pool of worker threads.
+ *
+ * A batch is split into chunks that the workers claim from a shared cursor, so long and short replays even
+ * out across cores without a queue per worker. Every worker keeps its own cache of built levels, which makes
+ * the per-replay cost just the file read and the simulation.
+ */
+class ReplayVerifier {
+public:
+    /**
+     * @brief Default upper bound on the length of a submitted replay: one hour at 60 ticks per second.
+     */
+    static constexpr std::uint64_t DefaultMaxTicks = 60ull * 60ull * 60ull;
+
+    /**
+     * @param threads Worker count, or 0 for one per hardware thread.
+     * @param maxTicks Replays longer than this are malformed rather than simulated.
+     */
+    explicit ReplayVerifier(unsigned threads = 0, std::uint64_t maxTicks = DefaultMaxTicks);
+
+    ~ReplayVerifier();
+
+    ReplayVerifier(const ReplayVerifier &) = delete;
+
+    ReplayVerifier &operator=(const ReplayVerifier &) = delete;
+
+    /**
+     * @brief Verifies every file of a batch and blocks until all are done.
+     *
+     * @param paths The replay files.
+     * @return One check per path, in the same order.
+     */
+    std::vector<ReplayCheck> VerifyBatch(const std::vector<std::string> &paths);
+
+    unsigned GetThreadCount() const { return static_cast<unsigned>(workers.size()); }
+
+    /**
+     * @brief Gets the number of ticks simulated over all batches.
+     */
+    std::uint64_t GetTicksSimulated() const { return ticksSimulated.load(std::memory_order_relaxed); }
+
+private:
+    void RunWorker();
+
+    void VerifyChunks(const std::vector<std::string> &paths, std::vector<ReplayCheck> &checks,
+                      std::unordered_map<std::uint32_t, World> &levels);
+
+    std::uint64_t maxTicks;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::vector<std::string> *batchPaths = nullptr;
+    std::vector<ReplayCheck> *batchChecks = nullptr;
+    std::uint64_t generation = 0;
+    unsigned busyWorkers = 0;
+    bool stopping = false;
+    std::atomic<std::size_t> cursor{0};
+    std::size_t chunkSize = 1;
+    std::atomic<std::uint64_t> ticksSimulated{0};
+};
+
+#endif //OOP_REPLAYVERIFIER_H
@@ -0,0 +1,145 @@
+#ifndef OOP_ROLLBACK_H
+#define OOP_ROLLBACK_H
+
+#include "../Core/InputSnapshot.h"
+#include "../Core/PlayerSim.h"
+#include "../Core/World.h"
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @class RollbackSession
+ * @brief One peer's view of a head-to-head race, kept responsive with GGPO-style rollback.
+ *
+ * Both racers are simulated locally with `PlayerSim`. The local input is applied immediately; the remote
+ * input is predicted by repeating the last one received. When a real remote input arrives and differs from
+ * the prediction, the next `Advance` or `Resimulate` restores both racers to the snapshot taken before that
+ * tick and replays every tick since with the corrected inputs.
+ *
+ * The simulation may run at most `maxRollback` ticks ahead of the last confirmed remote input; beyond that
+ * `CanAdvance` returns `false` and the caller should stall the frame rather than predict further.
+ */
+class RollbackSession {
+public:
+    static constexpr std::uint32_t Players = 2;
+
+    /**
+     * @brief Ticks of inputs and snapshots kept; bounds the rollback window on both sides of the current tick.
+     */
+    static constexpr std::uint32_t HistoryTicks = 64;
+
+    /**
+     * @brief Largest supported rollback window.
+     */
+    static constexpr std::uint32_t MaxRollbackLimit = HistoryTicks / 2 - 1;
+
+    /**
+     * @param world The level both racers run on; must outlive the session.
+     * @param mode The movement mode, using the values of `Player::MovementMode`.
+     * @param localPlayer The racer this peer controls, 0 or 1.
+     * @param maxRollback How far the simulation may run ahead of the remote input, clamped to `MaxRollbackLimit`.
+     */
+    RollbackSession(const World &world, int mode, std::uint32_t localPlayer, std::uint32_t maxRollback = 8);
+
+    /**
+     * @brief Checks whether another tick may be simulated without exceeding the rollback window.
+     */
+    bool CanAdvance() const { return tick < remoteTicks + maxRollback; }
+
+    /**
+     * @brief Applies any pending correction, then simulates the next tick with the local input.
+     *
+     * Must only be called while `CanAdvance` is `true`.
+     *
+     * @param local The local racer's input for the new tick.
+     * @return The number of ticks resimulated by the correction.
+     */
+    std::uint32_t Advance(InputSnapshot local);
+
+    /**
+     * @brief Applies any pending correction without simulating a new tick, e.g. on a stalled frame.
+     *
+     * @return The number of ticks resimulated.
+     */
+    std::uint32_t Resimulate();
+
+    /**
+     * @brief Records the remote racer's input for a tick.
+     *
+     * Inputs must arrive in tick order; a tick that is already known or leaves a gap is ignored, so a
+     * transport can resend overlapping ranges until they are acknowledged.
+     *
+     * @return `true` if the input was new.
+     */
+    bool AddRemoteInput(std::uint32_t remoteTick, InputSnapshot input);
+
+    /**
+     * @brief Gets the local input recorded for a tick that is still inside the history.
+     */
+    InputSnapshot GetLocalInput(std::uint32_t localTick) const {
+        return frames[localTick % HistoryTicks].inputs[localPlayer];
+    }
+
+    const PlayerSim &GetPlayer(std::uint32_t player) const { return players[player]; }
+
+    /**
+     * @brief Gets the number of ticks simulated so far, which is also the next tick to simulate.
+     */
+    std::uint32_t GetTick() const { return tick; }
+
+    /**
+     * @brief Gets the number of leading ticks whose remote input is known.
+     */
+    std::uint32_t GetRemoteTicks() const { return remoteTicks; }
+
+    std::uint32_t GetMaxRollback() const { return maxRollback; }
+
+    /**
+     * @brief Gets the number of remote inputs that differed from their prediction.
+     */
+    std::uint64_t GetMispredictions() const { return mispredictions; }
+
+    std::uint64_t GetRollbacks() const { return rollbacks; }
+
+    std::uint64_t GetResimulatedTicks() const { return resimulatedTicks; }
+
+private:
+    static constexpr std::uint32_t NoRollback = 0xFFFFFFFFu;
+
+    /**
+     * @brief Inputs of one tick and the state both racers had before it.
+     */
+    struct Frame {
+        std::array<InputSnapshot, Players> inputs{};
+        std::array<PlayerSim::Snapshot, Players> before{};
+    };
+
+    /**
+     * @brief Guesses the remote input of a tick that has not arrived yet.
+     *
+     * Held actions are assumed to stay held; presses are not repeated, since a repeated jump press is almost
+     * always wrong and costs a rollback.
+     */
+    InputSnapshot PredictRemote() const { return InputSnapshot{lastRemote.held, 0}; }
+
+    /**
+     * @brief Snapshots both racers and simulates one tick from the frame's inputs.
+     */
+    void Step(std::uint32_t stepTick);
+
+    std::array<PlayerSim, Players> players;
+    std::array<Frame, HistoryTicks> frames{};
+    std::uint32_t localPlayer;
+    std::uint32_t remotePlayer;
+    std::uint32_t maxRollback;
+    std::uint32_t tick = 0;
+    std::uint32_t remoteTicks = 0;
+    std::uint32_t rollbackTick = NoRollback;
+    InputSnapshot lastRemote{};
+    std::uint64_t mispredictions = 0;
+    std::uint64_t rollbacks = 0;
+    std::uint64_t resimulatedTicks = 0;
+};
+
+#endif //OOP_ROLLBACK_H
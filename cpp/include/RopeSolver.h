@@ -0,0 +1,80 @@
+#ifndef OOP_ROPESOLVER_H
+#define OOP_ROPESOLVER_H
+
+#include "../Core/Ropes.h"
+#include "../Core/World.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class RopeSolver
+ * @brief Steps the batches of a `Ropes` on a fixed pool of worker threads.
+ *
+ * The calling thread takes part: it wakes the workers, claims batches from the same shared cursor, and
+ * returns once every batch is done. Only as many workers as there are batches beyond the caller's are woken,
+ * so a pool larger than the batch count still splits the step; with one thread or one batch it runs inline.
+ */
+class RopeSolver {
+public:
+    /**
+     * @param threads Threads stepping ropes, the caller included, or 0 for one per hardware thread.
+     */
+    explicit RopeSolver(unsigned threads = 0);
+
+    ~RopeSolver();
+
+    RopeSolver(const RopeSolver &) = delete;
+
+    RopeSolver &operator=(const RopeSolver &) = delete;
+
+    /**
+     * @brief Advances every rope by one tick and blocks until all are done.
+     *
+     * @param ropes The ropes to step.
+     * @param delta The duration of the tick in seconds.
+     * @param gravity The downward acceleration in pixels per second squared.
+     * @param world The level whose solids the ropes rest against.
+     * @param iterations Constraint passes; more make the ropes stiffer.
+     */
+    void Step(Ropes &ropes, float delta, float gravity, const World &world,
+              int iterations = Ropes::DefaultIterations);
+
+    /**
+     * @brief Gets the number of threads stepping ropes, the caller included.
+     */
+    unsigned GetThreadCount() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+private:
+    /**
+     * @brief The work of one step, shared by the caller and the workers.
+     */
+    struct Job {
+        Ropes *ropes;
+        const World *world;
+        float delta;
+        float gravity;
+        int iterations;
+    };
+
+    void RunWorker();
+
+    void StepClaimed(const Job &claimed);
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    Job job{};
+    std::uint64_t generation = 0;
+    unsigned busyWorkers = 0;
+    unsigned openSlots = 0; // Workers still to join the current step
+    bool stopping = false;
+    std::atomic<std::size_t> cursor{0};
+};
+
+#endif //OOP_ROPESOLVER_H
@@ -0,0 +1,313 @@
+#ifndef OOP_SAVEGAME_H
+#define OOP_SAVEGAME_H
+
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Save files are read in place, so their little-endian layout must be the machine's own
+static_assert(std::endian::native == std::endian::little, "Save files are read in place and are little-endian");
+
+/**
+ * @brief The sections a save payload can hold; readers skip ids they do not know.
+ */
+enum class SaveSection : std::uint32_t {
+    Player = 1,    // One SavePlayer
+    Progress = 2,  // One SaveProgress
+    Mutations = 3, // Any number of SaveMutation
+};
+
+/**
+ * @struct SavePlayer
+ * @brief The player's state, as the movement rules need it to carry on.
+ */
+struct SavePlayer {
+    float positionX = 0.0f;
+    float positionY = 0.0f;
+    float velocityX = 0.0f;
+    float velocityY = 0.0f;
+    std::uint32_t mode = 0;    // Player::MovementMode value
+    std::uint32_t canJump = 0; // 0 or 1
+    std::uint64_t tick = 0;    // Physics tick the snapshot was taken on
+
+    /**
+     * @brief Stream insertion operator for the SavePlayer struct.
+     *
+     * @param os The output stream.
+     * @param player The SavePlayer instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const SavePlayer &player) {
+        os << "SavePlayer(Position: (" << player.positionX << ", " << player.positionY << "), Velocity: ("
+                << player.velocityX << ", " << player.velocityY << "), Mode: " << player.mode << ", CanJump: "
+                << (player.canJump != 0 ? "true" : "false") << ", Tick: " << player.tick << ")";
+        return os;
+    }
+};
+
+/**
+ * @struct SaveProgress
+ * @brief How far up the tower the run got.
+ */
+struct SaveProgress {
+    std::uint32_t levelId = 0;
+    float bestHeight = 0.0f;    // Highest point reached, in pixels above the spawn
+    std::uint64_t playTicks = 0; // Physics ticks played over every session
+
+    /**
+     * @brief Stream insertion operator for the SaveProgress struct.
+     *
+     * @param os The output stream.
+     * @param progress The SaveProgress instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const SaveProgress &progress) {
+        os << "SaveProgress(Level: " << progress.levelId << ", BestHeight: " << progress.bestHeight
+                << ", PlayTicks: " << progress.playTicks << ")";
+        return os;
+    }
+};
+
+/**
+ * @brief What a recorded change to the level did.
+ */
+enum class SaveMutationKind : std::uint32_t {
+    Carve = 0, // A hole cut with World::Carve
+};
+
+/**
+ * @struct SaveMutation
+ * @brief One change to the level since it was built, replayed in order when a save is loaded.
+ */
+struct SaveMutation {
+    SaveMutationKind kind = SaveMutationKind::Carve;
+    std::uint32_t reserved = 0;
+    float minX = 0.0f;
+    float minY = 0.0f;
+    float maxX = 0.0f;
+    float maxY = 0.0f;
+};
+
+static_assert(sizeof(SavePlayer) == 32 && sizeof(SaveProgress) == 16 && sizeof(SaveMutation) == 24,
+              "Save records are part of the file format");
+
+/**
+ * @struct SaveState
+ * @brief Everything a save holds, as the game thread assembles it.
+ */
+struct SaveState {
+    SavePlayer player;
+    SaveProgress progress;
+    std::vector<SaveMutation> mutations;
+};
+
+/**
+ * @class SaveView
+ * @brief Reads a save payload in place: every accessor points straight into the buffer.
+ *
+ * `Open` only checks that the section table and the sections lie inside the buffer; nothing is decoded or
+ * copied. The buffer must stay alive and 8-byte aligned for as long as the view is used.
+ */
+class SaveView {
+public:
+    /**
+     * @brief Points the view at a payload.
+     *
+     * @param payload The payload, 8-byte aligned.
+     * @param bytes The size of the payload.
+     * @return `false` if the section table or a known section is out of bounds or has the wrong record size.
+     */
+    bool Open(const std::uint8_t *payload, std::size_t bytes);
+
+    /**
+     * @brief Gets the saved player, or null if the save has none.
+     */
+    const SavePlayer *GetPlayer() const { return player; }
+
+    /**
+     * @brief Gets the saved progress, or null if the save has none.
+     */
+    const SaveProgress *GetProgress() const { return progress; }
+
+    /**
+     * @brief Gets the saved level changes, oldest first.
+     */
+    std::span<const SaveMutation> GetMutations() const { return mutations; }
+
+private:
+    const SavePlayer *player = nullptr;
+    const SaveProgress *progress = nullptr;
+    std::span<const SaveMutation> mutations;
+};
+
+/**
+ * @class SaveGame
+ * @brief The versioned save file format.
+ *
+ * A payload is a section table followed by the sections, each 8-byte aligned and stored exactly as the
+ * structs above lie in memory, so `SaveView` can read one without parsing. Payload layout (little-endian):
+ * u32 section count, u32 reserved, then per section u32 id, u32 record count, u64 offset from the payload
+ * start and u64 byte size.
+ *
+ * A file is a 40-byte header, "OOPSAVEG", u32 version, u32 flags, u64 payload size, u64 stored size and
+ * the FNV-1a hash of the payload, followed by the payload, LZ-compressed if `FlagCompressed` is set.
+ *
+ * Records never change size: a later version that needs more data adds a section and bumps `Version` only
+ * if older readers would misread the file. Readers reject versions newer than their own.
+ */
+class SaveGame {
+public:
+    static constexpr std::uint32_t Version = 1;
+
+    static constexpr std::uint32_t FlagCompressed = 1u << 0;
+
+    /**
+     * @brief Lays a state out as a payload; only copies, so it is cheap enough for the game thread.
+     *
+     * @param state The state to save.
+     * @param payload Receives the payload; 64-bit words keep it aligned. Only grows if it is too small.
+     * @return The size of the payload in bytes.
+     */
+    static std::size_t Serialize(const SaveState &state, std::vector<std::uint64_t> &payload);
+
+    /**
+     * @brief Hashes bytes with 64-bit FNV-1a.
+     */
+    static std::uint64_t Checksum(const std::uint8_t *bytes, std::size_t size);
+
+    /**
+     * @brief Compresses bytes with a small LZ77 coder: runs of literals and back-references within 64 KiB.
+     *
+     * @param in The bytes to compress.
+     * @param size The number of bytes.
+     * @param out Receives the compressed bytes; cleared first.
+     */
+    static void Compress(const std::uint8_t *in, std::size_t size, std::vector<std::uint8_t> &out);
+
+    /**
+     * @brief Reverses `Compress`.
+     *
+     * @param in The compressed bytes.
+     * @param size The number of compressed bytes.
+     * @param out Receives exactly `outSize` bytes.
+     * @param outSize The size of the original bytes.
+     * @return `false` if the input is corrupt or does not decompress to exactly `outSize` bytes.
+     */
+    static bool Decompress(const std::uint8_t *in, std::size_t size, std::uint8_t *out, std::size_t outSize);
+
+    /**
+     * @brief Writes a payload to a file so that a crash leaves either the old save or the new one.
+     *
+     * The file is written next to `path`, flushed to disk with `fsync`, and renamed over `path`.
+     *
+     * @param path The save file.
+     * @param payload The payload, as produced by `Serialize`.
+     * @param bytes The size of the payload.
+     * @param compress Whether to compress the payload.
+     * @param scratch Holds the compressed payload; kept by the caller to avoid reallocating.
+     * @return `true` if the save is durably on disk.
+     */
+    static bool Write(const std::string &path, const std::uint8_t *payload, std::size_t bytes, bool compress,
+                      std::vector<std::uint8_t> &scratch);
+};
+
+/**
+ * @class SaveFile
+ * @brief A save file loaded into memory and checked, readable through `GetView`.
+ */
+class SaveFile {
+public:
+    /**
+     * @brief Reads, decompresses and checks a save file.
+     *
+     * @param path The file to read.
+     * @return `false` if the file is missing, from a newer version, truncated or fails its checksum.
+     */
+    bool Load(const std::string &path);
+
+    const SaveView &GetView() const { return view; }
+
+    std::uint32_t GetVersion() const { return version; }
+
+private:
+    std::vector<std::uint64_t> storage; // The payload, aligned for in-place reads
+    SaveView view;
+    std::uint32_t version = 0;
+};
+
+/**
+ * @class Autosaver
+ * @brief Saves snapshots of the game on a background thread.
+ *
+ * `Snapshot` copies the state into a payload on the game thread, which takes microseconds, and hands it to
+ * the writer thread. The writer hashes, compresses and durably writes it with `SaveGame::Write`. A snapshot
+ * taken while the previous one is still being written replaces any snapshot still waiting, so a slow disk
+ * only skips saves, never queues them up.
+ */
+class Autosaver {
+public:
+    /**
+     * @param path The save file to keep up to date.
+     * @param compress Whether to compress the saves.
+     */
+    explicit Autosaver(std::string path, bool compress = true);
+
+    /**
+     * @brief Writes the snapshot still waiting, if any, and stops the writer thread.
+     */
+    ~Autosaver();
+
+    Autosaver(const Autosaver &) = delete;
+
+    Autosaver &operator=(const Autosaver &) = delete;
+
+    /**
+     * @brief Takes a snapshot of the state and queues it for writing.
+     *
+     * Does not allocate unless the state outgrew every earlier snapshot.
+     */
+    void Snapshot(const SaveState &state);
+
+    /**
+     * @brief Blocks until every snapshot taken so far is on disk or has failed.
+     */
+    void Flush();
+
+    /**
+     * @brief Gets the number of saves written.
+     */
+    std::uint64_t GetSavesWritten() const { return savesWritten.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the number of saves that could not be written.
+     */
+    std::uint64_t GetFailures() const { return failures.load(std::memory_order_relaxed); }
+
+private:
+    void RunWriter();
+
+    std::string path;
+    bool compress;
+    std::vector<std::uint64_t> staging; // Filled by the game thread
+    std::vector<std::uint64_t> pending; // Waiting for the writer
+    std::size_t pendingBytes = 0;
+    bool hasPending = false;
+    bool writing = false;
+    bool stopping = false;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::thread writer;
+    std::atomic<std::uint64_t> savesWritten{0};
+    std::atomic<std::uint64_t> failures{0};
+};
+
+#endif //OOP_SAVEGAME_H
@@ -0,0 +1,234 @@
+#ifndef OOP_TELEMETRY_H
+#define OOP_TELEMETRY_H
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The per-tick values recorded by `TelemetryRecorder`, one file each.
+ */
+enum class TelemetryColumn : std::uint8_t {
+    PositionX,
+    PositionY,
+    VelocityX,
+    VelocityY,
+    CanJump,
+    Surface,
+    CollisionFlags,
+    Count
+};
+
+/**
+ * @brief Bits of `TelemetrySample::collisionFlags`.
+ */
+enum TelemetryCollision : std::uint8_t {
+    TELEMETRY_ON_FLOOR = 1u << 0,
+    TELEMETRY_ON_WALL = 1u << 1,
+    TELEMETRY_ON_CEILING = 1u << 2,
+};
+
+/**
+ * @struct TelemetrySample
+ * @brief The player's state for one tick.
+ */
+struct TelemetrySample {
+    float positionX;
+    float positionY;
+    float velocityX;
+    float velocityY;
+    bool canJump;
+    std::uint8_t surface;        // SurfaceMaterialId of the floor underfoot; 0 in the air or on unknown floors
+    std::uint8_t collisionFlags; // TelemetryCollision bits
+
+    /**
+     * @brief Stream insertion operator for the TelemetrySample struct.
+     *
+     * @param os The output stream.
+     * @param sample The TelemetrySample instance to output.
+     * @return A reference to the updated output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const TelemetrySample &sample) {
+        os << "TelemetrySample(Position: (" << sample.positionX << ", " << sample.positionY << "), Velocity: ("
+                << sample.velocityX << ", " << sample.velocityY << "), CanJump: "
+                << (sample.canJump ? "true" : "false") << ", Surface: " << static_cast<unsigned>(sample.surface)
+                << ", CollisionFlags: " << static_cast<unsigned>(sample.collisionFlags) << ")";
+        return os;
+    }
+};
+
+/**
+ * @class TelemetryRecorder
+ * @brief Writes per-tick telemetry into one chunked, compressed file per column.
+ *
+ * Samples are buffered as integer columns (floats are quantized to 1/`Scale` units) and every `ChunkTicks`
+ * ticks each column is delta-encoded, zigzag-mapped and written as LEB128 varints into its own file. Slowly
+ * changing values such as positions shrink to one or two bytes per tick, and analysis tools only read the
+ * columns they need. All buffers are allocated up front, so recording a tick never allocates.
+ *
+ * Each column file starts with the magic "OOPTCOL1", the column id and the scale, followed by chunks of
+ * `[uint32 tick count][uint32 byte size][varints]`.
+ */
+class TelemetryRecorder {
+public:
+    /**
+     * @brief Ticks buffered before a chunk is encoded and written.
+     */
+    static constexpr std::uint32_t ChunkTicks = 4096;
+
+    /**
+     * @brief Quantization of float columns: values are stored in units of 1/Scale.
+     */
+    static constexpr std::int32_t Scale = 64;
+
+    /**
+     * @brief Opens one column file per column inside an existing directory.
+     *
+     * @param directory The directory to write into.
+     */
+    explicit TelemetryRecorder(const std::string &directory);
+
+    /**
+     * @brief Flushes the last partial chunk and closes the files.
+     */
+    ~TelemetryRecorder();
+
+    TelemetryRecorder(const TelemetryRecorder &) = delete;
+
+    TelemetryRecorder &operator=(const TelemetryRecorder &) = delete;
+
+    /**
+     * @brief Checks whether every column file was opened.
+     */
+    bool IsOpen() const;
+
+    /**
+     * @brief Records one tick.
+     *
+     * @param sample The player's state this tick.
+     */
+    void Record(const TelemetrySample &sample);
+
+    /**
+     * @brief Encodes and writes the buffered ticks as a chunk.
+     */
+    void Flush();
+
+    /**
+     * @brief Gets the file name of a column, relative to the telemetry directory.
+     */
+    static const char *GetFileName(TelemetryColumn column);
+
+    /**
+     * @brief Gets the number of ticks recorded so far.
+     */
+    std::uint64_t GetTickCount() const { return ticks; }
+
+private:
+    static constexpr std::size_t ColumnCount = static_cast<std::size_t>(TelemetryColumn::Count);
+
+    std::array<std::FILE *, ColumnCount> files{};
+    std::array<std::vector<std::int32_t>, ColumnCount> columns;
+    std::vector<std::uint8_t> encoded;
+    std::uint32_t buffered = 0;
+    std::uint64_t ticks = 0;
+};
+
+/**
+ * @class TelemetryColumnReader
+ * @brief Memory-maps one column file and decodes it for offline analysis.
+ *
+ * The file is mapped read-only, so iterating a column of millions of ticks touches only that column's bytes
+ * and never copies the file.
+ */
+class TelemetryColumnReader {
+public:
+    /**
+     * @brief Maps a column file.
+     *
+     * @param path The column file to read.
+     */
+    explicit TelemetryColumnReader(const std::string &path);
+
+    /**
+     * @brief Unmaps the file.
+     */
+    ~TelemetryColumnReader();
+
+    TelemetryColumnReader(const TelemetryColumnReader &) = delete;
+
+    TelemetryColumnReader &operator=(const TelemetryColumnReader &) = delete;
+
+    /**
+     * @brief Checks whether the file was mapped and has a valid header.
+     */
+    bool IsOpen() const { return data != nullptr; }
+
+    /**
+     * @brief Gets the column stored in the file.
+     */
+    TelemetryColumn GetColumn() const { return column; }
+
+    /**
+     * @brief Calls `visit(tick, value)` for every tick, in order; float columns are dequantized.
+     *
+     * @param visit The callback receiving the tick index and the value.
+     * @return The number of ticks visited.
+     */
+    template<typename Visitor>
+    std::uint64_t ForEach(Visitor visit) const;
+
+    /**
+     * @brief Decodes the whole column.
+     *
+     * @return One value per tick.
+     */
+    std::vector<double> ReadAll() const;
+
+private:
+    const std::uint8_t *data = nullptr;
+    std::size_t size = 0;
+    TelemetryColumn column = TelemetryColumn::Count;
+    double scale = 1.0;
+    std::vector<std::uint8_t> fallback; // Backing storage where memory mapping is unavailable
+};
+
+template<typename Visitor>
+std::uint64_t TelemetryColumnReader::ForEach(Visitor visit) const {
+    constexpr std::size_t HeaderBytes = 16;
+    std::uint64_t tick = 0;
+    std::size_t offset = HeaderBytes;
+    while (data != nullptr && offset + 8 <= size) {
+        std::uint32_t count = 0;
+        std::uint32_t bytes = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            count |= static_cast<std::uint32_t>(data[offset + shift / 8]) << shift;
+            bytes |= static_cast<std::uint32_t>(data[offset + 4 + shift / 8]) << shift;
+        }
+        offset += 8;
+        const std::size_t end = offset + bytes <= size ? offset + bytes : size;
+
+        std::int32_t previous = 0;
+        for (std::uint32_t index = 0; index < count && offset < end; ++index) {
+            std::uint32_t zigzag = 0;
+            for (int shift = 0; offset < end && shift < 35; shift += 7) {
+                const std::uint8_t byte = data[offset++];
+                zigzag |= static_cast<std::uint32_t>(byte & 0x7Fu) << shift;
+                if ((byte & 0x80u) == 0) {
+                    break;
+                }
+            }
+            const auto delta = static_cast<std::int32_t>((zigzag >> 1) ^ (~(zigzag & 1u) + 1u));
+            previous = static_cast<std::int32_t>(static_cast<std::uint32_t>(previous) +
+                                                 static_cast<std::uint32_t>(delta));
+            visit(tick++, static_cast<double>(previous) / scale);
+        }
+        offset = end;
+    }
+    return tick;
+}
+
+#endif //OOP_TELEMETRY_H
@@ -1,16 +1,94 @@
+#include <chrono>
 #include <iostream>
+#include <string>
+#include <vector>
 
+#include "include/AllocationTracker.h"
+#include "include/Counters.h"
+#include "include/FrameHistogram.h"
 #include "include/Helper.h"
+#include "include/Profiler.h"
+#include "include/Replay.h"
 
-#include "Objects/Player.cpp"
-#include "Objects/Environment.h"
-#include <godot_cpp/core/class_db.hpp>
+#include "Core/PlayerSim.h"
+#include "Core/World.h"
 
-using namespace godot;
+/**
+ * @file main.cpp
+ * @brief Headless driver: runs the gameplay core without Godot.
+ *
+ * Usage: oop [REPLAY...]
+ *
+ * Every replay is simulated tick by tick with the same counters, histograms and zones the game records, then
+ * checked against the result it claims. Without arguments a built-in synthetic replay is played.
+ */
 
-int main() {
+namespace {
+    /**
+     * @brief Simulates one replay, timing every tick.
+     *
+     * @return `true` if the replay reached its claimed result.
+     */
+    bool Play(const Replay &replay, std::uint64_t &tick) {
+        PROFILE_ZONE("Driver::Play");
+        const World world = World::MakeTower(replay.levelId);
+        PlayerSim sim(world, replay.mode);
+        for (const InputSnapshot &input: replay.inputs) {
+            const auto tickStart = std::chrono::steady_clock::now();
+            Counters::BeginTick(tick++);
+            sim.Step(input);
+            FrameHistogram::PhysicsTicks().Record(static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - tickStart).count()));
+        }
+
+        const ReplayResult result{sim.GetTickCount(), sim.GetPositionX(), sim.GetPositionY(), sim.GetStateHash()};
+        std::cout << sim << "\n";
+        if (result != replay.claimed) {
+            std::cerr << "Replay diverged: claimed " << replay.claimed << ", got " << result << "\n";
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char **argv) {
     Helper helper;
     helper.help();
 
-    return 0;
+    std::vector<Replay> replays;
+    for (int index = 1; index < argc; ++index) {
+        Replay replay;
+        if (!replay.Load(argv[index])) {
+            std::cerr << argv[index] << " is not a replay\n";
+            return 2;
+        }
+        replays.push_back(std::move(replay));
+    }
+    if (replays.empty()) {
+        replays.push_back(Replay::Generate(0, 600));
+    }
+
+    bool verified = true;
+    std::uint64_t tick = 0;
+    for (const Replay &replay: replays) {
+        verified = Play(replay, tick) && verified;
+    }
+
+    // Summarize the gameplay counters of the run
+    Counters::Flush();
+    Counters::WriteTable(std::cout);
+    AllocationTracker::WriteZoneTable(std::cout);
+
+    // Report the tail latencies of every simulated tick
+    std::cout << "Physics ticks: " << FrameHistogram::PhysicsTicks() << "\n";
+
+#ifdef OOP_PROFILING
+    // Export every zone recorded during the run
+    if (!Profiler::WriteChromeTrace("profile.json")) {
+        std::cerr << "Could not write profile.json\n";
+    }
+#endif
+
+    return verified ? 0 : 1;
 }
@@ -0,0 +1,69 @@
+#include "register_types.h"
+
+#include "Objects/CameraActivation.h"
+#include "Objects/CounterMonitors.h"
+#include "Objects/EnvironmentElement.h"
+#include "Objects/FrameStats.h"
+#include "Objects/HazardSystem.h"
+#include "Objects/Ice.h"
+#include "Objects/InputActions.h"
+#include "Objects/PlatformSystem.h"
+#include "Objects/Player.h"
+#include "Objects/RopeSystem.h"
+#include "Objects/Wind.h"
+
+#include <gdextension_interface.h>
+#include <godot_cpp/core/defs.hpp>
+#include <godot_cpp/godot.hpp>
+
+/**
+ * @brief Registers the extension's classes with Godot.
+ *
+ * Base classes go first. `Walls` is not registered: it has no default constructor and its bound getters return
+ * `std::array`, which Godot cannot marshal.
+ *
+ * @param level The initialization level being entered.
+ */
+void initialize_oop_module(ModuleInitializationLevel level) {
+    if (level != MODULE_INITIALIZATION_LEVEL_SCENE) {
+        return;
+    }
+    InputActions::Initialize();
+    GDREGISTER_CLASS(EnvironmentElement);
+    GDREGISTER_CLASS(Ice);
+    GDREGISTER_CLASS(Wind);
+    GDREGISTER_CLASS(Player);
+    GDREGISTER_CLASS(FrameStats);
+    GDREGISTER_CLASS(CameraActivation);
+    GDREGISTER_CLASS(HazardSystem);
+    GDREGISTER_CLASS(PlatformSystem);
+    GDREGISTER_CLASS(RopeSystem);
+}
+
+/**
+ * @brief Removes the debugger monitors added while the extension was loaded and releases the interned names.
+ *
+ * @param level The initialization level being left.
+ */
+void uninitialize_oop_module(ModuleInitializationLevel level) {
+    if (level != MODULE_INITIALIZATION_LEVEL_SCENE) {
+        return;
+    }
+    CounterMonitors::Unregister();
+    InputActions::Uninitialize();
+}
+
+extern "C" {
+/**
+ * @brief Entry point named by `oop.gdextension`.
+ */
+GDExtensionBool GDE_EXPORT oop_library_init(GDExtensionInterfaceGetProcAddress getProcAddress,
+                                            GDExtensionClassLibraryPtr library,
+                                            GDExtensionInitialization *initialization) {
+    GDExtensionBinding::InitObject init(getProcAddress, library, initialization);
+    init.register_initializer(initialize_oop_module);
+    init.register_terminator(uninitialize_oop_module);
+    init.set_minimum_library_initialization_level(MODULE_INITIALIZATION_LEVEL_SCENE);
+    return init.init();
+}
+}
@@ -0,0 +1,22 @@
+#ifndef OOP_REGISTER_TYPES_H
+#define OOP_REGISTER_TYPES_H
+
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+/**
+ * @brief Registers the extension's classes with Godot.
+ *
+ * @param level The initialization level being entered; classes are registered at the scene level.
+ */
+void initialize_oop_module(ModuleInitializationLevel level);
+
+/**
+ * @brief Cleans up what the extension added to the engine.
+ *
+ * @param level The initialization level being left.
+ */
+void uninitialize_oop_module(ModuleInitializationLevel level);
+
+#endif // OOP_REGISTER_TYPES_H
@@ -0,0 +1,85 @@
+#include <AllocationTracker.h>
+#include <Counters.h>
+#include <Profiler.h>
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+
+namespace {
+    std::atomic<std::uint64_t> allocationCount{0};
+    std::atomic<std::uint64_t> allocatedBytes{0};
+
+    /**
+     * @brief One row of the per-zone table; the name is claimed once with a compare-exchange.
+     */
+    struct ZoneSlot {
+        std::atomic<const char *> zone{nullptr};
+        std::atomic<std::uint64_t> count{0};
+    };
+
+    // Slot 0 collects allocations outside any zone and overflow once the table is full
+    std::array<ZoneSlot, AllocationTracker::MaxZones> zoneSlots;
+
+    ZoneSlot &FindZoneSlot(const char *zone) {
+        if (zone == nullptr) {
+            return zoneSlots[0];
+        }
+        for (std::size_t index = 1; index < zoneSlots.size(); ++index) {
+            const char *claimed = zoneSlots[index].zone.load(std::memory_order_acquire);
+            if (claimed == zone) {
+                return zoneSlots[index];
+            }
+            if (claimed == nullptr) {
+                const char *expected = nullptr;
+                if (zoneSlots[index].zone.compare_exchange_strong(expected, zone, std::memory_order_acq_rel) ||
+                    expected == zone) {
+                    return zoneSlots[index];
+                }
+            }
+        }
+        return zoneSlots[0];
+    }
+}
+
+void AllocationTracker::OnAllocate(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    Counters::Add(Counter::Allocations);
+
+    const char *zone = Profiler::GetCurrentZone();
+    FindZoneSlot(zone).count.fetch_add(1, std::memory_order_relaxed);
+
+    if (guardedScope != nullptr && allowDepth == 0) {
+        // Report with stdio only: anything that allocates here would recurse into this hook
+        std::fprintf(stderr, "Allocation of %zu bytes inside no-allocation scope '%s' (zone '%s')\n",
+                     size, guardedScope, zone != nullptr ? zone : "none");
+        std::fflush(stderr);
+        std::abort();
+    }
+}
+
+std::uint64_t AllocationTracker::GetAllocationCount() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocationTracker::GetAllocatedBytes() {
+    return allocatedBytes.load(std::memory_order_relaxed);
+}
+
+void AllocationTracker::WriteZoneTable(std::ostream &os) {
+    const std::ios::fmtflags flags = os.flags();
+    os << std::left << std::setw(40) << "Zone" << std::right << std::setw(16) << "Allocations" << "\n";
+    for (std::size_t index = 0; index < zoneSlots.size(); ++index) {
+        const std::uint64_t count = zoneSlots[index].count.load(std::memory_order_relaxed);
+        if (count == 0) {
+            continue;
+        }
+        const char *zone = zoneSlots[index].zone.load(std::memory_order_acquire);
+        os << std::left << std::setw(40) << (zone != nullptr ? zone : "(no zone)") << std::right
+                << std::setw(16) << count << "\n";
+    }
+    os.flags(flags);
+}
@@ -0,0 +1,232 @@
+#include <BinaryLog.h>
+#include <AllocationTracker.h>
+#include <Profiler.h>
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+std::atomic<bool> BinaryLog::running{false};
+
+namespace {
+    constexpr std::uint16_t PaddingId = 0xFFFF;
+    constexpr std::uint32_t HeaderBytes = 16;
+
+    /**
+     * @brief The fixed header in front of every record in a ring.
+     */
+    struct RecordHeader {
+        std::uint16_t id;
+        std::uint16_t size;
+        std::uint32_t reserved;
+        std::uint64_t timestamp;
+    };
+
+    static_assert(sizeof(RecordHeader) == HeaderBytes);
+
+    constexpr std::uint64_t AlignedSize(std::uint32_t payload) {
+        return (HeaderBytes + payload + 7u) & ~std::uint64_t{7};
+    }
+
+    /**
+     * @brief A single-producer, single-consumer byte ring owned by one logging thread.
+     *
+     * `head` and `tail` count bytes ever written and consumed. A record never wraps: when it does not fit
+     * before the end of the storage, the producer skips to the start, leaving a padding marker if there is
+     * room for a header.
+     */
+    struct LogRing {
+        std::array<unsigned char, BinaryLog::RingBytes> bytes{};
+        std::atomic<std::uint64_t> head{0};
+        std::atomic<std::uint64_t> tail{0};
+        std::uint32_t threadId = 0;
+    };
+
+    struct LogFormat {
+        const char *text;
+        std::string codes;
+    };
+
+    /**
+     * @brief Everything shared between logging threads and the writer thread.
+     */
+    struct LogState {
+        std::mutex mutex; // Guards rings, formats and the writer thread itself
+        std::vector<std::unique_ptr<LogRing> > rings;
+        std::vector<LogFormat> formats;
+        std::size_t emittedFormats = 0;
+        std::ofstream file;
+        std::thread writer;
+        std::condition_variable wake;
+        bool stopping = false;
+        std::atomic<std::uint64_t> dropped{0};
+    };
+
+    LogState &GetState() {
+        static LogState state;
+        return state;
+    }
+
+    LogRing &GetThreadRing() {
+        thread_local LogRing *ring = [] {
+            const AllowAllocationScope allow;
+            LogState &state = GetState();
+            const std::lock_guard lock(state.mutex);
+            state.rings.push_back(std::make_unique<LogRing>());
+            state.rings.back()->threadId = static_cast<std::uint32_t>(state.rings.size());
+            return state.rings.back().get();
+        }();
+        return *ring;
+    }
+
+    template<typename T>
+    void Append(std::vector<char> &buffer, const T &value) {
+        const auto *bytes = reinterpret_cast<const char *>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    /**
+     * @brief Moves everything logged so far into the file; the caller holds the state mutex.
+     */
+    void Drain(LogState &state, std::vector<char> &buffer) {
+        // Snapshot the heads first: any format used by these records was registered before they were written
+        std::vector<std::uint64_t> heads;
+        heads.reserve(state.rings.size());
+        for (const auto &ring: state.rings) {
+            heads.push_back(ring->head.load(std::memory_order_acquire));
+        }
+
+        buffer.clear();
+        for (; state.emittedFormats < state.formats.size(); ++state.emittedFormats) {
+            const LogFormat &format = state.formats[state.emittedFormats];
+            const auto textLength = static_cast<std::uint16_t>(std::strlen(format.text));
+            buffer.push_back('F');
+            Append(buffer, static_cast<std::uint16_t>(state.emittedFormats));
+            Append(buffer, static_cast<std::uint8_t>(format.codes.size()));
+            Append(buffer, textLength);
+            buffer.insert(buffer.end(), format.codes.begin(), format.codes.end());
+            buffer.insert(buffer.end(), format.text, format.text + textLength);
+        }
+
+        for (std::size_t index = 0; index < state.rings.size(); ++index) {
+            LogRing &ring = *state.rings[index];
+            std::uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+            while (tail < heads[index]) {
+                const std::uint64_t offset = tail % BinaryLog::RingBytes;
+                const std::uint64_t toEnd = BinaryLog::RingBytes - offset;
+                if (toEnd < HeaderBytes) {
+                    tail += toEnd;
+                    continue;
+                }
+                RecordHeader header{};
+                std::memcpy(&header, ring.bytes.data() + offset, HeaderBytes);
+                if (header.id == PaddingId) {
+                    tail += toEnd;
+                    continue;
+                }
+                buffer.push_back('R');
+                Append(buffer, header.id);
+                Append(buffer, ring.threadId);
+                Append(buffer, header.timestamp);
+                Append(buffer, header.size);
+                const auto *payload = reinterpret_cast<const char *>(ring.bytes.data() + offset + HeaderBytes);
+                buffer.insert(buffer.end(), payload, payload + header.size);
+                tail += AlignedSize(header.size);
+            }
+            ring.tail.store(tail, std::memory_order_release);
+        }
+        state.file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+
+    void RunWriter() {
+        LogState &state = GetState();
+        std::vector<char> buffer;
+        std::unique_lock lock(state.mutex);
+        while (!state.stopping) {
+            Drain(state, buffer);
+            state.wake.wait_for(lock, std::chrono::milliseconds(2));
+        }
+        Drain(state, buffer);
+        state.file.flush();
+    }
+}
+
+std::uint16_t BinaryLog::RegisterFormat(const char *text, const char *codes) {
+    const AllowAllocationScope allow;
+    LogState &state = GetState();
+    const std::lock_guard lock(state.mutex);
+    state.formats.push_back(LogFormat{text, codes});
+    return static_cast<std::uint16_t>(state.formats.size() - 1);
+}
+
+bool BinaryLog::Start(const std::string &path) {
+    LogState &state = GetState();
+    const std::lock_guard lock(state.mutex);
+    if (state.writer.joinable()) {
+        return false;
+    }
+    state.file.open(path, std::ios::binary | std::ios::trunc);
+    if (!state.file) {
+        return false;
+    }
+    state.file.write("OOPBLOG1", 8);
+    // Formats registered in an earlier session have to be written again for the new file
+    state.emittedFormats = 0;
+    for (const auto &ring: state.rings) {
+        ring->tail.store(ring->head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+    state.stopping = false;
+    state.writer = std::thread(RunWriter);
+    running.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+void BinaryLog::Stop() {
+    LogState &state = GetState();
+    running.store(false, std::memory_order_relaxed);
+    {
+        const std::lock_guard lock(state.mutex);
+        if (!state.writer.joinable()) {
+            return;
+        }
+        state.stopping = true;
+    }
+    state.wake.notify_all();
+    state.writer.join();
+    const std::lock_guard lock(state.mutex);
+    state.file.close();
+}
+
+std::uint64_t BinaryLog::GetDroppedCount() {
+    return GetState().dropped.load(std::memory_order_relaxed);
+}
+
+void BinaryLog::WriteRecord(std::uint16_t id, const void *payload, std::uint16_t size) {
+    LogRing &ring = GetThreadRing();
+    const std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+    const std::uint64_t tail = ring.tail.load(std::memory_order_acquire);
+    const std::uint64_t offset = head % RingBytes;
+    const std::uint64_t toEnd = RingBytes - offset;
+    const std::uint64_t total = AlignedSize(size);
+    const std::uint64_t skip = toEnd < total ? toEnd : 0;
+
+    if (head + skip + total - tail > RingBytes) {
+        GetState().dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (skip >= HeaderBytes) {
+        const RecordHeader padding{PaddingId, 0, 0, 0};
+        std::memcpy(ring.bytes.data() + offset, &padding, HeaderBytes);
+    }
+
+    const std::uint64_t start = (head + skip) % RingBytes;
+    const RecordHeader header{id, size, 0, Profiler::Now()};
+    std::memcpy(ring.bytes.data() + start, &header, HeaderBytes);
+    std::memcpy(ring.bytes.data() + start + HeaderBytes, payload, size);
+    ring.head.store(head + skip + total, std::memory_order_release);
+}
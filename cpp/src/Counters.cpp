@@ -0,0 +1,60 @@
+#include <Counters.h>
+
+#include <iomanip>
+
+std::array<Counters::Slot, static_cast<std::size_t>(Counter::Count)> Counters::slots;
+std::atomic<std::uint64_t> Counters::currentTick{UINT64_MAX};
+constinit thread_local std::array<std::uint64_t, static_cast<std::size_t>(Counter::Count)> Counters::pending{};
+
+const char *Counters::GetName(Counter counter) {
+    switch (counter) {
+        case Counter::CollisionTests:
+            return "Collision Tests";
+        case Counter::BroadphaseCandidates:
+            return "Broadphase Candidates";
+        case Counter::MoveAndSlideCalls:
+            return "Move And Slide Calls";
+        case Counter::Allocations:
+            return "Allocations";
+        case Counter::GodotMemoryGrowth:
+            return "Godot Memory Growth";
+        case Counter::ResimulatedTicks:
+            return "Resimulated Ticks";
+        default:
+            return "Unknown";
+    }
+}
+
+void Counters::Flush() {
+    for (std::size_t index = 0; index < pending.size(); ++index) {
+        if (pending[index] != 0) {
+            slots[index].total.fetch_add(pending[index], std::memory_order_relaxed);
+            pending[index] = 0;
+        }
+    }
+}
+
+void Counters::BeginTick(std::uint64_t tick) {
+    Flush();
+    // Only the caller that swaps in the new tick number rolls the counters over
+    if (currentTick.exchange(tick, std::memory_order_acq_rel) == tick) {
+        return;
+    }
+    for (Slot &slot: slots) {
+        const std::uint64_t total = slot.total.load(std::memory_order_relaxed);
+        slot.lastTick.store(total - slot.tickStart.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        slot.tickStart.store(total, std::memory_order_relaxed);
+    }
+}
+
+void Counters::WriteTable(std::ostream &os) {
+    const std::ios::fmtflags flags = os.flags();
+    os << std::left << std::setw(24) << "Counter" << std::right << std::setw(16) << "Total"
+            << std::setw(16) << "Last Tick" << "\n";
+    for (std::size_t index = 0; index < slots.size(); ++index) {
+        const auto counter = static_cast<Counter>(index);
+        os << std::left << std::setw(24) << GetName(counter) << std::right << std::setw(16) << GetTotal(counter)
+                << std::setw(16) << GetLastTick(counter) << "\n";
+    }
+    os.flags(flags);
+}
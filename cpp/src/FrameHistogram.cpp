@@ -0,0 +1,82 @@
+#include <FrameHistogram.h>
+
+#include <bit>
+#include <iomanip>
+
+std::size_t FrameHistogram::GetIndex(std::uint64_t value) {
+    if (value < SubBucketCount) {
+        return static_cast<std::size_t>(value);
+    }
+    // Keep the top SubBucketBits bits of the value; the shift says which power-of-two group it falls in
+    const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - SubBucketBits;
+    return static_cast<std::size_t>(shift * HalfCount + (value >> shift));
+}
+
+std::uint64_t FrameHistogram::GetUpperEdge(std::size_t index) {
+    if (index < SubBucketCount) {
+        return index;
+    }
+    const std::uint64_t shift = (index - SubBucketCount) / HalfCount + 1;
+    const std::uint64_t mantissa = index - shift * HalfCount;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void FrameHistogram::Record(std::uint64_t nanoseconds) {
+    const std::uint64_t value = nanoseconds < MaxValue ? nanoseconds : MaxValue;
+    ++buckets[GetIndex(value)];
+    ++count;
+    sum += value;
+    max = value > max ? value : max;
+}
+
+std::uint64_t FrameHistogram::GetPercentile(double percentile) const {
+    if (count == 0) {
+        return 0;
+    }
+    const double clamped = percentile < 0.0 ? 0.0 : (percentile > 100.0 ? 100.0 : percentile);
+    auto target = static_cast<std::uint64_t>(clamped / 100.0 * static_cast<double>(count) + 0.5);
+    target = target == 0 ? 1 : target;
+
+    std::uint64_t seen = 0;
+    for (std::size_t index = 0; index < BucketCount; ++index) {
+        seen += buckets[index];
+        if (seen >= target) {
+            const std::uint64_t edge = GetUpperEdge(index);
+            return edge < max ? edge : max;
+        }
+    }
+    return max;
+}
+
+void FrameHistogram::Reset() {
+    buckets.fill(0);
+    count = 0;
+    sum = 0;
+    max = 0;
+}
+
+FrameHistogram &FrameHistogram::PhysicsTicks() {
+    static FrameHistogram histogram;
+    return histogram;
+}
+
+FrameHistogram &FrameHistogram::RenderFrames() {
+    static FrameHistogram histogram;
+    return histogram;
+}
+
+std::ostream &operator<<(std::ostream &os, const FrameHistogram &histogram) {
+    const std::ios::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+    const auto ms = [](std::uint64_t nanoseconds) { return static_cast<double>(nanoseconds) / 1'000'000.0; };
+    os << std::fixed << std::setprecision(3)
+            << "FrameHistogram(Count: " << histogram.GetCount()
+            << ", p50: " << ms(histogram.GetPercentile(50.0)) << " ms"
+            << ", p90: " << ms(histogram.GetPercentile(90.0)) << " ms"
+            << ", p99: " << ms(histogram.GetPercentile(99.0)) << " ms"
+            << ", p99.9: " << ms(histogram.GetPercentile(99.9)) << " ms"
+            << ", max: " << ms(histogram.GetMax()) << " ms)";
+    os.flags(flags);
+    os.precision(precision);
+    return os;
+}
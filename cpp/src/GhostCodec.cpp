@@ -0,0 +1,217 @@
+#include <GhostCodec.h>
+
+#include <cmath>
+#include <limits>
+
+namespace {
+    enum DeltaMask : std::uint8_t {
+        DELTA_POSITION_X = 1u << 0,
+        DELTA_POSITION_Y = 1u << 1,
+        DELTA_VELOCITY_X = 1u << 2,
+        DELTA_VELOCITY_Y = 1u << 3,
+        DELTA_FLAGS = 1u << 4,
+        DELTA_MODE = 1u << 5,
+        DELTA_FULL = 1u << 7, // Encoded against zero instead of a baseline
+    };
+
+    template<typename T>
+    T Saturate(float value) {
+        constexpr auto low = static_cast<float>(std::numeric_limits<T>::min());
+        constexpr auto high = static_cast<float>(std::numeric_limits<T>::max());
+        const float rounded = std::nearbyint(value);
+        if (!(rounded > low)) {
+            return std::numeric_limits<T>::min();
+        }
+        return rounded < high ? static_cast<T>(rounded) : std::numeric_limits<T>::max();
+    }
+
+    void PutVarint(std::uint8_t *&out, std::int32_t delta) {
+        std::uint32_t zigzag = (static_cast<std::uint32_t>(delta) << 1) ^ static_cast<std::uint32_t>(delta >> 31);
+        while (zigzag >= 0x80u) {
+            *out++ = static_cast<std::uint8_t>(zigzag | 0x80u);
+            zigzag >>= 7;
+        }
+        *out++ = static_cast<std::uint8_t>(zigzag);
+    }
+
+    bool GetVarint(const std::uint8_t *&in, const std::uint8_t *end, std::int32_t &delta) {
+        std::uint32_t zigzag = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            if (in == end) {
+                return false;
+            }
+            const std::uint8_t byte = *in++;
+            zigzag |= static_cast<std::uint32_t>(byte & 0x7Fu) << shift;
+            if ((byte & 0x80u) == 0) {
+                delta = static_cast<std::int32_t>((zigzag >> 1) ^ (~(zigzag & 1u) + 1u));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::int32_t Difference(std::int32_t value, std::int32_t base) {
+        return static_cast<std::int32_t>(static_cast<std::uint32_t>(value) - static_cast<std::uint32_t>(base));
+    }
+
+    std::int32_t Sum(std::int32_t base, std::int32_t delta) {
+        return static_cast<std::int32_t>(static_cast<std::uint32_t>(base) + static_cast<std::uint32_t>(delta));
+    }
+}
+
+GhostState GhostState::Quantize(float x, float y, float vx, float vy, bool canJump, std::uint8_t mode) {
+    GhostState state;
+    state.positionX = Saturate<std::int32_t>(x * PositionScale);
+    state.positionY = Saturate<std::int32_t>(y * PositionScale);
+    state.velocityX = Saturate<std::int16_t>(vx * VelocityScale);
+    state.velocityY = Saturate<std::int16_t>(vy * VelocityScale);
+    state.flags = canJump ? GHOST_CAN_JUMP : 0;
+    state.mode = mode;
+    return state;
+}
+
+std::size_t GhostCodec::Encode(const GhostState *base, const GhostState &state, std::uint8_t *out) {
+    const GhostState zero;
+    const GhostState &reference = base != nullptr ? *base : zero;
+    std::uint8_t *const start = out;
+    std::uint8_t &mask = *out++;
+    mask = base != nullptr ? 0 : DELTA_FULL;
+
+    if (state.positionX != reference.positionX) {
+        mask |= DELTA_POSITION_X;
+        PutVarint(out, Difference(state.positionX, reference.positionX));
+    }
+    if (state.positionY != reference.positionY) {
+        mask |= DELTA_POSITION_Y;
+        PutVarint(out, Difference(state.positionY, reference.positionY));
+    }
+    if (state.velocityX != reference.velocityX) {
+        mask |= DELTA_VELOCITY_X;
+        PutVarint(out, state.velocityX - reference.velocityX);
+    }
+    if (state.velocityY != reference.velocityY) {
+        mask |= DELTA_VELOCITY_Y;
+        PutVarint(out, state.velocityY - reference.velocityY);
+    }
+    if (state.flags != reference.flags) {
+        mask |= DELTA_FLAGS;
+        *out++ = state.flags;
+    }
+    if (state.mode != reference.mode) {
+        mask |= DELTA_MODE;
+        *out++ = state.mode;
+    }
+    return static_cast<std::size_t>(out - start);
+}
+
+bool GhostCodec::Decode(const GhostState *base, const std::uint8_t *&in, const std::uint8_t *end, GhostState &state) {
+    if (in == end) {
+        return false;
+    }
+    const std::uint8_t mask = *in++;
+    const bool full = (mask & DELTA_FULL) != 0;
+    const GhostState zero;
+    const GhostState &reference = full || base == nullptr ? zero : *base;
+
+    state = reference;
+    std::int32_t delta = 0;
+    if ((mask & DELTA_POSITION_X) != 0) {
+        if (!GetVarint(in, end, delta)) {
+            return false;
+        }
+        state.positionX = Sum(reference.positionX, delta);
+    }
+    if ((mask & DELTA_POSITION_Y) != 0) {
+        if (!GetVarint(in, end, delta)) {
+            return false;
+        }
+        state.positionY = Sum(reference.positionY, delta);
+    }
+    if ((mask & DELTA_VELOCITY_X) != 0) {
+        if (!GetVarint(in, end, delta)) {
+            return false;
+        }
+        state.velocityX = static_cast<std::int16_t>(reference.velocityX + delta);
+    }
+    if ((mask & DELTA_VELOCITY_Y) != 0) {
+        if (!GetVarint(in, end, delta)) {
+            return false;
+        }
+        state.velocityY = static_cast<std::int16_t>(reference.velocityY + delta);
+    }
+    if ((mask & DELTA_FLAGS) != 0) {
+        if (in == end) {
+            return false;
+        }
+        state.flags = *in++;
+    }
+    if ((mask & DELTA_MODE) != 0) {
+        if (in == end) {
+            return false;
+        }
+        state.mode = *in++;
+    }
+    return full || base != nullptr;
+}
+
+void GhostHistory::Put(std::uint32_t tick, const GhostState &state) {
+    if (hasLatest && static_cast<std::int32_t>(latestTick - tick) >= static_cast<std::int32_t>(Capacity)) {
+        return;
+    }
+    Entry &entry = entries[tick % Capacity];
+    entry.tick = tick;
+    entry.valid = true;
+    entry.state = state;
+    if (!hasLatest || static_cast<std::int32_t>(tick - latestTick) > 0) {
+        latestTick = tick;
+        hasLatest = true;
+    }
+}
+
+const GhostState *GhostHistory::Find(std::uint32_t tick) const {
+    const Entry &entry = entries[tick % Capacity];
+    return entry.valid && entry.tick == tick ? &entry.state : nullptr;
+}
+
+bool GhostHistory::GetLatestTick(std::uint32_t &tick) const {
+    tick = latestTick;
+    return hasLatest;
+}
+
+bool GhostHistory::Interpolate(double tick, float &x, float &y) const {
+    if (!hasLatest) {
+        return false;
+    }
+    const GhostState *latest = Find(latestTick);
+    if (latest == nullptr) {
+        return false;
+    }
+    if (tick >= static_cast<double>(latestTick)) {
+        x = latest->GetPositionX();
+        y = latest->GetPositionY();
+        return true;
+    }
+
+    // Walk back from the latest tick to the newest stored tick at or before the sample point
+    const GhostState *after = latest;
+    std::uint32_t afterTick = latestTick;
+    for (std::uint32_t back = 1; back < Capacity; ++back) {
+        const std::uint32_t candidate = latestTick - back;
+        const GhostState *state = Find(candidate);
+        if (state == nullptr) {
+            continue;
+        }
+        if (static_cast<double>(candidate) <= tick) {
+            const double span = static_cast<double>(afterTick - candidate);
+            const auto t = static_cast<float>((tick - static_cast<double>(candidate)) / span);
+            x = state->GetPositionX() + (after->GetPositionX() - state->GetPositionX()) * t;
+            y = state->GetPositionY() + (after->GetPositionY() - state->GetPositionY()) * t;
+            return true;
+        }
+        after = state;
+        afterTick = candidate;
+    }
+    x = after->GetPositionX();
+    y = after->GetPositionY();
+    return true;
+}
@@ -0,0 +1,470 @@
+#include <GhostNet.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr std::size_t UploadHeaderBytes = 8;
+    constexpr std::size_t BatchHeaderBytes = 10;
+    constexpr std::uint32_t MaxBatchParts = 64;
+
+#ifdef _WIN32
+    using SocketHandle = SOCKET;
+
+    /**
+     * @brief Starts Winsock once for the whole process.
+     */
+    bool StartSockets() {
+        static const bool started = [] {
+            WSADATA data;
+            return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+        }();
+        return started;
+    }
+#else
+    using SocketHandle = int;
+
+    bool StartSockets() {
+        return true;
+    }
+#endif
+
+    void Put16(std::uint8_t *&out, std::uint16_t value) {
+        *out++ = static_cast<std::uint8_t>(value);
+        *out++ = static_cast<std::uint8_t>(value >> 8);
+    }
+
+    void Put32(std::uint8_t *&out, std::uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            *out++ = static_cast<std::uint8_t>(value >> shift);
+        }
+    }
+
+    std::uint16_t Get16(const std::uint8_t *&in) {
+        const auto value = static_cast<std::uint16_t>(in[0] | (in[1] << 8));
+        in += 2;
+        return value;
+    }
+
+    std::uint32_t Get32(const std::uint8_t *&in) {
+        std::uint32_t value = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            value |= static_cast<std::uint32_t>(*in++) << shift;
+        }
+        return value;
+    }
+
+    /**
+     * @brief Checks whether tick `a` comes after tick `b`, allowing for wrap-around.
+     */
+    bool IsNewer(std::uint32_t a, std::uint32_t b) {
+        return static_cast<std::int32_t>(a - b) > 0;
+    }
+}
+
+bool UdpAddress::Parse(const std::string &text, std::uint16_t port, UdpAddress &address) {
+    in_addr parsed{};
+    if (inet_pton(AF_INET, text.c_str(), &parsed) != 1) {
+        return false;
+    }
+    address = UdpAddress{ntohl(parsed.s_addr), port};
+    return true;
+}
+
+UdpSocket::~UdpSocket() {
+    Close();
+}
+
+bool UdpSocket::Open(std::uint16_t port) {
+    Close();
+    if (!StartSockets()) {
+        return false;
+    }
+    const SocketHandle created = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#ifdef _WIN32
+    if (created == INVALID_SOCKET) {
+        return false;
+    }
+    u_long nonBlocking = 1;
+    ioctlsocket(created, FIONBIO, &nonBlocking);
+#else
+    if (created < 0) {
+        return false;
+    }
+    ::fcntl(created, F_SETFL, ::fcntl(created, F_GETFL, 0) | O_NONBLOCK);
+#endif
+    handle = static_cast<std::intptr_t>(created);
+
+    // A relay receives one upload per ghost per tick; the default buffer holds only a few hundred datagrams
+    const int bufferBytes = BufferBytes;
+    ::setsockopt(created, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char *>(&bufferBytes), sizeof(bufferBytes));
+    ::setsockopt(created, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char *>(&bufferBytes), sizeof(bufferBytes));
+
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons(port);
+    if (::bind(created, reinterpret_cast<const sockaddr *>(&local), sizeof(local)) != 0) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void UdpSocket::Close() {
+    if (handle == InvalidHandle) {
+        return;
+    }
+#ifdef _WIN32
+    ::closesocket(static_cast<SocketHandle>(handle));
+#else
+    ::close(static_cast<SocketHandle>(handle));
+#endif
+    handle = InvalidHandle;
+}
+
+std::uint16_t UdpSocket::GetPort() const {
+    sockaddr_in local{};
+    socklen_t length = sizeof(local);
+    if (handle == InvalidHandle ||
+        ::getsockname(static_cast<SocketHandle>(handle), reinterpret_cast<sockaddr *>(&local), &length) != 0) {
+        return 0;
+    }
+    return ntohs(local.sin_port);
+}
+
+bool UdpSocket::SendTo(const UdpAddress &address, const std::uint8_t *data, std::size_t size) {
+    if (handle == InvalidHandle) {
+        return false;
+    }
+    if (lossPercent > 0) {
+        lossSeed ^= lossSeed << 13;
+        lossSeed ^= lossSeed >> 17;
+        lossSeed ^= lossSeed << 5;
+        if (lossSeed % 100u < lossPercent) {
+            return true; // Lost on purpose
+        }
+    }
+    sockaddr_in remote{};
+    remote.sin_family = AF_INET;
+    remote.sin_addr.s_addr = htonl(address.ip);
+    remote.sin_port = htons(address.port);
+    return ::sendto(static_cast<SocketHandle>(handle), reinterpret_cast<const char *>(data),
+                    static_cast<int>(size), 0, reinterpret_cast<const sockaddr *>(&remote), sizeof(remote)) ==
+           static_cast<long>(size);
+}
+
+long UdpSocket::Receive(std::uint8_t *data, std::size_t capacity, UdpAddress &from) {
+    if (handle == InvalidHandle) {
+        return -1;
+    }
+    sockaddr_in remote{};
+    socklen_t length = sizeof(remote);
+    const auto received = ::recvfrom(static_cast<SocketHandle>(handle), reinterpret_cast<char *>(data),
+                                     static_cast<int>(capacity), 0, reinterpret_cast<sockaddr *>(&remote), &length);
+    if (received < 0) {
+        return -1;
+    }
+    from = UdpAddress{ntohl(remote.sin_addr.s_addr), ntohs(remote.sin_port)};
+    return static_cast<long>(received);
+}
+
+GhostSender::GhostSender(const UdpAddress &relay, std::uint16_t ghostId, std::uint32_t sendInterval)
+    : relay(relay), ghostId(ghostId), sendInterval(sendInterval == 0 ? 1 : sendInterval) {
+    socket.Open(0);
+}
+
+void GhostSender::Update(std::uint32_t tick, const GhostState &state) {
+    std::uint8_t buffer[UploadHeaderBytes + GhostCodec::MaxEncodedBytes];
+    UdpAddress from;
+    long received;
+    while ((received = socket.Receive(buffer, sizeof(buffer), from)) >= 7) {
+        const std::uint8_t *in = buffer + 1;
+        if (buffer[0] != static_cast<std::uint8_t>(GhostMessage::UploadAck) || Get16(in) != ghostId) {
+            continue;
+        }
+        const std::uint32_t acked = Get32(in);
+        if (ackedTick == GhostNoBase || IsNewer(acked, ackedTick)) {
+            ackedTick = acked;
+        }
+    }
+
+    if (tick % sendInterval != 0) {
+        return;
+    }
+    // Only a baseline still in the history can be named; otherwise send the full state
+    const bool recent = ackedTick != GhostNoBase && tick - ackedTick - 1 < GhostHistory::Capacity - 1;
+    const GhostState *base = recent ? sent.Find(ackedTick) : nullptr;
+    std::uint8_t *out = buffer;
+    *out++ = static_cast<std::uint8_t>(GhostMessage::Upload);
+    Put16(out, ghostId);
+    Put32(out, tick);
+    *out++ = static_cast<std::uint8_t>(base != nullptr ? tick - ackedTick : 0);
+    out += GhostCodec::Encode(base, state, out);
+    sent.Put(tick, state);
+
+    const auto size = static_cast<std::size_t>(out - buffer);
+    if (socket.SendTo(relay, buffer, size)) {
+        bytesSent += size;
+        ++packetsSent;
+    }
+}
+
+GhostRelay::GhostRelay(std::uint16_t port) {
+    socket.Open(port);
+}
+
+void GhostRelay::Poll() {
+    std::uint8_t buffer[UdpSocket::MaxDatagram];
+    UdpAddress from;
+    long received;
+    while ((received = socket.Receive(buffer, sizeof(buffer), from)) > 0) {
+        const std::uint8_t *in = buffer + 1;
+        const std::uint8_t *end = buffer + received;
+        switch (static_cast<GhostMessage>(buffer[0])) {
+            case GhostMessage::Join:
+                FindReceiver(from).lastHeard = tick;
+                break;
+            case GhostMessage::BatchAck:
+                if (received >= 5) {
+                    Receiver &receiver = FindReceiver(from);
+                    const std::uint32_t acked = Get32(in);
+                    if (receiver.ackedTick == GhostNoBase || IsNewer(acked, receiver.ackedTick)) {
+                        receiver.ackedTick = acked;
+                    }
+                    receiver.lastHeard = tick;
+                }
+                break;
+            case GhostMessage::Upload:
+                HandleUpload(from, buffer, end);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void GhostRelay::HandleUpload(const UdpAddress &from, const std::uint8_t *data, const std::uint8_t *end) {
+    if (end - data < static_cast<std::ptrdiff_t>(UploadHeaderBytes)) {
+        return;
+    }
+    const std::uint8_t *in = data + 1;
+    const std::uint16_t id = Get16(in);
+    const std::uint32_t uploadTick = Get32(in);
+    const std::uint8_t baseAge = *in++;
+
+    // Only a ghost whose upload decodes is added, so corrupt datagrams never broadcast a ghost at the origin
+    const auto known = ghosts.find(id);
+    const GhostState *base = baseAge != 0 && known != ghosts.end() ? known->second.uploads.Find(uploadTick - baseAge)
+                                                                   : nullptr;
+    GhostState state;
+    if ((baseAge != 0 && base == nullptr) || !GhostCodec::Decode(base, in, end, state)) {
+        return; // The baseline is gone; the sender falls back to full states once acks stop
+    }
+
+    Ghost &ghost = known != ghosts.end() ? known->second : ghosts[id];
+    std::uint32_t latestUpload = 0;
+    if (!ghost.uploads.GetLatestTick(latestUpload) || IsNewer(uploadTick, latestUpload)) {
+        ghost.latest = state;
+    }
+    ghost.uploads.Put(uploadTick, state);
+    ghost.lastHeard = tick;
+
+    std::uint8_t ack[7];
+    std::uint8_t *out = ack;
+    *out++ = static_cast<std::uint8_t>(GhostMessage::UploadAck);
+    Put16(out, id);
+    Put32(out, uploadTick);
+    socket.SendTo(from, ack, sizeof(ack));
+}
+
+GhostRelay::Receiver &GhostRelay::FindReceiver(const UdpAddress &address) {
+    for (Receiver &receiver: receivers) {
+        if (receiver.address == address) {
+            return receiver;
+        }
+    }
+    receivers.push_back(Receiver{address, GhostNoBase, tick});
+    return receivers.back();
+}
+
+void GhostRelay::Broadcast() {
+    ++tick;
+    std::erase_if(ghosts, [this](const auto &entry) { return tick - entry.second.lastHeard > TimeoutTicks; });
+    std::erase_if(receivers, [this](const Receiver &receiver) { return tick - receiver.lastHeard > TimeoutTicks; });
+
+    std::vector<std::uint16_t> ids;
+    ids.reserve(ghosts.size());
+    for (auto &[id, ghost]: ghosts) {
+        ghost.broadcast.Put(tick, ghost.latest);
+        ids.push_back(id);
+    }
+    std::sort(ids.begin(), ids.end());
+
+    for (const Receiver &receiver: receivers) {
+        SendBatch(receiver, ids);
+    }
+}
+
+void GhostRelay::SendBatch(const Receiver &receiver, const std::vector<std::uint16_t> &ids) {
+    // A baseline older than the history can no longer be encoded against
+    const bool hasBase = receiver.ackedTick != GhostNoBase && tick - receiver.ackedTick - 1 < GhostHistory::Capacity - 1;
+    const std::uint32_t baseTick = hasBase ? receiver.ackedTick : GhostNoBase;
+
+    // Encode every ghost first, then cut the entries into datagrams
+    scratch.resize(ids.size() * (2 + GhostCodec::MaxEncodedBytes));
+    scratchEnds.clear();
+    std::uint8_t *out = scratch.data();
+    for (const std::uint16_t id: ids) {
+        const Ghost &ghost = ghosts.at(id);
+        Put16(out, id);
+        out += GhostCodec::Encode(hasBase ? ghost.broadcast.Find(baseTick) : nullptr, *ghost.broadcast.Find(tick),
+                                  out);
+        scratchEnds.push_back(static_cast<std::size_t>(out - scratch.data()));
+    }
+
+    constexpr std::size_t Room = UdpSocket::MaxDatagram - BatchHeaderBytes;
+    scratchCuts.assign(1, 0);
+    std::size_t partStart = 0;
+    for (std::size_t index = 0; index < scratchEnds.size(); ++index) {
+        if (scratchEnds[index] - partStart > Room && index != scratchCuts.back()) {
+            scratchCuts.push_back(index);
+            partStart = scratchEnds[index - 1];
+        }
+    }
+    scratchCuts.push_back(ids.size());
+    const auto parts = static_cast<std::uint32_t>(std::min<std::size_t>(scratchCuts.size() - 1, MaxBatchParts));
+
+    std::uint8_t datagram[UdpSocket::MaxDatagram];
+    for (std::uint32_t part = 0; part < parts; ++part) {
+        const std::size_t first = scratchCuts[part];
+        const std::size_t last = scratchCuts[part + 1];
+        const std::size_t begin = first == 0 ? 0 : scratchEnds[first - 1];
+        const std::size_t finish = last == 0 ? 0 : scratchEnds[last - 1];
+
+        std::uint8_t *header = datagram;
+        *header++ = static_cast<std::uint8_t>(GhostMessage::Batch);
+        Put32(header, tick);
+        *header++ = static_cast<std::uint8_t>(hasBase ? tick - baseTick : 0);
+        *header++ = static_cast<std::uint8_t>(part);
+        *header++ = static_cast<std::uint8_t>(parts);
+        Put16(header, static_cast<std::uint16_t>(last - first));
+        std::memcpy(header, scratch.data() + begin, finish - begin);
+
+        const std::size_t size = BatchHeaderBytes + finish - begin;
+        if (socket.SendTo(receiver.address, datagram, size)) {
+            bytesSent += size;
+        }
+    }
+    ghostTicksSent += ids.size();
+}
+
+GhostReceiver::GhostReceiver(const UdpAddress &relay) : relay(relay) {
+    if (socket.Open(0)) {
+        const auto join = static_cast<std::uint8_t>(GhostMessage::Join);
+        socket.SendTo(relay, &join, 1);
+    }
+}
+
+void GhostReceiver::Poll() {
+    std::uint8_t buffer[UdpSocket::MaxDatagram];
+    UdpAddress from;
+    long received;
+    bool gotData = false;
+    while ((received = socket.Receive(buffer, sizeof(buffer), from)) > 0) {
+        bytesReceived += static_cast<std::uint64_t>(received);
+        if (buffer[0] == static_cast<std::uint8_t>(GhostMessage::Batch) && from == relay) {
+            HandleBatch(buffer, buffer + received);
+            gotData = true;
+        }
+    }
+
+    // Keep asking until the relay answers, and again if it forgot us
+    pollsSinceData = gotData ? 0 : pollsSinceData + 1;
+    if (pollsSinceData >= 30) {
+        const auto join = static_cast<std::uint8_t>(GhostMessage::Join);
+        socket.SendTo(relay, &join, 1);
+        pollsSinceData = 0;
+    }
+}
+
+void GhostReceiver::HandleBatch(const std::uint8_t *data, const std::uint8_t *end) {
+    if (end - data < static_cast<std::ptrdiff_t>(BatchHeaderBytes)) {
+        return;
+    }
+    const std::uint8_t *in = data + 1;
+    const std::uint32_t tick = Get32(in);
+    const std::uint8_t baseAge = *in++;
+    const std::uint32_t baseTick = baseAge != 0 ? tick - baseAge : GhostNoBase;
+    const std::uint8_t part = *in++;
+    const std::uint8_t partCount = *in++;
+    const std::uint16_t count = Get16(in);
+    if (part >= partCount || partCount > MaxBatchParts) {
+        return;
+    }
+
+    PartSet &set = parts[tick % parts.size()];
+    if (set.tick != tick) {
+        set = PartSet{tick, 0, false};
+    }
+
+    for (std::uint16_t index = 0; index < count && end - in >= 2; ++index) {
+        const std::uint16_t id = Get16(in);
+        const auto found = ghosts.find(id);
+        const GhostState *base = baseTick != GhostNoBase && found != ghosts.end()
+                                     ? found->second.Find(baseTick)
+                                     : nullptr;
+        GhostState state;
+        if (GhostCodec::Decode(base, in, end, state)) {
+            ghosts[id].Put(tick, state);
+        } else {
+            set.failed = true;
+        }
+    }
+
+    if (!hasTick || IsNewer(tick, latestTick)) {
+        latestTick = tick;
+        hasTick = true;
+    }
+
+    // Acknowledge only ticks every ghost could be decoded at, so the relay never deltas against a hole
+    set.received |= std::uint64_t{1} << part;
+    if (!set.failed && std::popcount(set.received) == partCount) {
+        std::uint8_t ack[5];
+        std::uint8_t *out = ack;
+        *out++ = static_cast<std::uint8_t>(GhostMessage::BatchAck);
+        Put32(out, tick);
+        socket.SendTo(relay, ack, sizeof(ack));
+    }
+}
+
+double GhostReceiver::GetRenderTick() const {
+    return hasTick ? static_cast<double>(latestTick) - InterpolationDelay : 0.0;
+}
+
+bool GhostReceiver::Sample(std::uint16_t ghostId, double tick, float &x, float &y) const {
+    const auto found = ghosts.find(ghostId);
+    return found != ghosts.end() && found->second.Interpolate(tick, x, y);
+}
+
+std::vector<std::uint16_t> GhostReceiver::GetGhostIds() const {
+    std::vector<std::uint16_t> ids;
+    ids.reserve(ghosts.size());
+    for (const auto &[id, history]: ghosts) {
+        ids.push_back(id);
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
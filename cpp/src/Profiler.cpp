@@ -0,0 +1,129 @@
+#include <Profiler.h>
+#include <AllocationTracker.h>
+
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    /**
+     * @brief The ring buffer a single thread records into.
+     *
+     * Only the owning thread writes `events` and `head`; readers load `head` with acquire ordering and
+     * re-check it after copying to detect entries overwritten mid-read.
+     */
+    struct ProfileRing {
+        std::array<ProfileEvent, Profiler::RingCapacity> events{};
+        std::atomic<std::uint64_t> head{0};
+        std::atomic<std::uint64_t> clearedAt{0};
+        std::uint32_t threadId = 0;
+    };
+
+    /**
+     * @brief Every ring ever registered; rings outlive their threads so late exports still see them.
+     */
+    struct ProfileRegistry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ProfileRing> > rings;
+    };
+
+    ProfileRegistry &GetRegistry() {
+        static ProfileRegistry registry;
+        return registry;
+    }
+
+    ProfileRing &GetThreadRing() {
+        thread_local ProfileRing *ring = [] {
+            // Registering a ring is one-time setup, even when the first zone sits in a no-allocation scope
+            const AllowAllocationScope allow;
+            ProfileRegistry &registry = GetRegistry();
+            const std::lock_guard lock(registry.mutex);
+            registry.rings.push_back(std::make_unique<ProfileRing>());
+            registry.rings.back()->threadId = static_cast<std::uint32_t>(registry.rings.size());
+            return registry.rings.back().get();
+        }();
+        return *ring;
+    }
+
+    const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    void WriteEscaped(std::ostream &os, const char *text) {
+        for (; *text != '\0'; ++text) {
+            if (*text == '"' || *text == '\\') {
+                os << '\\';
+            }
+            os << *text;
+        }
+    }
+}
+
+std::uint64_t Profiler::Now() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+void Profiler::Record(const char *name, std::uint64_t start, std::uint64_t end) {
+    ProfileRing &ring = GetThreadRing();
+    const std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+    ring.events[head & (RingCapacity - 1)] = ProfileEvent{name, start, end - start};
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::WriteChromeTrace(std::ostream &os) {
+    ProfileRegistry &registry = GetRegistry();
+    const std::lock_guard lock(registry.mutex);
+
+    const std::ios::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    std::vector<ProfileEvent> copy;
+    for (const auto &ring: registry.rings) {
+        const std::uint64_t end = ring->head.load(std::memory_order_acquire);
+        const std::uint64_t oldest = end > RingCapacity ? end - RingCapacity : 0;
+        const std::uint64_t cleared = ring->clearedAt.load(std::memory_order_relaxed);
+        const std::uint64_t begin = oldest > cleared ? oldest : cleared;
+        copy.assign(ring->events.begin(), ring->events.end());
+
+        // Anything the writer lapped while we were copying is no longer trustworthy, and neither is the slot of
+        // index `after`, which it may have been writing into
+        const std::uint64_t after = ring->head.load(std::memory_order_acquire);
+        const std::uint64_t firstValid = after >= RingCapacity ? after - RingCapacity + 1 : 0;
+
+        for (std::uint64_t index = begin > firstValid ? begin : firstValid; index < end; ++index) {
+            const ProfileEvent &event = copy[index & (RingCapacity - 1)];
+            os << (first ? "" : ",") << "{\"name\":\"";
+            WriteEscaped(os, event.name);
+            os << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->threadId
+                    << ",\"ts\":" << static_cast<double>(event.start) / 1000.0
+                    << ",\"dur\":" << static_cast<double>(event.duration) / 1000.0 << "}";
+            first = false;
+        }
+    }
+    os << "]}";
+    os.flags(flags);
+    os.precision(precision);
+}
+
+bool Profiler::WriteChromeTrace(const std::string &path) {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    WriteChromeTrace(file);
+    return static_cast<bool>(file);
+}
+
+void Profiler::Clear() {
+    ProfileRegistry &registry = GetRegistry();
+    const std::lock_guard lock(registry.mutex);
+    for (const auto &ring: registry.rings) {
+        // The owning thread keeps writing undisturbed; exports just start after this point
+        ring->clearedAt.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,155 @@
+#include <Replay.h>
+
+#include "../Core/PlayerSim.h"
+
+#include <Counters.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+namespace {
+    constexpr char Magic[8] = {'O', 'O', 'P', 'R', 'P', 'L', 'Y', '1'};
+    constexpr std::size_t HeaderBytes = 48;
+
+    template<typename T>
+    void Put(unsigned char *&out, T value) {
+        std::uint64_t bits = 0;
+        if constexpr (sizeof(T) == 4 && std::is_floating_point_v<T>) {
+            bits = std::bit_cast<std::uint32_t>(value);
+        } else {
+            bits = static_cast<std::uint64_t>(value);
+        }
+        for (std::size_t index = 0; index < sizeof(T); ++index) {
+            *out++ = static_cast<unsigned char>(bits >> (index * 8));
+        }
+    }
+
+    template<typename T>
+    T Get(const unsigned char *&in) {
+        std::uint64_t bits = 0;
+        for (std::size_t index = 0; index < sizeof(T); ++index) {
+            bits |= static_cast<std::uint64_t>(*in++) << (index * 8);
+        }
+        if constexpr (sizeof(T) == 4 && std::is_floating_point_v<T>) {
+            return std::bit_cast<T>(static_cast<std::uint32_t>(bits));
+        } else {
+            return static_cast<T>(bits);
+        }
+    }
+}
+
+std::ostream &operator<<(std::ostream &os, const ReplayResult &result) {
+    const auto flags = os.flags();
+    os << "ReplayResult(Ticks: " << result.ticks << ", Position: (" << result.positionX << ", " << result.positionY
+            << "), StateHash: " << std::hex << result.stateHash << ")";
+    os.flags(flags);
+    return os;
+}
+
+bool Replay::Load(const std::string &path, std::uint64_t maxTicks) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    const std::streamoff size = file.tellg();
+    unsigned char header[HeaderBytes];
+    if (size < static_cast<std::streamoff>(HeaderBytes) || !file.seekg(0) ||
+        !file.read(reinterpret_cast<char *>(header), HeaderBytes) || std::memcmp(header, Magic, 8) != 0) {
+        return false;
+    }
+
+    const unsigned char *in = header + 8;
+    levelId = Get<std::uint32_t>(in);
+    mode = Get<std::uint8_t>(in);
+    in += 3;
+    const auto tickCount = Get<std::uint64_t>(in);
+    claimed.ticks = Get<std::uint64_t>(in);
+    claimed.positionX = Get<float>(in);
+    claimed.positionY = Get<float>(in);
+    claimed.stateHash = Get<std::uint64_t>(in);
+    const auto inputBytes = static_cast<std::uint64_t>(size) - HeaderBytes;
+    if (tickCount > std::min(maxTicks, MaxTicks) || tickCount > inputBytes / 2) {
+        return false;
+    }
+
+    std::vector<unsigned char> bytes(static_cast<std::size_t>(tickCount) * 2);
+    if (!file.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+        return false;
+    }
+    inputs.resize(static_cast<std::size_t>(tickCount));
+    for (std::size_t tick = 0; tick < inputs.size(); ++tick) {
+        inputs[tick] = InputSnapshot{bytes[tick * 2], bytes[tick * 2 + 1]};
+    }
+    return true;
+}
+
+bool Replay::Save(const std::string &path) const {
+    std::vector<unsigned char> bytes(HeaderBytes + inputs.size() * 2);
+    std::memcpy(bytes.data(), Magic, 8);
+    unsigned char *out = bytes.data() + 8;
+    Put<std::uint32_t>(out, levelId);
+    Put<std::uint8_t>(out, mode);
+    out += 3;
+    Put<std::uint64_t>(out, inputs.size());
+    Put<std::uint64_t>(out, claimed.ticks);
+    Put<float>(out, claimed.positionX);
+    Put<float>(out, claimed.positionY);
+    Put<std::uint64_t>(out, claimed.stateHash);
+    for (const InputSnapshot &input: inputs) {
+        *out++ = input.held;
+        *out++ = input.pressed;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+ReplayResult Replay::Run() const {
+    return Run(World::MakeTower(levelId));
+}
+
+ReplayResult Replay::Run(const World &world) const {
+    PlayerSim sim(world, mode);
+    for (const InputSnapshot &input: inputs) {
+        sim.Step(input);
+    }
+    Counters::Flush();
+    return ReplayResult{sim.GetTickCount(), sim.GetPositionX(), sim.GetPositionY(), sim.GetStateHash()};
+}
+
+Replay Replay::Generate(std::uint32_t seed, std::uint32_t ticks) {
+    std::uint32_t state = seed * 0x2545F491u + 0x9E3779B9u;
+    const auto next = [&state] {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    };
+
+    Replay replay;
+    replay.levelId = seed % 64u;
+    replay.mode = static_cast<std::uint8_t>((seed / 8u) % 3u);
+    replay.inputs.resize(ticks);
+
+    std::uint32_t segmentLeft = 0;
+    int direction = 0;
+    bool jumpHeld = false;
+    for (InputSnapshot &input: replay.inputs) {
+        if (segmentLeft == 0) {
+            // Hold a direction (or nothing) for a quarter to one and a half seconds
+            segmentLeft = 15 + next() % 75u;
+            direction = static_cast<int>(next() % 3u) - 1;
+        }
+        --segmentLeft;
+
+        const bool jumpDown = jumpHeld ? next() % 8u != 0 : next() % 60u == 0;
+        input.Set(InputAction::Left, direction < 0, false);
+        input.Set(InputAction::Right, direction > 0, false);
+        input.Set(InputAction::Jump, jumpDown, jumpDown && !jumpHeld);
+        jumpHeld = jumpDown;
+    }
+
+    replay.claimed = replay.Run();
+    return replay;
+}
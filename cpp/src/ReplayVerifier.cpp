@@ -0,0 +1,125 @@
+#include <ReplayVerifier.h>
+
+#include <Profiler.h>
+
+#include <algorithm>
+
+namespace {
+    /**
+     * @brief Levels kept per worker before the cache is dropped, so odd level ids cannot grow it without bound.
+     */
+    constexpr std::size_t MaxCachedLevels = 64;
+
+    /**
+     * @brief Chunks handed out per worker and batch; enough to even out uneven replay lengths.
+     */
+    constexpr std::size_t ChunksPerWorker = 8;
+}
+
+const char *GetVerdictName(ReplayVerdict verdict) {
+    switch (verdict) {
+        case ReplayVerdict::Accepted:
+            return "accepted";
+        case ReplayVerdict::Rejected:
+            return "rejected";
+        case ReplayVerdict::Malformed:
+            return "malformed";
+        default:
+            return "unknown";
+    }
+}
+
+ReplayVerifier::ReplayVerifier(unsigned threads, std::uint64_t maxTicks) : maxTicks(maxTicks) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(threads);
+    for (unsigned index = 0; index < threads; ++index) {
+        workers.emplace_back(&ReplayVerifier::RunWorker, this);
+    }
+}
+
+ReplayVerifier::~ReplayVerifier() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &worker: workers) {
+        worker.join();
+    }
+}
+
+std::vector<ReplayCheck> ReplayVerifier::VerifyBatch(const std::vector<std::string> &paths) {
+    std::vector<ReplayCheck> checks(paths.size());
+    if (paths.empty()) {
+        return checks;
+    }
+
+    std::unique_lock lock(mutex);
+    batchPaths = &paths;
+    batchChecks = &checks;
+    chunkSize = std::max<std::size_t>(1, paths.size() / (workers.size() * ChunksPerWorker));
+    cursor.store(0, std::memory_order_relaxed);
+    busyWorkers = static_cast<unsigned>(workers.size());
+    ++generation;
+    wake.notify_all();
+    done.wait(lock, [this] { return busyWorkers == 0; });
+    batchPaths = nullptr;
+    batchChecks = nullptr;
+    return checks;
+}
+
+void ReplayVerifier::RunWorker() {
+    std::unordered_map<std::uint32_t, World> levels;
+    std::uint64_t seen = 0;
+    std::unique_lock lock(mutex);
+    while (true) {
+        wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+        if (stopping) {
+            return;
+        }
+        seen = generation;
+        const std::vector<std::string> &paths = *batchPaths;
+        std::vector<ReplayCheck> &checks = *batchChecks;
+
+        lock.unlock();
+        VerifyChunks(paths, checks, levels);
+        lock.lock();
+
+        if (--busyWorkers == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void ReplayVerifier::VerifyChunks(const std::vector<std::string> &paths, std::vector<ReplayCheck> &checks,
+                                  std::unordered_map<std::uint32_t, World> &levels) {
+    PROFILE_ZONE("ReplayVerifier::VerifyChunks");
+    Replay replay;
+    std::uint64_t ticks = 0;
+    for (std::size_t first = cursor.fetch_add(chunkSize, std::memory_order_relaxed); first < paths.size();
+         first = cursor.fetch_add(chunkSize, std::memory_order_relaxed)) {
+        const std::size_t last = std::min(first + chunkSize, paths.size());
+        for (std::size_t index = first; index < last; ++index) {
+            ReplayCheck &check = checks[index];
+            if (!replay.Load(paths[index], maxTicks)) {
+                check.verdict = ReplayVerdict::Malformed;
+                continue;
+            }
+
+            auto level = levels.find(replay.levelId);
+            if (level == levels.end()) {
+                if (levels.size() >= MaxCachedLevels) {
+                    levels.clear();
+                }
+                level = levels.emplace(replay.levelId, World::MakeTower(replay.levelId)).first;
+            }
+            check.claimed = replay.claimed;
+            check.actual = replay.Run(level->second);
+            check.verdict = check.actual == check.claimed ? ReplayVerdict::Accepted : ReplayVerdict::Rejected;
+            ticks += check.actual.ticks;
+        }
+    }
+    ticksSimulated.fetch_add(ticks, std::memory_order_relaxed);
+}
@@ -0,0 +1,76 @@
+#include <Rollback.h>
+
+#include <Counters.h>
+#include <Profiler.h>
+
+#include <algorithm>
+
+RollbackSession::RollbackSession(const World &world, int mode, std::uint32_t localPlayer, std::uint32_t maxRollback)
+    : players{PlayerSim(world, mode), PlayerSim(world, mode)}, localPlayer(localPlayer & 1u),
+      remotePlayer(1u - (localPlayer & 1u)), maxRollback(std::clamp(maxRollback, 1u, MaxRollbackLimit)) {
+}
+
+std::uint32_t RollbackSession::Advance(InputSnapshot local) {
+    const std::uint32_t resimulated = Resimulate();
+
+    Frame &frame = frames[tick % HistoryTicks];
+    frame.inputs[localPlayer] = local;
+    if (tick >= remoteTicks) {
+        frame.inputs[remotePlayer] = PredictRemote();
+    }
+    Step(tick);
+    ++tick;
+    Counters::Flush(); // Once per tick, however many ticks were resimulated
+    return resimulated;
+}
+
+std::uint32_t RollbackSession::Resimulate() {
+    if (rollbackTick == NoRollback) {
+        return 0;
+    }
+    PROFILE_ZONE("Rollback::Resimulate");
+
+    const Frame &first = frames[rollbackTick % HistoryTicks];
+    for (std::uint32_t player = 0; player < Players; ++player) {
+        players[player].Restore(first.before[player]);
+    }
+    for (std::uint32_t resimTick = rollbackTick; resimTick < tick; ++resimTick) {
+        // Ticks still unconfirmed are predicted again from the newest remote input
+        if (resimTick >= remoteTicks) {
+            frames[resimTick % HistoryTicks].inputs[remotePlayer] = PredictRemote();
+        }
+        Step(resimTick);
+    }
+
+    const std::uint32_t resimulated = tick - rollbackTick;
+    rollbackTick = NoRollback;
+    ++rollbacks;
+    resimulatedTicks += resimulated;
+    Counters::Add(Counter::ResimulatedTicks, resimulated);
+    return resimulated;
+}
+
+bool RollbackSession::AddRemoteInput(std::uint32_t remoteTick, InputSnapshot input) {
+    // The peer stalls at the same window, so it can never be further ahead than the history holds
+    if (remoteTick != remoteTicks || remoteTick >= tick + HistoryTicks - maxRollback) {
+        return false;
+    }
+
+    InputSnapshot &slot = frames[remoteTick % HistoryTicks].inputs[remotePlayer];
+    if (remoteTick < tick && slot != input) {
+        ++mispredictions;
+        rollbackTick = std::min(rollbackTick, remoteTick);
+    }
+    slot = input;
+    lastRemote = input;
+    ++remoteTicks;
+    return true;
+}
+
+void RollbackSession::Step(std::uint32_t stepTick) {
+    Frame &frame = frames[stepTick % HistoryTicks];
+    for (std::uint32_t player = 0; player < Players; ++player) {
+        frame.before[player] = players[player].Save();
+        players[player].Step(frame.inputs[player]);
+    }
+}
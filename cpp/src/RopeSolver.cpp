@@ -0,0 +1,89 @@
+#include <RopeSolver.h>
+
+#include <Profiler.h>
+
+#include <algorithm>
+
+RopeSolver::RopeSolver(unsigned threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(threads - 1);
+    for (unsigned index = 1; index < threads; ++index) {
+        workers.emplace_back(&RopeSolver::RunWorker, this);
+    }
+}
+
+RopeSolver::~RopeSolver() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &worker: workers) {
+        worker.join();
+    }
+}
+
+void RopeSolver::Step(Ropes &ropes, float delta, float gravity, const World &world, int iterations) {
+    PROFILE_ZONE("RopeSolver::Step");
+    const Job next{&ropes, &world, delta, gravity, iterations};
+    // A worker with no batch to claim would only pay for the wakeup, so wake one per batch beyond the caller's
+    const std::size_t batches = ropes.GetBatchCount();
+    const auto helpers = static_cast<unsigned>(std::min<std::size_t>(workers.size(), batches > 0 ? batches - 1 : 0));
+    if (helpers == 0) {
+        ropes.Step(delta, gravity, world, iterations);
+        return;
+    }
+
+    {
+        std::lock_guard lock(mutex);
+        job = next;
+        cursor.store(0, std::memory_order_relaxed);
+        busyWorkers = helpers;
+        openSlots = helpers;
+        ++generation;
+    }
+    if (helpers == workers.size()) {
+        wake.notify_all();
+    } else {
+        for (unsigned index = 0; index < helpers; ++index) {
+            wake.notify_one();
+        }
+    }
+    StepClaimed(next);
+
+    std::unique_lock lock(mutex);
+    done.wait(lock, [this] { return busyWorkers == 0; });
+}
+
+void RopeSolver::RunWorker() {
+    std::uint64_t seen = 0;
+    std::unique_lock lock(mutex);
+    while (true) {
+        wake.wait(lock, [this, seen] { return stopping || (generation != seen && openSlots > 0); });
+        if (stopping) {
+            return;
+        }
+        seen = generation;
+        --openSlots;
+        const Job claimed = job;
+
+        lock.unlock();
+        StepClaimed(claimed);
+        lock.lock();
+
+        if (--busyWorkers == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void RopeSolver::StepClaimed(const Job &claimed) {
+    const std::size_t batches = claimed.ropes->GetBatchCount();
+    for (std::size_t batch = cursor.fetch_add(1, std::memory_order_relaxed); batch < batches;
+         batch = cursor.fetch_add(1, std::memory_order_relaxed)) {
+        claimed.ropes->StepBatches(batch, batch + 1, claimed.delta, claimed.gravity, *claimed.world,
+                                   claimed.iterations);
+    }
+}
@@ -0,0 +1,429 @@
+#include <SaveGame.h>
+
+#include <AllocationTracker.h>
+#include <Profiler.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr char Magic[8] = {'O', 'O', 'P', 'S', 'A', 'V', 'E', 'G'};
+
+    /**
+     * @brief The file header; written and read as-is, like the records.
+     */
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t flags;
+        std::uint64_t payloadBytes;
+        std::uint64_t storedBytes;
+        std::uint64_t checksum;
+    };
+
+    static_assert(sizeof(FileHeader) == 40);
+
+    /**
+     * @brief One entry of the section table at the start of a payload.
+     */
+    struct SectionEntry {
+        std::uint32_t id;
+        std::uint32_t count;
+        std::uint64_t offset;
+        std::uint64_t bytes;
+    };
+
+    static_assert(sizeof(SectionEntry) == 24);
+
+    constexpr std::size_t SectionCount = 3;
+    constexpr std::size_t TableBytes = 8 + SectionCount * sizeof(SectionEntry);
+
+    constexpr std::size_t Align(std::size_t bytes) {
+        return (bytes + 7u) & ~std::size_t{7};
+    }
+
+    // Compression: a sequence is a token (literal count << 4 | match length - MinMatch), the literals and a
+    // u16 offset back to the match. A nibble of 15 continues in extra bytes added up until one is below 255.
+    // The last sequence has literals only.
+    constexpr std::size_t MinMatch = 4;
+    constexpr std::size_t HashBits = 12;
+    constexpr std::size_t MaxOffset = 65535;
+
+    std::uint32_t Read32(const std::uint8_t *bytes) {
+        std::uint32_t value;
+        std::memcpy(&value, bytes, 4);
+        return value;
+    }
+
+    std::size_t Hash(std::uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - HashBits);
+    }
+
+    void PutLength(std::vector<std::uint8_t> &out, std::size_t length) {
+        for (; length >= 255; length -= 255) {
+            out.push_back(255);
+        }
+        out.push_back(static_cast<std::uint8_t>(length));
+    }
+
+    void PutSequence(std::vector<std::uint8_t> &out, const std::uint8_t *literals, std::size_t literalCount,
+                     std::size_t offset, std::size_t matchLength) {
+        const std::size_t extraMatch = matchLength >= MinMatch ? matchLength - MinMatch : 0;
+        out.push_back(static_cast<std::uint8_t>((std::min<std::size_t>(literalCount, 15) << 4) |
+                                                std::min<std::size_t>(extraMatch, 15)));
+        if (literalCount >= 15) {
+            PutLength(out, literalCount - 15);
+        }
+        out.insert(out.end(), literals, literals + literalCount);
+        if (matchLength == 0) {
+            return;
+        }
+        out.push_back(static_cast<std::uint8_t>(offset));
+        out.push_back(static_cast<std::uint8_t>(offset >> 8));
+        if (extraMatch >= 15) {
+            PutLength(out, extraMatch - 15);
+        }
+    }
+
+    bool GetLength(const std::uint8_t *&in, const std::uint8_t *end, std::size_t &length) {
+        std::uint8_t next;
+        do {
+            if (in == end) {
+                return false;
+            }
+            next = *in++;
+            length += next;
+        } while (next == 255);
+        return true;
+    }
+
+    /**
+     * @brief Flushes a written file to disk, so a rename over the old save cannot outrun the data.
+     */
+    bool SyncFile(std::FILE *file) {
+        if (std::fflush(file) != 0) {
+            return false;
+        }
+#ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+#else
+        return ::fsync(::fileno(file)) == 0;
+#endif
+    }
+
+    /**
+     * @brief Flushes a directory entry to disk, so the rename itself survives a crash.
+     */
+    void SyncDirectory(const std::filesystem::path &directory) {
+#ifndef _WIN32
+        const int descriptor = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+        if (descriptor >= 0) {
+            ::fsync(descriptor);
+            ::close(descriptor);
+        }
+#else
+        (void) directory;
+#endif
+    }
+}
+
+bool SaveView::Open(const std::uint8_t *payload, std::size_t bytes) {
+    player = nullptr;
+    progress = nullptr;
+    mutations = {};
+    if (payload == nullptr || bytes < 8 || reinterpret_cast<std::uintptr_t>(payload) % 8 != 0) {
+        return false;
+    }
+
+    std::uint32_t count;
+    std::memcpy(&count, payload, 4);
+    if (count > (bytes - 8) / sizeof(SectionEntry)) {
+        return false;
+    }
+    const auto *table = reinterpret_cast<const SectionEntry *>(payload + 8);
+    for (std::uint32_t index = 0; index < count; ++index) {
+        const SectionEntry &entry = table[index];
+        if (entry.offset % 8 != 0 || entry.offset > bytes || entry.bytes > bytes - entry.offset) {
+            return false;
+        }
+        const std::uint8_t *data = payload + entry.offset;
+        switch (static_cast<SaveSection>(entry.id)) {
+            case SaveSection::Player:
+                if (entry.count != 1 || entry.bytes != sizeof(SavePlayer)) {
+                    return false;
+                }
+                player = reinterpret_cast<const SavePlayer *>(data);
+                break;
+            case SaveSection::Progress:
+                if (entry.count != 1 || entry.bytes != sizeof(SaveProgress)) {
+                    return false;
+                }
+                progress = reinterpret_cast<const SaveProgress *>(data);
+                break;
+            case SaveSection::Mutations:
+                if (entry.bytes != std::uint64_t{entry.count} * sizeof(SaveMutation)) {
+                    return false;
+                }
+                mutations = {reinterpret_cast<const SaveMutation *>(data), entry.count};
+                break;
+            default:
+                break; // A section from a later version
+        }
+    }
+    return true;
+}
+
+std::size_t SaveGame::Serialize(const SaveState &state, std::vector<std::uint64_t> &payload) {
+    PROFILE_ZONE("SaveGame::Serialize");
+    const std::size_t mutationBytes = state.mutations.size() * sizeof(SaveMutation);
+    const std::size_t playerOffset = Align(TableBytes);
+    const std::size_t progressOffset = playerOffset + Align(sizeof(SavePlayer));
+    const std::size_t mutationsOffset = progressOffset + Align(sizeof(SaveProgress));
+    const std::size_t bytes = mutationsOffset + Align(mutationBytes);
+    if (payload.size() * 8 < bytes) {
+        // Only when the level changed more than ever before; the next snapshots reuse the space
+        const AllowAllocationScope allow;
+        payload.resize(bytes / 8 * 2);
+    }
+
+    auto *out = reinterpret_cast<std::uint8_t *>(payload.data());
+    const std::uint32_t header[2] = {static_cast<std::uint32_t>(SectionCount), 0};
+    const SectionEntry table[SectionCount] = {
+        {static_cast<std::uint32_t>(SaveSection::Player), 1, playerOffset, sizeof(SavePlayer)},
+        {static_cast<std::uint32_t>(SaveSection::Progress), 1, progressOffset, sizeof(SaveProgress)},
+        {
+            static_cast<std::uint32_t>(SaveSection::Mutations), static_cast<std::uint32_t>(state.mutations.size()),
+            mutationsOffset, mutationBytes
+        },
+    };
+    std::memcpy(out, header, sizeof(header));
+    std::memcpy(out + 8, table, sizeof(table));
+    std::memcpy(out + playerOffset, &state.player, sizeof(SavePlayer));
+    std::memcpy(out + progressOffset, &state.progress, sizeof(SaveProgress));
+    if (mutationBytes != 0) {
+        std::memcpy(out + mutationsOffset, state.mutations.data(), mutationBytes);
+    }
+    // Padding is part of the checksum, so it has to be deterministic
+    std::memset(out + mutationsOffset + mutationBytes, 0, bytes - mutationsOffset - mutationBytes);
+    return bytes;
+}
+
+std::uint64_t SaveGame::Checksum(const std::uint8_t *bytes, std::size_t size) {
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (std::size_t index = 0; index < size; ++index) {
+        hash = (hash ^ bytes[index]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+void SaveGame::Compress(const std::uint8_t *in, std::size_t size, std::vector<std::uint8_t> &out) {
+    PROFILE_ZONE("SaveGame::Compress");
+    out.clear();
+    std::array<std::uint32_t, std::size_t{1} << HashBits> recent{};
+    std::size_t literalStart = 0;
+    std::size_t position = 0;
+    while (position + MinMatch <= size) {
+        const std::uint32_t sequence = Read32(in + position);
+        std::uint32_t &slot = recent[Hash(sequence)];
+        const std::size_t candidate = slot; // Stored one past the position, so zero means empty
+        slot = static_cast<std::uint32_t>(position + 1);
+        if (candidate == 0 || position + 1 - candidate > MaxOffset || Read32(in + candidate - 1) != sequence) {
+            ++position;
+            continue;
+        }
+
+        const std::size_t match = candidate - 1;
+        std::size_t length = MinMatch;
+        while (position + length < size && in[match + length] == in[position + length]) {
+            ++length;
+        }
+        PutSequence(out, in + literalStart, position - literalStart, position - match, length);
+        position += length;
+        literalStart = position;
+    }
+    PutSequence(out, in + literalStart, size - literalStart, 0, 0);
+}
+
+bool SaveGame::Decompress(const std::uint8_t *in, std::size_t size, std::uint8_t *out, std::size_t outSize) {
+    PROFILE_ZONE("SaveGame::Decompress");
+    const std::uint8_t *end = in + size;
+    std::size_t written = 0;
+    while (in < end) {
+        const std::uint8_t token = *in++;
+        std::size_t literals = token >> 4;
+        if (literals == 15 && !GetLength(in, end, literals)) {
+            return false;
+        }
+        if (literals > static_cast<std::size_t>(end - in) || literals > outSize - written) {
+            return false;
+        }
+        std::copy_n(in, literals, out + written);
+        in += literals;
+        written += literals;
+        if (in == end) {
+            break; // The last sequence has no match
+        }
+
+        if (end - in < 2) {
+            return false;
+        }
+        const std::size_t offset = in[0] | static_cast<std::size_t>(in[1]) << 8;
+        in += 2;
+        std::size_t length = token & 15u;
+        if (length == 15 && !GetLength(in, end, length)) {
+            return false;
+        }
+        length += MinMatch;
+        if (offset == 0 || offset > written || length > outSize - written) {
+            return false;
+        }
+        // Byte by byte: a match may overlap the bytes it produces
+        for (std::size_t index = 0; index < length; ++index, ++written) {
+            out[written] = out[written - offset];
+        }
+    }
+    return written == outSize;
+}
+
+bool SaveGame::Write(const std::string &path, const std::uint8_t *payload, std::size_t bytes, bool compress,
+                     std::vector<std::uint8_t> &scratch) {
+    PROFILE_ZONE("SaveGame::Write");
+    FileHeader header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.flags = compress ? FlagCompressed : 0;
+    header.payloadBytes = bytes;
+    header.checksum = Checksum(payload, bytes);
+    const std::uint8_t *stored = payload;
+    if (compress) {
+        Compress(payload, bytes, scratch);
+        stored = scratch.data();
+        header.storedBytes = scratch.size();
+    } else {
+        header.storedBytes = bytes;
+    }
+
+    const std::string temporary = path + ".tmp";
+    std::FILE *file = std::fopen(temporary.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    const bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                         std::fwrite(stored, 1, header.storedBytes, file) == header.storedBytes &&
+                         SyncFile(file);
+    if (std::fclose(file) != 0 || !written) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    SyncDirectory(std::filesystem::path(path).parent_path());
+    return true;
+}
+
+bool SaveFile::Load(const std::string &path) {
+    PROFILE_ZONE("SaveFile::Load");
+    view = SaveView{};
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    FileHeader header{};
+    bool loaded = std::fread(&header, sizeof(header), 1, file) == 1 &&
+                  std::memcmp(header.magic, Magic, sizeof(Magic)) == 0 && header.version <= SaveGame::Version &&
+                  header.payloadBytes <= (std::uint64_t{1} << 30) && header.storedBytes <= (std::uint64_t{1} << 30);
+    if (loaded) {
+        storage.assign(Align(static_cast<std::size_t>(header.payloadBytes)) / 8, 0);
+        auto *payload = reinterpret_cast<std::uint8_t *>(storage.data());
+        const auto payloadBytes = static_cast<std::size_t>(header.payloadBytes);
+        const auto storedBytes = static_cast<std::size_t>(header.storedBytes);
+        if ((header.flags & SaveGame::FlagCompressed) != 0) {
+            std::vector<std::uint8_t> stored(storedBytes);
+            loaded = std::fread(stored.data(), 1, storedBytes, file) == storedBytes &&
+                     SaveGame::Decompress(stored.data(), storedBytes, payload, payloadBytes);
+        } else {
+            // Straight into the aligned buffer; nothing is copied again after this
+            loaded = storedBytes == payloadBytes && std::fread(payload, 1, payloadBytes, file) == payloadBytes;
+        }
+        loaded = loaded && SaveGame::Checksum(payload, payloadBytes) == header.checksum &&
+                 view.Open(payload, payloadBytes);
+    }
+    std::fclose(file);
+    version = loaded ? header.version : 0;
+    return loaded;
+}
+
+Autosaver::Autosaver(std::string path, bool compress) : path(std::move(path)), compress(compress) {
+    // Room for a few hundred level changes before a snapshot has to grow the buffers
+    staging.resize(1024);
+    pending.resize(1024);
+    writer = std::thread(&Autosaver::RunWriter, this);
+}
+
+Autosaver::~Autosaver() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    writer.join();
+}
+
+void Autosaver::Snapshot(const SaveState &state) {
+    PROFILE_ZONE("Autosaver::Snapshot");
+    const std::size_t bytes = SaveGame::Serialize(state, staging);
+    {
+        std::lock_guard lock(mutex);
+        // Whatever was still waiting is older than this snapshot; it goes back to the game thread for reuse
+        std::swap(staging, pending);
+        pendingBytes = bytes;
+        hasPending = true;
+    }
+    wake.notify_one();
+}
+
+void Autosaver::Flush() {
+    std::unique_lock lock(mutex);
+    idle.wait(lock, [this] { return !hasPending && !writing; });
+}
+
+void Autosaver::RunWriter() {
+    std::vector<std::uint64_t> payload(pending.size());
+    std::vector<std::uint8_t> scratch;
+    std::unique_lock lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return stopping || hasPending; });
+        if (!hasPending) {
+            return;
+        }
+        std::swap(payload, pending);
+        const std::size_t bytes = pendingBytes;
+        hasPending = false;
+        writing = true;
+
+        lock.unlock();
+        const bool saved = SaveGame::Write(path, reinterpret_cast<const std::uint8_t *>(payload.data()), bytes,
+                                           compress, scratch);
+        (saved ? savesWritten : failures).fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+
+        writing = false;
+        idle.notify_all();
+    }
+}
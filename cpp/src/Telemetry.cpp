@@ -0,0 +1,199 @@
+#include <Telemetry.h>
+
+#include <cmath>
+#include <cstring>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr char Magic[8] = {'O', 'O', 'P', 'T', 'C', 'O', 'L', '1'};
+
+    bool IsFloatColumn(TelemetryColumn column) {
+        return column == TelemetryColumn::PositionX || column == TelemetryColumn::PositionY ||
+               column == TelemetryColumn::VelocityX || column == TelemetryColumn::VelocityY;
+    }
+
+    std::int32_t Quantize(float value) {
+        const float scaled = std::nearbyint(value * static_cast<float>(TelemetryRecorder::Scale));
+        if (!(scaled > -2.0e9f)) {
+            return -2'000'000'000;
+        }
+        return scaled < 2.0e9f ? static_cast<std::int32_t>(scaled) : 2'000'000'000;
+    }
+
+    void PutUint32(std::uint8_t *out, std::uint32_t value) {
+        for (int index = 0; index < 4; ++index) {
+            out[index] = static_cast<std::uint8_t>(value >> (index * 8));
+        }
+    }
+}
+
+TelemetryRecorder::TelemetryRecorder(const std::string &directory) {
+    encoded.resize(8 + static_cast<std::size_t>(ChunkTicks) * 5);
+    for (std::size_t index = 0; index < ColumnCount; ++index) {
+        const auto column = static_cast<TelemetryColumn>(index);
+        columns[index].resize(ChunkTicks);
+        files[index] = std::fopen((directory + "/" + GetFileName(column)).c_str(), "wb");
+        if (files[index] == nullptr) {
+            continue;
+        }
+        std::uint8_t header[16];
+        std::memcpy(header, Magic, 8);
+        PutUint32(header + 8, static_cast<std::uint32_t>(index));
+        PutUint32(header + 12, static_cast<std::uint32_t>(IsFloatColumn(column) ? Scale : 1));
+        std::fwrite(header, 1, sizeof(header), files[index]);
+    }
+}
+
+TelemetryRecorder::~TelemetryRecorder() {
+    Flush();
+    for (std::FILE *file: files) {
+        if (file != nullptr) {
+            std::fclose(file);
+        }
+    }
+}
+
+bool TelemetryRecorder::IsOpen() const {
+    for (const std::FILE *file: files) {
+        if (file == nullptr) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TelemetryRecorder::Record(const TelemetrySample &sample) {
+    const std::uint32_t slot = buffered++;
+    columns[static_cast<std::size_t>(TelemetryColumn::PositionX)][slot] = Quantize(sample.positionX);
+    columns[static_cast<std::size_t>(TelemetryColumn::PositionY)][slot] = Quantize(sample.positionY);
+    columns[static_cast<std::size_t>(TelemetryColumn::VelocityX)][slot] = Quantize(sample.velocityX);
+    columns[static_cast<std::size_t>(TelemetryColumn::VelocityY)][slot] = Quantize(sample.velocityY);
+    columns[static_cast<std::size_t>(TelemetryColumn::CanJump)][slot] = sample.canJump ? 1 : 0;
+    columns[static_cast<std::size_t>(TelemetryColumn::Surface)][slot] = sample.surface;
+    columns[static_cast<std::size_t>(TelemetryColumn::CollisionFlags)][slot] = sample.collisionFlags;
+    ++ticks;
+    if (buffered == ChunkTicks) {
+        Flush();
+    }
+}
+
+void TelemetryRecorder::Flush() {
+    if (buffered == 0) {
+        return;
+    }
+    for (std::size_t index = 0; index < ColumnCount; ++index) {
+        if (files[index] == nullptr) {
+            continue;
+        }
+        // Delta against the previous tick, zigzag so small negative steps stay small, then LEB128
+        std::size_t size = 8;
+        std::int32_t previous = 0;
+        for (std::uint32_t tick = 0; tick < buffered; ++tick) {
+            const std::int32_t value = columns[index][tick];
+            const auto delta = static_cast<std::int32_t>(static_cast<std::uint32_t>(value) -
+                                                         static_cast<std::uint32_t>(previous));
+            std::uint32_t zigzag = (static_cast<std::uint32_t>(delta) << 1) ^ static_cast<std::uint32_t>(delta >> 31);
+            previous = value;
+            while (zigzag >= 0x80u) {
+                encoded[size++] = static_cast<std::uint8_t>(zigzag | 0x80u);
+                zigzag >>= 7;
+            }
+            encoded[size++] = static_cast<std::uint8_t>(zigzag);
+        }
+        PutUint32(encoded.data(), buffered);
+        PutUint32(encoded.data() + 4, static_cast<std::uint32_t>(size - 8));
+        std::fwrite(encoded.data(), 1, size, files[index]);
+    }
+    buffered = 0;
+}
+
+const char *TelemetryRecorder::GetFileName(TelemetryColumn column) {
+    switch (column) {
+        case TelemetryColumn::PositionX:
+            return "position_x.col";
+        case TelemetryColumn::PositionY:
+            return "position_y.col";
+        case TelemetryColumn::VelocityX:
+            return "velocity_x.col";
+        case TelemetryColumn::VelocityY:
+            return "velocity_y.col";
+        case TelemetryColumn::CanJump:
+            return "can_jump.col";
+        case TelemetryColumn::Surface:
+            return "surface.col";
+        case TelemetryColumn::CollisionFlags:
+            return "collision_flags.col";
+        default:
+            return "unknown.col";
+    }
+}
+
+TelemetryColumnReader::TelemetryColumnReader(const std::string &path) {
+    const std::uint8_t *mapped = nullptr;
+    std::size_t mappedSize = 0;
+#ifdef _WIN32
+    std::ifstream file(path, std::ios::binary);
+    fallback.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    mapped = fallback.data();
+    mappedSize = fallback.size();
+#else
+    const int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return;
+    }
+    struct stat status{};
+    if (::fstat(descriptor, &status) == 0 && status.st_size > 0) {
+        void *address = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE,
+                               descriptor, 0);
+        if (address != MAP_FAILED) {
+            mapped = static_cast<const std::uint8_t *>(address);
+            mappedSize = static_cast<std::size_t>(status.st_size);
+            ::madvise(address, mappedSize, MADV_SEQUENTIAL);
+        }
+    }
+    ::close(descriptor);
+#endif
+    if (mapped == nullptr || mappedSize < 16 || std::memcmp(mapped, Magic, 8) != 0) {
+#ifndef _WIN32
+        if (mapped != nullptr) {
+            ::munmap(const_cast<std::uint8_t *>(mapped), mappedSize);
+        }
+#endif
+        return;
+    }
+
+    std::uint32_t columnId = 0;
+    std::uint32_t columnScale = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        columnId |= static_cast<std::uint32_t>(mapped[8 + shift / 8]) << shift;
+        columnScale |= static_cast<std::uint32_t>(mapped[12 + shift / 8]) << shift;
+    }
+    data = mapped;
+    size = mappedSize;
+    column = columnId < static_cast<std::uint32_t>(TelemetryColumn::Count)
+                 ? static_cast<TelemetryColumn>(columnId)
+                 : TelemetryColumn::Count;
+    scale = columnScale == 0 ? 1.0 : static_cast<double>(columnScale);
+}
+
+TelemetryColumnReader::~TelemetryColumnReader() {
+#ifndef _WIN32
+    if (data != nullptr) {
+        ::munmap(const_cast<std::uint8_t *>(data), size);
+    }
+#endif
+}
+
+std::vector<double> TelemetryColumnReader::ReadAll() const {
+    std::vector<double> values;
+    ForEach([&values](std::uint64_t, double value) { values.push_back(value); });
+    return values;
+}
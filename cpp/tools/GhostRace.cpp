@@ -0,0 +1,222 @@
+#include <GhostNet.h>
+#include <Replay.h>
+
+#include "../Core/PlayerSim.h"
+#include "../Core/World.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file GhostRace.cpp
+ * @brief Ghost-race streaming over UDP, runnable entirely on one machine.
+ *
+ * Usage: oop_ghost relay PORT [SECONDS]
+ *        oop_ghost send PORT COUNT [SECONDS] [FIRST_ID]
+ *        oop_ghost watch PORT [SECONDS]
+ *        oop_ghost loopback [GHOSTS] [TICKS] [LOSS_PERCENT]
+ *
+ * `relay`, `send` and `watch` are separate processes talking over 127.0.0.1 at 60 ticks per second. `send`
+ * simulates its ghosts headlessly from synthetic replays. `loopback` runs all three in one process as fast
+ * as possible and reports the bandwidth per ghost and the interpolation error.
+ */
+
+namespace {
+    constexpr auto TickPeriod = std::chrono::microseconds(16'667);
+
+    /**
+     * @brief A simulated remote player driven by a synthetic replay.
+     */
+    struct SimulatedGhost {
+        Replay replay;
+        World world;
+        std::unique_ptr<PlayerSim> sim;
+        std::unique_ptr<GhostSender> sender;
+
+        SimulatedGhost(std::uint32_t seed, std::uint32_t ticks, const UdpAddress &relay, std::uint16_t id)
+            : replay(Replay::Generate(seed, ticks)), world(World::MakeTower(replay.levelId)),
+              sim(std::make_unique<PlayerSim>(world, replay.mode)),
+              sender(std::make_unique<GhostSender>(relay, id)) {
+        }
+
+        GhostState Step(std::uint32_t tick) {
+            sim->Step(replay.inputs[tick % replay.inputs.size()]);
+            const MovementState &state = sim->GetState();
+            return GhostState::Quantize(sim->GetPositionX(), sim->GetPositionY(), state.velocityX, state.velocityY,
+                                        state.canJump, replay.mode);
+        }
+    };
+
+    std::uint32_t Argument(int argc, char **argv, int index, std::uint32_t fallback) {
+        return index < argc ? static_cast<std::uint32_t>(std::strtoul(argv[index], nullptr, 10)) : fallback;
+    }
+
+    int RunRelay(std::uint16_t port, std::uint32_t seconds) {
+        GhostRelay relay(port);
+        if (!relay.IsOpen()) {
+            std::cerr << "Could not listen on port " << port << "\n";
+            return 1;
+        }
+        std::cout << "Relay listening on port " << relay.GetPort() << "\n";
+        auto next = std::chrono::steady_clock::now();
+        std::uint64_t lastBytes = 0;
+        for (std::uint32_t tick = 1; seconds == 0 || tick <= seconds * 60; ++tick) {
+            relay.Poll();
+            relay.Broadcast();
+            if (tick % 60 == 0) {
+                std::cout << "tick " << relay.GetTick() << ": " << relay.GetGhostCount() << " ghosts, "
+                        << relay.GetReceiverCount() << " receivers, " << relay.GetBytesSent() - lastBytes
+                        << " bytes/s out\n";
+                lastBytes = relay.GetBytesSent();
+            }
+            next += TickPeriod;
+            std::this_thread::sleep_until(next);
+        }
+        return 0;
+    }
+
+    int RunSenders(std::uint16_t port, std::uint32_t count, std::uint32_t seconds, std::uint32_t firstId) {
+        std::vector<std::unique_ptr<SimulatedGhost> > ghosts;
+        for (std::uint32_t index = 0; index < count; ++index) {
+            ghosts.push_back(std::make_unique<SimulatedGhost>(firstId + index, 3600, UdpAddress::Loopback(port),
+                                                              static_cast<std::uint16_t>(firstId + index)));
+        }
+        auto next = std::chrono::steady_clock::now();
+        for (std::uint32_t tick = 0; tick < seconds * 60; ++tick) {
+            for (const auto &ghost: ghosts) {
+                ghost->sender->Update(tick, ghost->Step(tick));
+            }
+            next += TickPeriod;
+            std::this_thread::sleep_until(next);
+        }
+        std::uint64_t bytes = 0;
+        for (const auto &ghost: ghosts) {
+            bytes += ghost->sender->GetBytesSent();
+        }
+        std::cout << "Sent " << count << " ghosts for " << seconds * 60 << " ticks: "
+                << static_cast<double>(bytes) / (static_cast<double>(count) * seconds * 60) << " bytes/ghost/tick\n";
+        return 0;
+    }
+
+    int RunWatcher(std::uint16_t port, std::uint32_t seconds) {
+        GhostReceiver receiver(UdpAddress::Loopback(port));
+        auto next = std::chrono::steady_clock::now();
+        std::uint64_t lastBytes = 0;
+        for (std::uint32_t frame = 1; frame <= seconds * 60; ++frame) {
+            receiver.Poll();
+            if (frame % 60 == 0) {
+                const std::vector<std::uint16_t> ids = receiver.GetGhostIds();
+                std::cout << "relay tick " << receiver.GetLatestTick() << ": " << ids.size() << " ghosts, "
+                        << receiver.GetBytesReceived() - lastBytes << " bytes/s in";
+                float x = 0.0f;
+                float y = 0.0f;
+                if (!ids.empty() && receiver.Sample(ids.front(), receiver.GetRenderTick(), x, y)) {
+                    std::cout << ", ghost " << ids.front() << " at (" << x << ", " << y << ")";
+                }
+                std::cout << "\n";
+                lastBytes = receiver.GetBytesReceived();
+            }
+            next += TickPeriod;
+            std::this_thread::sleep_until(next);
+        }
+        return 0;
+    }
+
+    int RunLoopback(std::uint32_t count, std::uint32_t ticks, std::uint32_t lossPercent) {
+        GhostRelay relay(0);
+        if (!relay.IsOpen()) {
+            std::cerr << "Could not open the relay socket\n";
+            return 1;
+        }
+        const UdpAddress address = UdpAddress::Loopback(relay.GetPort());
+        relay.GetSocket().SetLossPercent(lossPercent);
+        GhostReceiver receiver(address);
+        receiver.GetSocket().SetLossPercent(lossPercent);
+
+        std::vector<std::unique_ptr<SimulatedGhost> > ghosts;
+        for (std::uint32_t index = 0; index < count; ++index) {
+            ghosts.push_back(std::make_unique<SimulatedGhost>(index, ticks, address,
+                                                              static_cast<std::uint16_t>(index)));
+            ghosts.back()->sender->GetSocket().SetLossPercent(lossPercent);
+        }
+
+        // True positions by relay tick, to measure what interpolation costs
+        std::vector<std::vector<GhostState> > truth(GhostHistory::Capacity, std::vector<GhostState>(count));
+        double errorSum = 0.0;
+        double errorMax = 0.0;
+        std::uint64_t samples = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint32_t tick = 0; tick < ticks; ++tick) {
+            for (std::uint32_t index = 0; index < count; ++index) {
+                const GhostState state = ghosts[index]->Step(tick);
+                ghosts[index]->sender->Update(tick, state);
+                truth[(relay.GetTick() + 1) % GhostHistory::Capacity][index] = state;
+            }
+            relay.Poll();
+            relay.Broadcast();
+            receiver.Poll();
+
+            const double renderTick = receiver.GetRenderTick();
+            if (tick < 60 || renderTick < 1.0) {
+                continue;
+            }
+            const auto &expected = truth[static_cast<std::uint32_t>(renderTick) % GhostHistory::Capacity];
+            for (std::uint32_t index = 0; index < count; ++index) {
+                float x = 0.0f;
+                float y = 0.0f;
+                if (receiver.Sample(static_cast<std::uint16_t>(index), renderTick, x, y)) {
+                    const double error = std::hypot(x - expected[index].GetPositionX(),
+                                                    y - expected[index].GetPositionY());
+                    errorSum += error;
+                    errorMax = std::max(errorMax, error);
+                    ++samples;
+                }
+            }
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::uint64_t uploadBytes = 0;
+        for (const auto &ghost: ghosts) {
+            uploadBytes += ghost->sender->GetBytesSent();
+        }
+        const double ghostTicks = static_cast<double>(count) * ticks;
+        std::cout << "Loopback: " << count << " ghosts, " << ticks << " ticks, " << lossPercent << "% loss, "
+                << seconds << " s\n"
+                << "  upload    " << static_cast<double>(uploadBytes) / ghostTicks << " bytes/ghost/tick\n"
+                << "  broadcast " << static_cast<double>(relay.GetBytesSent()) /
+                static_cast<double>(std::max<std::uint64_t>(relay.GetGhostTicksSent(), 1))
+                << " bytes/ghost/tick\n"
+                << "  received  " << receiver.GetGhostIds().size() << " ghosts, interpolation error mean "
+                << (samples > 0 ? errorSum / static_cast<double>(samples) : 0.0) << " px, max " << errorMax
+                << " px\n";
+        return receiver.GetGhostIds().size() == count ? 0 : 1;
+    }
+}
+
+int main(int argc, char **argv) {
+    const std::string command = argc > 1 ? argv[1] : "";
+    if (command == "relay" && argc > 2) {
+        return RunRelay(static_cast<std::uint16_t>(Argument(argc, argv, 2, 0)), Argument(argc, argv, 3, 0));
+    }
+    if (command == "send" && argc > 3) {
+        return RunSenders(static_cast<std::uint16_t>(Argument(argc, argv, 2, 0)), Argument(argc, argv, 3, 1),
+                          Argument(argc, argv, 4, 30), Argument(argc, argv, 5, 0));
+    }
+    if (command == "watch" && argc > 2) {
+        return RunWatcher(static_cast<std::uint16_t>(Argument(argc, argv, 2, 0)), Argument(argc, argv, 3, 30));
+    }
+    if (command == "loopback") {
+        return RunLoopback(Argument(argc, argv, 2, 256), Argument(argc, argv, 3, 1800), Argument(argc, argv, 4, 0));
+    }
+    std::cerr << "Usage: oop_ghost relay PORT [SECONDS]\n"
+            "       oop_ghost send PORT COUNT [SECONDS] [FIRST_ID]\n"
+            "       oop_ghost watch PORT [SECONDS]\n"
+            "       oop_ghost loopback [GHOSTS] [TICKS] [LOSS_PERCENT]\n";
+    return 2;
+}
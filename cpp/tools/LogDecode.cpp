@@ -0,0 +1,168 @@
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file LogDecode.cpp
+ * @brief Renders a file written by `BinaryLog` as text, one line per record.
+ *
+ * Usage: oop_logdecode FILE
+ */
+
+namespace {
+    struct DecodedFormat {
+        std::string codes;
+        std::string text;
+        std::size_t payloadSize = 0; // Bytes the arguments of one record take
+    };
+
+    template<typename T>
+    bool Read(std::istream &is, T &value) {
+        return static_cast<bool>(is.read(reinterpret_cast<char *>(&value), sizeof(T)));
+    }
+
+    /**
+     * @brief Gets the number of payload bytes an argument of the given type code takes.
+     */
+    std::size_t GetArgumentWidth(char code) {
+        return code == 'b' || code == 'f' || code == 'i' || code == 'u' ? 4 : 8;
+    }
+
+    /**
+     * @brief Prints one argument and returns the number of payload bytes it used.
+     */
+    std::size_t PrintArgument(std::ostream &os, char code, const unsigned char *data) {
+        switch (code) {
+            case 'b': {
+                std::uint32_t value;
+                std::memcpy(&value, data, 4);
+                os << (value != 0 ? "true" : "false");
+                return 4;
+            }
+            case 'f': {
+                float value;
+                std::memcpy(&value, data, 4);
+                os << value;
+                return 4;
+            }
+            case 'd': {
+                double value;
+                std::memcpy(&value, data, 8);
+                os << value;
+                return 8;
+            }
+            case 'i': {
+                std::int32_t value;
+                std::memcpy(&value, data, 4);
+                os << value;
+                return 4;
+            }
+            case 'u': {
+                std::uint32_t value;
+                std::memcpy(&value, data, 4);
+                os << value;
+                return 4;
+            }
+            case 'q': {
+                std::int64_t value;
+                std::memcpy(&value, data, 8);
+                os << value;
+                return 8;
+            }
+            default: {
+                std::uint64_t value;
+                std::memcpy(&value, data, 8);
+                os << value;
+                return 8;
+            }
+        }
+    }
+
+    /**
+     * @brief Prints one record; the payload must hold at least `format.payloadSize` bytes.
+     */
+    void PrintRecord(std::ostream &os, const DecodedFormat &format, const std::vector<unsigned char> &payload) {
+        std::size_t offset = 0;
+        std::size_t argument = 0;
+        for (std::size_t index = 0; index < format.text.size(); ++index) {
+            const bool placeholder = format.text.compare(index, 2, "{}") == 0;
+            if (placeholder && argument < format.codes.size()) {
+                offset += PrintArgument(os, format.codes[argument++], payload.data() + offset);
+                ++index;
+            } else {
+                os << format.text[index];
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        std::cerr << "Usage: oop_logdecode FILE\n";
+        return 2;
+    }
+    std::ifstream file(argv[1], std::ios::binary);
+    char magic[8];
+    if (!file.read(magic, 8) || std::memcmp(magic, "OOPBLOG1", 8) != 0) {
+        std::cerr << argv[1] << " is not a binary log\n";
+        return 1;
+    }
+
+    std::vector<DecodedFormat> formats;
+    std::vector<unsigned char> payload;
+    char tag;
+    while (file.get(tag)) {
+        if (tag == 'F') {
+            std::uint16_t id;
+            std::uint8_t argumentCount;
+            std::uint16_t textLength;
+            if (!Read(file, id) || !Read(file, argumentCount) || !Read(file, textLength)) {
+                break;
+            }
+            DecodedFormat format{std::string(argumentCount, '\0'), std::string(textLength, '\0')};
+            if (!file.read(format.codes.data(), argumentCount) || !file.read(format.text.data(), textLength)) {
+                break;
+            }
+            for (const char code: format.codes) {
+                format.payloadSize += GetArgumentWidth(code);
+            }
+            if (formats.size() <= id) {
+                formats.resize(id + 1u);
+            }
+            formats[id] = format;
+        } else if (tag == 'R') {
+            std::uint16_t id;
+            std::uint32_t thread;
+            std::uint64_t timestamp;
+            std::uint16_t size;
+            if (!Read(file, id) || !Read(file, thread) || !Read(file, timestamp) || !Read(file, size)) {
+                break;
+            }
+            payload.resize(size);
+            if (!file.read(reinterpret_cast<char *>(payload.data()), size)) {
+                break;
+            }
+            if (id < formats.size() && formats[id].payloadSize > payload.size()) {
+                std::cerr << "Record of format " << id << " is shorter than its arguments in " << argv[1] << "\n";
+                return 1;
+            }
+            std::cout << "[" << std::fixed << std::setprecision(6) << std::setw(14)
+                    << static_cast<double>(timestamp) / 1'000'000.0 << " ms] [t" << thread << "] "
+                    << std::defaultfloat;
+            if (id < formats.size()) {
+                PrintRecord(std::cout, formats[id], payload);
+            } else {
+                std::cout << "<unknown format " << id << ">";
+            }
+            std::cout << "\n";
+        } else {
+            std::cerr << "Corrupt entry in " << argv[1] << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
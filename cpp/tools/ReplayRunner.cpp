@@ -0,0 +1,96 @@
+#include <Replay.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file ReplayRunner.cpp
+ * @brief Generates and re-simulates replay corpora without Godot.
+ *
+ * Usage: oop_replay generate DIRECTORY COUNT [TICKS]
+ *        oop_replay run PATH...
+ *
+ * `run` accepts replay files and directories of `.oopr` files, verifies every replay against its claimed
+ * result and exits with 1 if any of them disagrees. It is the training workload of `scripts/pgo.sh`.
+ */
+
+namespace {
+    int Generate(const std::filesystem::path &directory, std::uint32_t count, std::uint32_t ticks) {
+        std::filesystem::create_directories(directory);
+        for (std::uint32_t seed = 0; seed < count; ++seed) {
+            const std::string name = "replay_" + std::to_string(seed) + ".oopr";
+            if (!Replay::Generate(seed, ticks).Save((directory / name).string())) {
+                std::cerr << "Could not write " << (directory / name).string() << "\n";
+                return 1;
+            }
+        }
+        std::cout << "Wrote " << count << " replays of " << ticks << " ticks to " << directory.string() << "\n";
+        return 0;
+    }
+
+    void CollectReplays(const std::filesystem::path &path, std::vector<std::filesystem::path> &files) {
+        if (!std::filesystem::is_directory(path)) {
+            files.push_back(path);
+            return;
+        }
+        std::vector<std::filesystem::path> found;
+        for (const auto &entry: std::filesystem::directory_iterator(path)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".oopr") {
+                found.push_back(entry.path());
+            }
+        }
+        std::sort(found.begin(), found.end());
+        files.insert(files.end(), found.begin(), found.end());
+    }
+
+    int Run(const std::vector<std::filesystem::path> &paths) {
+        std::vector<std::filesystem::path> files;
+        for (const auto &path: paths) {
+            CollectReplays(path, files);
+        }
+
+        std::uint64_t ticks = 0;
+        std::size_t failures = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto &file: files) {
+            Replay replay;
+            if (!replay.Load(file.string())) {
+                std::cerr << file.string() << ": not a replay\n";
+                ++failures;
+                continue;
+            }
+            const ReplayResult result = replay.Run();
+            ticks += result.ticks;
+            if (result != replay.claimed) {
+                std::cerr << file.string() << ": claimed " << replay.claimed << ", got " << result << "\n";
+                ++failures;
+            }
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "Replayed " << files.size() << " files, " << ticks << " ticks in " << seconds << " s ("
+                << (seconds > 0.0 ? static_cast<double>(ticks) / seconds : 0.0) << " ticks/s), "
+                << failures << " failed\n";
+        return failures == 0 ? 0 : 1;
+    }
+}
+
+int main(int argc, char **argv) {
+    const std::string command = argc > 1 ? argv[1] : "";
+    if (command == "generate" && (argc == 4 || argc == 5)) {
+        const auto count = static_cast<std::uint32_t>(std::strtoul(argv[3], nullptr, 10));
+        const auto ticks = argc == 5 ? static_cast<std::uint32_t>(std::strtoul(argv[4], nullptr, 10)) : 3600u;
+        return Generate(argv[2], count, ticks);
+    }
+    if (command == "run" && argc > 2) {
+        return Run(std::vector<std::filesystem::path>(argv + 2, argv + argc));
+    }
+    std::cerr << "Usage: oop_replay generate DIRECTORY COUNT [TICKS]\n"
+            "       oop_replay run PATH...\n";
+    return 2;
+}
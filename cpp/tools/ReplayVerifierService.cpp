@@ -0,0 +1,135 @@
+#include <ReplayVerifier.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+/**
+ * @file ReplayVerifierService.cpp
+ * @brief Leaderboard replay verification running on a local spool directory.
+ *
+ * Usage: oop_verifier drain SPOOL [THREADS] [BATCH]
+ *        oop_verifier watch SPOOL [THREADS] [BATCH]
+ *
+ * Submissions are `.oopr` files in `SPOOL/incoming`; writers should create them under another name and
+ * rename them into place, so a half-written file is never picked up. Every batch is re-simulated on all
+ * cores and each file is moved to `SPOOL/accepted` or `SPOOL/rejected`, with one line per file appended to
+ * `SPOOL/verdicts.log`. `drain` exits once `incoming` is empty; `watch` keeps polling for new submissions.
+ */
+
+namespace {
+    constexpr auto IdlePoll = std::chrono::milliseconds(250);
+
+    std::uint32_t Argument(int argc, char **argv, int index, std::uint32_t fallback) {
+        return index < argc ? static_cast<std::uint32_t>(std::strtoul(argv[index], nullptr, 10)) : fallback;
+    }
+
+    /**
+     * @brief Lists up to `limit` pending submissions, oldest name first.
+     */
+    std::vector<std::string> CollectBatch(const std::filesystem::path &incoming, std::size_t limit) {
+        std::vector<std::string> paths;
+        std::error_code error;
+        for (const auto &entry: std::filesystem::directory_iterator(incoming, error)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".oopr") {
+                paths.push_back(entry.path().string());
+            }
+        }
+        std::sort(paths.begin(), paths.end());
+        if (paths.size() > limit) {
+            paths.resize(limit);
+        }
+        return paths;
+    }
+
+    /**
+     * @brief Moves every file of a batch out of the queue and logs its verdict.
+     */
+    void FileVerdicts(const std::filesystem::path &spool, const std::vector<std::string> &paths,
+                      const std::vector<ReplayCheck> &checks, std::size_t &accepted) {
+        std::ofstream log(spool / "verdicts.log", std::ios::app);
+        for (std::size_t index = 0; index < paths.size(); ++index) {
+            const std::filesystem::path path(paths[index]);
+            const ReplayCheck &check = checks[index];
+            const bool isAccepted = check.verdict == ReplayVerdict::Accepted;
+            accepted += isAccepted ? 1 : 0;
+
+            std::error_code error;
+            std::filesystem::rename(path, spool / (isAccepted ? "accepted" : "rejected") / path.filename(), error);
+            if (error) {
+                std::cerr << path.string() << ": could not be moved: " << error.message() << "\n";
+            }
+            log << path.filename().string() << " " << GetVerdictName(check.verdict);
+            if (check.verdict != ReplayVerdict::Malformed) {
+                log << " claimed " << check.claimed << " actual " << check.actual;
+            }
+            log << "\n";
+        }
+    }
+
+    int Serve(const std::filesystem::path &spool, bool watch, unsigned threads, std::size_t batchSize) {
+        std::error_code error;
+        for (const char *directory: {"incoming", "accepted", "rejected"}) {
+            std::filesystem::create_directories(spool / directory, error);
+            if (error) {
+                std::cerr << "Could not create " << (spool / directory).string() << ": " << error.message() << "\n";
+                return 1;
+            }
+        }
+
+        ReplayVerifier verifier(threads);
+        std::cout << "Verifying " << (spool / "incoming").string() << " on " << verifier.GetThreadCount()
+                << " threads, batches of " << batchSize << "\n";
+
+        std::size_t total = 0;
+        std::size_t totalAccepted = 0;
+        const auto start = std::chrono::steady_clock::now();
+        while (true) {
+            const std::vector<std::string> paths = CollectBatch(spool / "incoming", batchSize);
+            if (paths.empty()) {
+                if (!watch) {
+                    break;
+                }
+                std::this_thread::sleep_for(IdlePoll);
+                continue;
+            }
+
+            const auto batchStart = std::chrono::steady_clock::now();
+            const std::uint64_t ticksBefore = verifier.GetTicksSimulated();
+            const std::vector<ReplayCheck> checks = verifier.VerifyBatch(paths);
+            std::size_t accepted = 0;
+            FileVerdicts(spool, paths, checks, accepted);
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - batchStart).count();
+
+            total += paths.size();
+            totalAccepted += accepted;
+            std::cout << "Batch of " << paths.size() << ": " << accepted << " accepted, " << paths.size() - accepted
+                    << " rejected in " << seconds << " s (" << static_cast<double>(paths.size()) * 60.0 / seconds
+                    << " replays/min, " << static_cast<double>(verifier.GetTicksSimulated() - ticksBefore) / seconds
+                    << " ticks/s)\n";
+        }
+
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Verified " << total << " replays, " << totalAccepted << " accepted, " << total - totalAccepted
+                << " rejected in " << seconds << " s\n";
+        return 0;
+    }
+}
+
+int main(int argc, char **argv) {
+    const std::string command = argc > 1 ? argv[1] : "";
+    if ((command == "drain" || command == "watch") && argc > 2 && argc < 6) {
+        return Serve(argv[2], command == "watch", Argument(argc, argv, 3, 0),
+                     std::max<std::uint32_t>(1, Argument(argc, argv, 4, 4096)));
+    }
+    std::cerr << "Usage: oop_verifier drain SPOOL [THREADS] [BATCH]\n"
+            "       oop_verifier watch SPOOL [THREADS] [BATCH]\n";
+    return 2;
+}
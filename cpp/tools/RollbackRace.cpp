@@ -0,0 +1,249 @@
+#include <GhostNet.h>
+#include <Replay.h>
+#include <Rollback.h>
+
+#include "../Core/PlayerSim.h"
+#include "../Core/World.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/**
+ * @file RollbackRace.cpp
+ * @brief Loopback harness for rollback netcode with artificial latency, jitter and loss.
+ *
+ * Usage: oop_rollback [RTT_MS] [JITTER_MS] [LOSS_PERCENT] [TICKS] [MAX_ROLLBACK]
+ *
+ * Two peers race each other over 127.0.0.1, each driving its racer from a synthetic replay. Every datagram
+ * is held back by half the round trip plus a random jitter on a virtual 60 Hz clock, so the run is as fast
+ * as the simulation allows. The report shows how deep the rollbacks went, what a resimulated tick costs and
+ * therefore how many resimulated ticks fit into a frame, and whether both peers converged on the state a
+ * straight simulation of the real inputs reaches.
+ */
+
+namespace {
+    constexpr double FrameMilliseconds = 1000.0 / 60.0;
+    constexpr std::uint8_t InputMessage = 'R'; // u32 ack, u32 first tick, u8 count, count x (held, pressed)
+    constexpr std::uint32_t MaxInputsPerMessage = 64;
+
+    /**
+     * @brief A datagram waiting in the artificial delay line.
+     */
+    struct Delayed {
+        double due;
+        std::vector<std::uint8_t> bytes;
+    };
+
+    /**
+     * @brief One side of the race with its socket, delay line and statistics.
+     */
+    struct Peer {
+        std::unique_ptr<RollbackSession> session;
+        const Replay *replay = nullptr;
+        UdpSocket socket;
+        UdpAddress remote;
+        std::vector<Delayed> delayLine;
+        std::uint32_t remoteAck = 0; // Local ticks the other peer has confirmed
+        std::uint32_t stalls = 0;
+        std::vector<std::uint32_t> depthFrames; // Frames by resimulated ticks
+        double stepNanoseconds = 0.0;
+        std::uint64_t steppedTicks = 0;
+    };
+
+    std::uint32_t Argument(int argc, char **argv, int index, std::uint32_t fallback) {
+        return index < argc ? static_cast<std::uint32_t>(std::strtoul(argv[index], nullptr, 10)) : fallback;
+    }
+
+    void Put32(std::vector<std::uint8_t> &out, std::uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            out.push_back(static_cast<std::uint8_t>(value >> shift));
+        }
+    }
+
+    std::uint32_t Get32(const std::uint8_t *in) {
+        return static_cast<std::uint32_t>(in[0]) | static_cast<std::uint32_t>(in[1]) << 8 |
+               static_cast<std::uint32_t>(in[2]) << 16 | static_cast<std::uint32_t>(in[3]) << 24;
+    }
+
+    /**
+     * @brief Queues every local input the other peer has not confirmed, plus our own acknowledgement.
+     */
+    void SendInputs(Peer &peer, double now, std::uint32_t oneWay, std::uint32_t jitter, std::uint32_t &seed) {
+        const RollbackSession &session = *peer.session;
+        const std::uint32_t first = std::max(peer.remoteAck, session.GetTick() -
+                                                             std::min(session.GetTick(), MaxInputsPerMessage));
+        const std::uint32_t count = session.GetTick() - first;
+
+        Delayed message{now + oneWay, {}};
+        message.bytes.push_back(InputMessage);
+        Put32(message.bytes, session.GetRemoteTicks());
+        Put32(message.bytes, first);
+        message.bytes.push_back(static_cast<std::uint8_t>(count));
+        for (std::uint32_t inputTick = first; inputTick < first + count; ++inputTick) {
+            const InputSnapshot input = session.GetLocalInput(inputTick);
+            message.bytes.push_back(input.held);
+            message.bytes.push_back(input.pressed);
+        }
+        if (jitter > 0) {
+            seed = seed * 1664525u + 1013904223u;
+            message.due += static_cast<double>((seed >> 8) % (jitter + 1));
+        }
+        peer.delayLine.push_back(std::move(message));
+    }
+
+    /**
+     * @brief Sends every datagram whose delay has passed, then reads what the other peer sent.
+     */
+    void Pump(Peer &peer, double now) {
+        for (auto it = peer.delayLine.begin(); it != peer.delayLine.end();) {
+            if (it->due <= now) {
+                peer.socket.SendTo(peer.remote, it->bytes.data(), it->bytes.size());
+                it = peer.delayLine.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        std::array<std::uint8_t, UdpSocket::MaxDatagram> buffer{};
+        UdpAddress from;
+        long size;
+        while ((size = peer.socket.Receive(buffer.data(), buffer.size(), from)) >= 0) {
+            if (size < 10 || buffer[0] != InputMessage || 10 + buffer[9] * 2 > size) {
+                continue;
+            }
+            peer.remoteAck = std::max(peer.remoteAck, Get32(buffer.data() + 1));
+            const std::uint32_t first = Get32(buffer.data() + 5);
+            for (std::uint32_t index = 0; index < buffer[9]; ++index) {
+                peer.session->AddRemoteInput(first + index, InputSnapshot{buffer[10 + index * 2],
+                                                                          buffer[11 + index * 2]});
+            }
+        }
+    }
+
+    /**
+     * @brief Simulates one frame: advances if the rollback window allows, otherwise only applies corrections.
+     */
+    void RunFrame(Peer &peer, std::uint32_t ticks) {
+        RollbackSession &session = *peer.session;
+        const bool advances = session.GetTick() < ticks && session.CanAdvance();
+        const std::uint64_t before = session.GetResimulatedTicks();
+
+        const auto start = std::chrono::steady_clock::now();
+        const std::uint32_t resimulated = advances ? session.Advance(peer.replay->inputs[session.GetTick()])
+                                                   : session.Resimulate();
+        peer.stepNanoseconds += std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - start).count();
+        peer.steppedTicks += session.GetResimulatedTicks() - before + (advances ? 1 : 0);
+
+        if (!advances && session.GetTick() < ticks) {
+            ++peer.stalls;
+        }
+        if (advances) {
+            peer.depthFrames[std::min<std::size_t>(resimulated, peer.depthFrames.size() - 1)]++;
+        }
+    }
+
+    std::uint64_t StraightHash(const World &world, int mode, const Replay &replay, std::uint32_t ticks) {
+        PlayerSim sim(world, mode);
+        for (std::uint32_t tick = 0; tick < ticks; ++tick) {
+            sim.Step(replay.inputs[tick]);
+        }
+        return sim.GetStateHash();
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && std::atoi(argv[1]) == 0 && argv[1][0] != '0') {
+        std::cerr << "Usage: oop_rollback [RTT_MS] [JITTER_MS] [LOSS_PERCENT] [TICKS] [MAX_ROLLBACK]\n";
+        return 2;
+    }
+    const std::uint32_t rtt = Argument(argc, argv, 1, 100);
+    const std::uint32_t jitter = Argument(argc, argv, 2, 20);
+    const std::uint32_t lossPercent = Argument(argc, argv, 3, 0);
+    const std::uint32_t ticks = Argument(argc, argv, 4, 3600);
+    const std::uint32_t maxRollback = Argument(argc, argv, 5, 8);
+
+    const std::array<Replay, RollbackSession::Players> replays{Replay::Generate(1, ticks), Replay::Generate(2, ticks)};
+    const World world = World::MakeTower(replays[0].levelId);
+    const int mode = replays[0].mode;
+
+    std::array<Peer, RollbackSession::Players> peers;
+    for (std::uint32_t player = 0; player < RollbackSession::Players; ++player) {
+        Peer &peer = peers[player];
+        peer.session = std::make_unique<RollbackSession>(world, mode, player, maxRollback);
+        peer.replay = &replays[player];
+        peer.depthFrames.assign(peer.session->GetMaxRollback() + 1, 0);
+        if (!peer.socket.Open(0)) {
+            std::cerr << "Could not open a loopback socket\n";
+            return 1;
+        }
+        peer.socket.SetLossPercent(lossPercent);
+    }
+    peers[0].remote = UdpAddress::Loopback(peers[1].socket.GetPort());
+    peers[1].remote = UdpAddress::Loopback(peers[0].socket.GetPort());
+
+    // Run on a virtual clock until both peers have simulated and confirmed every tick
+    std::uint32_t seed = 0x2545F491u;
+    std::uint32_t frames = 0;
+    const std::uint32_t frameLimit = ticks * 8 + 600;
+    const auto finished = [&peers, ticks](const Peer &peer) {
+        return peer.session->GetTick() == ticks && peer.session->GetRemoteTicks() == ticks;
+    };
+    for (; frames < frameLimit && !(finished(peers[0]) && finished(peers[1])); ++frames) {
+        const double now = frames * FrameMilliseconds;
+        for (Peer &peer: peers) {
+            Pump(peer, now);
+            RunFrame(peer, ticks);
+            SendInputs(peer, now, rtt / 2, jitter, seed);
+        }
+    }
+    for (Peer &peer: peers) {
+        peer.session->Resimulate();
+    }
+
+    std::cout << "Rollback: RTT " << rtt << " ms, jitter " << jitter << " ms, " << lossPercent << "% loss, "
+            << ticks << " ticks, window " << peers[0].session->GetMaxRollback() << " ticks, " << frames
+            << " frames\n";
+
+    bool converged = true;
+    std::array<std::uint64_t, RollbackSession::Players> truth{};
+    for (std::uint32_t player = 0; player < RollbackSession::Players; ++player) {
+        truth[player] = StraightHash(world, mode, replays[player], ticks);
+    }
+    for (std::uint32_t index = 0; index < RollbackSession::Players; ++index) {
+        const Peer &peer = peers[index];
+        const RollbackSession &session = *peer.session;
+        const double frameCount = static_cast<double>(std::max<std::uint32_t>(session.GetTick(), 1));
+        std::cout << "  peer " << index << ": " << session.GetMispredictions() << " mispredictions, "
+                << session.GetRollbacks() << " rollbacks, "
+                << static_cast<double>(session.GetResimulatedTicks()) / frameCount << " resimulated ticks/frame, "
+                << peer.stalls << " stalled frames\n    rollback depth:";
+        for (std::size_t depth = 0; depth < peer.depthFrames.size(); ++depth) {
+            std::cout << " " << depth << "=" << peer.depthFrames[depth];
+        }
+        std::cout << "\n";
+        for (std::uint32_t player = 0; player < RollbackSession::Players; ++player) {
+            converged = converged && session.GetTick() == ticks &&
+                        session.GetPlayer(player).GetStateHash() == truth[player];
+        }
+    }
+
+    // One tick steps both racers; that is the unit a rollback pays for
+    double nanoseconds = 0.0;
+    std::uint64_t stepped = 0;
+    for (const Peer &peer: peers) {
+        nanoseconds += peer.stepNanoseconds;
+        stepped += peer.steppedTicks;
+    }
+    const double perTick = nanoseconds / static_cast<double>(std::max<std::uint64_t>(stepped, 1));
+    std::cout << "  " << perTick << " ns per simulated tick; affordable resimulated ticks per frame: "
+            << static_cast<std::uint64_t>(1.0e6 / perTick) << " in a 1 ms budget, "
+            << static_cast<std::uint64_t>(FrameMilliseconds * 1.0e6 / perTick) << " in a whole frame\n"
+            << "  " << (converged ? "converged" : "DESYNC") << " with a straight simulation of the real inputs\n";
+    return converged ? 0 : 1;
+}
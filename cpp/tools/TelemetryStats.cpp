@@ -0,0 +1,41 @@
+#include <Telemetry.h>
+
+#include <iostream>
+#include <limits>
+#include <string>
+
+/**
+ * @file TelemetryStats.cpp
+ * @brief Summarizes one column of a telemetry directory written by `TelemetryRecorder`.
+ *
+ * Usage: oop_telemetry DIRECTORY COLUMN_FILE (for example `oop_telemetry run1 velocity_x.col`)
+ */
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " DIRECTORY COLUMN_FILE\n";
+        return 2;
+    }
+
+    const TelemetryColumnReader reader(std::string(argv[1]) + "/" + argv[2]);
+    if (!reader.IsOpen()) {
+        std::cerr << argv[0] << ": cannot read telemetry column " << argv[2] << "\n";
+        return 1;
+    }
+
+    double minimum = std::numeric_limits<double>::infinity();
+    double maximum = -std::numeric_limits<double>::infinity();
+    double sum = 0.0;
+    const std::uint64_t ticks = reader.ForEach([&](std::uint64_t, double value) {
+        minimum = value < minimum ? value : minimum;
+        maximum = value > maximum ? value : maximum;
+        sum += value;
+    });
+
+    std::cout << argv[2] << ": ticks=" << ticks;
+    if (ticks > 0) {
+        std::cout << " min=" << minimum << " max=" << maximum << " mean=" << sum / static_cast<double>(ticks);
+    }
+    std::cout << "\n";
+    return 0;
+}
@@ -0,0 +1,109 @@
+#!/usr/bin/bash
+
+# Two-stage profile-guided build of the Godot-free targets, trained on the replay corpus.
+#
+#   1. Release + LTO build, benchmarked as the reference
+#   2. instrumented build, trained by replaying the corpus headlessly with oop_replay
+#   3. optimized rebuild from the profile, benchmarked against the reference
+#
+# example: scripts/pgo.sh -c clang++ -r replays
+
+# default values
+BUILD_DIR="build-pgo"
+CXX_COMPILER="${CXX:-g++}"
+CORPUS_DIR="replays"
+REPLAY_COUNT=64
+NPROC=6
+BENCH_OPTS=(--runs 3 --samples 30)
+
+while getopts ":b:c:j:n:o:r:" opt; do
+  case "${opt}" in
+    b) BUILD_DIR="${OPTARG}"
+    ;;
+    c) CXX_COMPILER="${OPTARG}"
+    ;;
+    j) NPROC="${OPTARG}"
+    ;;
+    n) REPLAY_COUNT="${OPTARG}"
+    ;;
+    o) IFS=" " read -r -a BENCH_OPTS <<< "${OPTARG}"
+    ;;
+    r) CORPUS_DIR="${OPTARG}"
+    ;;
+    *) printf "Unknown option %s; available options: \n\
+        -b (build dir)\n\
+        -c (C++ compiler, g++ or clang++)\n\
+        -j (number of jobs for parallel build)\n\
+        -n (replays to generate when the corpus is missing)\n\
+        -o (oop_bench options)\n\
+        -r (replay corpus dir)\n" "${opt}"
+      exit 1
+    ;;
+  esac
+done
+
+set -e
+
+PGO_DIR="$(realpath -m "${BUILD_DIR}/pgo")"
+TARGETS=(oop_bench oop_replay)
+
+stage() {
+    # stage OFF|GENERATE|USE
+    cmake -S . -B "${BUILD_DIR}" \
+          -DCMAKE_BUILD_TYPE=Release \
+          -DCMAKE_CXX_COMPILER="${CXX_COMPILER}" \
+          -DOOP_LTO=ON \
+          -DOOP_PGO="$1" \
+          -DOOP_PGO_DIR="${PGO_DIR}" > /dev/null
+    cmake --build "${BUILD_DIR}" --config Release -j "${NPROC}" --target "${TARGETS[@]}"
+}
+
+merge_profiles() {
+    if ! "${CXX_COMPILER}" --version | grep -qi clang; then
+        return
+    fi
+    PROFDATA="${LLVM_PROFDATA:-}"
+    if [ -z "${PROFDATA}" ]; then
+        VERSION="$("${CXX_COMPILER}" -dumpversion | cut -d. -f1)"
+        PROFDATA="$(command -v "llvm-profdata-${VERSION}" || command -v llvm-profdata)"
+    fi
+    "${PROFDATA}" merge -o "${PGO_DIR}/oop.profdata" "${PGO_DIR}"/*.profraw
+}
+
+echo "== Reference Release + LTO build"
+stage OFF
+cp "${BUILD_DIR}/oop_bench" "${BUILD_DIR}/oop_bench-release"
+
+echo "== Instrumented build"
+rm -rf "${PGO_DIR}"
+mkdir -p "${PGO_DIR}"
+stage GENERATE
+if [ -z "$(find "${CORPUS_DIR}" -name '*.oopr' 2> /dev/null | head -n 1)" ]; then
+    echo "No replays in ${CORPUS_DIR}; generating a synthetic corpus"
+    "${BUILD_DIR}/oop_replay" generate "${CORPUS_DIR}" "${REPLAY_COUNT}"
+fi
+"${BUILD_DIR}/oop_replay" run "${CORPUS_DIR}"
+merge_profiles
+
+echo "== Profile-guided build"
+stage USE
+"${BUILD_DIR}/oop_replay" run "${CORPUS_DIR}"
+
+# Benchmark both binaries back to back so machine load affects them alike
+echo "== Benchmarks"
+"${BUILD_DIR}/oop_bench-release" "${BENCH_OPTS[@]}" --save-baseline "${BUILD_DIR}/bench-release.json" > /dev/null
+"${BUILD_DIR}/oop_bench" "${BENCH_OPTS[@]}" --json "${BUILD_DIR}/bench-pgo.json" \
+    --baseline "${BUILD_DIR}/bench-release.json" || true
+
+# Geometric mean of the per-benchmark speedups
+awk -F'"' '
+    /"name"/ {
+        name = $4
+        match($0, /"median_ns": [0-9.]+/)
+        value = substr($0, RSTART + 13, RLENGTH - 13)
+        if (FILENAME == ARGV[1]) { reference[name] = value } else if (name in reference && value > 0) {
+            sum += log(reference[name] / value); count++
+        }
+    }
+    END { if (count > 0) printf "PGO speedup over Release + LTO: %.3fx (geometric mean of %d benchmarks)\n", exp(sum / count), count }
+' "${BUILD_DIR}/bench-release.json" "${BUILD_DIR}/bench-pgo.json"